@@ -0,0 +1,110 @@
+/*////////////////////////////////////////////////////////////////////////////
+BiotSavartBenchmark_demo.cpp
+
+Timing of BiotSavart::induced_vel against a loop over BiotSavart::unity_vel.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <HBTK/Constants.h>
+#include <HBTK/PotentialFlowDistributions.h>
+
+
+template<typename TyFunc>
+double best_time(TyFunc func, int repeats = 3)
+{
+	double best = 1e300;
+	for (int r = 0; r < repeats; r++) {
+		auto start = std::chrono::steady_clock::now();
+		func();
+		auto end = std::chrono::steady_clock::now();
+		double t = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+		best = t < best ? t : best;
+	}
+	return best;
+}
+
+// A helical wake of n filaments.
+void make_wake(int n, HBTK::PointCloud3D & starts, HBTK::PointCloud3D & ends, 
+	std::vector<double> & strengths)
+{
+	starts.resize(0);
+	ends.resize(0);
+	strengths.clear();
+	for (int i = 0; i < n; i++) {
+		double t0 = 0.05 * i, t1 = 0.05 * (i + 1);
+		starts.push_back(HBTK::CartesianPoint3D({ cos(t0), sin(t0), 0.001 * i }));
+		ends.push_back(HBTK::CartesianPoint3D({ cos(t1), sin(t1), 0.001 * (i + 1) }));
+		strengths.push_back(1. / (1 + 0.001 * i));
+	}
+}
+
+int main()
+{
+	std::cout << "Biot-Savart benchmark\n";
+	const int n_points = 10000;
+	const int n_threads = std::max(1, (int)std::thread::hardware_concurrency());
+	HBTK::PointCloud3D points;
+	for (int i = 0; i < n_points; i++) {
+		points.push_back(HBTK::CartesianPoint3D({ 0.8 * sin(0.1 * i), 0.8 * cos(0.37 * i), 0.0005 * i }));
+	}
+
+	for (int n_filaments : { 1000, 10000, 100000 }) {
+		HBTK::PointCloud3D starts, ends;
+		std::vector<double> strengths;
+		make_wake(n_filaments, starts, ends, strengths);
+		double interactions = (double)n_points * n_filaments;
+		std::cout << n_filaments << " filaments, " << n_points << " points:\n";
+
+		if (n_filaments <= 10000) {
+			std::vector<HBTK::CartesianFiniteLine3D> filaments;
+			for (int j = 0; j < n_filaments; j++) { filaments.emplace_back(starts[j], ends[j]); }
+			std::vector<HBTK::CartesianPoint3D> point_vector = points.as_points();
+			double t = best_time([&]() {
+				for (auto & point : point_vector) {
+					HBTK::CartesianVector3D vel({ 0, 0, 0 });
+					for (int j = 0; j < n_filaments; j++) {
+						vel += HBTK::BiotSavart::unity_vel(point, filaments[j]) * strengths[j];
+					}
+					point = point + vel * 0;	// Keep the result live.
+				}
+			}, 1);
+			std::cout << "\tunity_vel loop:\t\t" << t << "s\t(" 
+				<< interactions / t / 1e6 << " M interactions/s)\n";
+		}
+		for (int threads : { 1, n_threads }) {
+			HBTK::VectorField3D vel;
+			double t = best_time([&]() {
+				vel = HBTK::BiotSavart::induced_vel(points, starts, ends, strengths, 0.01, threads);
+			}, n_filaments < 100000 ? 3 : 1);
+			std::cout << "\tinduced_vel, " << threads << " thread(s):\t" << t << "s\t("
+				<< interactions / t / 1e6 << " M interactions/s)\n";
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,171 @@
+/*////////////////////////////////////////////////////////////////////////////
+CartesianBenchmark_demo.cpp
+
+Timing of a Biot-Savart loop written with the Cartesian types.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <HBTK/CartesianFiniteLine.h>
+#include <HBTK/CartesianPoint.h>
+#include <HBTK/CartesianPointCloud.h>
+#include <HBTK/CartesianVector.h>
+#include <HBTK/Constants.h>
+
+
+template<typename TyFunc>
+double best_time(TyFunc func, int repeats = 5)
+{
+	double best = 1e300;
+	for (int r = 0; r < repeats; r++) {
+		auto start = std::chrono::steady_clock::now();
+		func();
+		auto end = std::chrono::steady_clock::now();
+		double t = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+		best = t < best ? t : best;
+	}
+	return best;
+}
+
+// Velocity induced at point by a straight vortex filament of unit strength.
+HBTK::CartesianVector3D filament_velocity(const HBTK::CartesianFiniteLine3D & filament,
+	const HBTK::CartesianPoint3D & point)
+{
+	HBTK::CartesianVector3D r1 = point - filament.start();
+	HBTK::CartesianVector3D r2 = point - filament.end();
+	HBTK::CartesianVector3D r1xr2 = r1.cross(r2);
+	double denominator = r1xr2.dot(r1xr2);
+	if (denominator < 1e-12) { return HBTK::CartesianVector3D({ 0, 0, 0 }); }
+	double coeff = filament.vector().dot(r1 / r1.magnitude() - r2 / r2.magnitude());
+	return r1xr2 * (coeff / (4 * HBTK::Constants::pi() * denominator));
+}
+
+std::vector<HBTK::CartesianVector3D> velocities_with_classes(
+	const std::vector<HBTK::CartesianFiniteLine3D> & filaments,
+	const std::vector<HBTK::CartesianPoint3D> & points)
+{
+	std::vector<HBTK::CartesianVector3D> result(points.size(), HBTK::CartesianVector3D({ 0, 0, 0 }));
+	for (size_t i = 0; i < points.size(); i++) {
+		for (const auto & filament : filaments) {
+			result[i] += filament_velocity(filament, points[i]);
+		}
+	}
+	return result;
+}
+
+// The same loop written by hand on arrays of doubles. 
+std::vector<double> velocities_with_doubles(const std::vector<double> & filaments,
+	const std::vector<double> & points)
+{
+	const int n_fil = (int)filaments.size() / 6, n_pnt = (int)points.size() / 3;
+	std::vector<double> result(points.size(), 0.);
+	for (int i = 0; i < n_pnt; i++) {
+		const double * p = &points[3 * i];
+		for (int j = 0; j < n_fil; j++) {
+			const double * a = &filaments[6 * j], * b = &filaments[6 * j + 3];
+			double r1[3] = { p[0] - a[0], p[1] - a[1], p[2] - a[2] };
+			double r2[3] = { p[0] - b[0], p[1] - b[1], p[2] - b[2] };
+			double c[3] = { r1[1] * r2[2] - r1[2] * r2[1], 
+				r1[2] * r2[0] - r1[0] * r2[2], r1[0] * r2[1] - r1[1] * r2[0] };
+			double denominator = c[0] * c[0] + c[1] * c[1] + c[2] * c[2];
+			if (denominator < 1e-12) { continue; }
+			double l1 = sqrt(r1[0] * r1[0] + r1[1] * r1[1] + r1[2] * r1[2]);
+			double l2 = sqrt(r2[0] * r2[0] + r2[1] * r2[1] + r2[2] * r2[2]);
+			double coeff = 0;
+			for (int k = 0; k < 3; k++) { coeff += (b[k] - a[k]) * (r1[k] / l1 - r2[k] / l2); }
+			coeff /= 4 * HBTK::Constants::pi() * denominator;
+			for (int k = 0; k < 3; k++) { result[3 * i + k] += c[k] * coeff; }
+		}
+	}
+	return result;
+}
+
+// Filament by filament over a structure-of-arrays point cloud.
+HBTK::VectorField3D velocities_with_point_cloud(
+	const std::vector<HBTK::CartesianFiniteLine3D> & filaments,
+	const HBTK::PointCloud3D & points)
+{
+	HBTK::VectorField3D result(points.size());
+	for (const auto & filament : filaments) {
+		HBTK::VectorField3D r1 = points - filament.start();
+		HBTK::VectorField3D r2 = points - filament.end();
+		HBTK::VectorField3D r1xr2 = r1.cross(r2);
+		std::vector<double> denominator = r1xr2.dot(r1xr2);
+		std::vector<double> l1 = r1.magnitude(), l2 = r2.magnitude();
+		std::vector<double> coeff = r1.dot(filament.vector());
+		std::vector<double> coeff2 = r2.dot(filament.vector());
+		for (int i = 0; i < points.size(); i++) {
+			coeff[i] = denominator[i] < 1e-12 ? 0 : 
+				(coeff[i] / l1[i] - coeff2[i] / l2[i]) / (4 * HBTK::Constants::pi() * denominator[i]);
+		}
+		result += r1xr2.scale(coeff);
+	}
+	return result;
+}
+
+int main()
+{
+	std::cout << "Cartesian types Biot-Savart benchmark\n";
+	const int n_filaments = 400, n_points = 2000;
+	std::vector<HBTK::CartesianFiniteLine3D> filaments;
+	std::vector<double> raw_filaments;
+	for (int i = 0; i < n_filaments; i++) {
+		double t0 = 2 * HBTK::Constants::pi() * i / n_filaments;
+		double t1 = 2 * HBTK::Constants::pi() * (i + 1) / n_filaments;
+		HBTK::CartesianPoint3D a({ cos(t0), sin(t0), 0.01 * i }), b({ cos(t1), sin(t1), 0.01 * (i + 1) });
+		filaments.emplace_back(a, b);
+		raw_filaments.insert(raw_filaments.end(), { a.x(), a.y(), a.z(), b.x(), b.y(), b.z() });
+	}
+	std::vector<HBTK::CartesianPoint3D> points;
+	std::vector<double> raw_points;
+	for (int i = 0; i < n_points; i++) {
+		HBTK::CartesianPoint3D p({ 0.5 * sin(0.1 * i), 0.5 * cos(0.37 * i), 0.002 * i });
+		points.push_back(p);
+		raw_points.insert(raw_points.end(), { p.x(), p.y(), p.z() });
+	}
+	HBTK::PointCloud3D cloud(points);
+
+	std::vector<HBTK::CartesianVector3D> v_classes;
+	std::vector<double> v_doubles;
+	HBTK::VectorField3D v_cloud;
+	double t_classes = best_time([&]() { v_classes = velocities_with_classes(filaments, points); });
+	double t_doubles = best_time([&]() { v_doubles = velocities_with_doubles(raw_filaments, raw_points); });
+	double t_cloud = best_time([&]() { v_cloud = velocities_with_point_cloud(filaments, cloud); });
+
+	double max_difference = 0;
+	for (int i = 0; i < n_points; i++) {
+		HBTK::CartesianVector3D raw({ v_doubles[3 * i], v_doubles[3 * i + 1], v_doubles[3 * i + 2] });
+		max_difference = std::max(max_difference, (v_classes[i] - raw).magnitude());
+		max_difference = std::max(max_difference, (v_cloud[i] - raw).magnitude());
+	}
+	std::cout << n_filaments << " filaments, " << n_points << " points.\n";
+	std::cout << "CartesianPoint3D / Vector3D:\t" << t_classes << "s\n";
+	std::cout << "Arrays of doubles:\t\t" << t_doubles << "s\n";
+	std::cout << "PointCloud3D / VectorField3D:\t" << t_cloud << "s\n";
+	std::cout << "Largest difference in velocity: " << max_difference << "\n";
+	return 0;
+}
@@ -0,0 +1,170 @@
+/*////////////////////////////////////////////////////////////////////////////
+CubicSplineBenchmark_demo.cpp
+
+Timing of scalar versus batched evaluation of HBTK::CubicSpline1D.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <HBTK/CubicSpline1D.h>
+#include <HBTK/Generators.h>
+
+
+int main()
+{
+	std::cout << "CubicSplineBenchmark demo\n\n";
+
+	const int num_knots = 200;
+	const int num_queries = 2000000;
+	const int repeats = 5;
+	std::vector<double> knots(num_knots), knot_values(num_knots);
+	for (int i = 0; i < num_knots; i++) {
+		knots[i] = i * 10. / (num_knots - 1);
+		knot_values[i] = sin(knots[i]);
+	}
+	HBTK::CubicSpline1D spline(knots, knot_values);
+	HBTK::CubicSpline1D compiled(knots, knot_values);
+	compiled.compile();
+
+	std::vector<double> sorted(num_queries), shuffled;
+	for (int i = 0; i < num_queries; i++) {
+		sorted[i] = i * 10. / (num_queries - 1);
+	}
+	shuffled = sorted;
+	std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+
+	std::vector<double> v(num_queries), d1(num_queries), d2(num_queries), d3(num_queries);
+	auto time_it = [&](const char* name, auto func) {
+		double best = 1e300;
+		for (int r = 0; r < repeats; r++) {
+			auto start = std::chrono::steady_clock::now();
+			func();
+			auto end = std::chrono::steady_clock::now();
+			double t = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+			best = t < best ? t : best;
+		}
+		std::cout << name << ":\t" << best * 1e9 / num_queries << " ns per point\n";
+	};
+
+	for (auto locations : { &sorted, &shuffled }) {
+		std::cout << (locations == &sorted ? "Sorted" : "Shuffled") << " locations:\n";
+		time_it("Scalar value", [&]() {
+			for (int i = 0; i < num_queries; i++) { v[i] = spline((*locations)[i]); }
+		});
+		time_it("Batch value", [&]() {
+			v = spline.evaluate(*locations);
+		});
+		time_it("Scalar value + 3 derivs", [&]() {
+			for (int i = 0; i < num_queries; i++) {
+				v[i] = spline((*locations)[i]);
+				d1[i] = spline.derivative((*locations)[i]);
+				d2[i] = spline.derivative2((*locations)[i]);
+				d3[i] = spline.derivative3((*locations)[i]);
+			}
+		});
+		time_it("Batch value + 3 derivs", [&]() {
+			spline.evaluate(*locations, v, d1, d2, d3);
+		});
+		time_it("Compiled scalar value", [&]() {
+			for (int i = 0; i < num_queries; i++) { v[i] = compiled((*locations)[i]); }
+		});
+		time_it("Compiled batch value + 3 derivs", [&]() {
+			compiled.evaluate(*locations, v, d1, d2, d3);
+		});
+		std::cout << "\n";
+	}
+
+	// Many threads sharing one spline. The spline is constructed afresh
+	// each time so that the threads also race on its lazy setup.
+	std::cout << "Threads sharing a spline (scalar value, shuffled locations):\n";
+	const int max_threads = std::max(1, (int)std::thread::hardware_concurrency());
+	double single_thread_time = 0;
+	for (int num_threads = 1; num_threads <= max_threads; num_threads++) {
+		double best = 1e300;
+		for (int r = 0; r < repeats; r++) {
+			const HBTK::CubicSpline1D shared(knots, knot_values);
+			std::vector<std::thread> threads;
+			auto start = std::chrono::steady_clock::now();
+			for (int t = 0; t < num_threads; t++) {
+				threads.emplace_back([&, t]() {
+					int begin = (int)((long long)num_queries * t / num_threads);
+					int end = (int)((long long)num_queries * (t + 1) / num_threads);
+					for (int i = begin; i < end; i++) { v[i] = shared(shuffled[i]); }
+				});
+			}
+			for (auto & thread : threads) { thread.join(); }
+			auto end = std::chrono::steady_clock::now();
+			double t = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+			best = t < best ? t : best;
+		}
+		if (num_threads == 1) { single_thread_time = best; }
+		std::cout << num_threads << " threads:\t" << best * 1e3 << " ms\tspeedup "
+			<< single_thread_time / best << "\n";
+	}
+	std::cout << "\n";
+
+	// Construction of many splines of the same size.
+	const int num_splines = 20000;
+	const int points_per_spline = 50;
+	std::vector<double> station_knots = HBTK::linspace(0, 1, points_per_spline);
+	std::vector<std::vector<double>> station_values(num_splines);
+	for (int s = 0; s < num_splines; s++) {
+		station_values[s].resize(points_per_spline);
+		for (int i = 0; i < points_per_spline; i++) {
+			station_values[s][i] = sin(station_knots[i] * (1. + s * 1e-4));
+		}
+	}
+	std::cout << "Constructing " << num_splines << " splines of " << points_per_spline << " points:\n";
+	auto time_construction = [&](const char* name, auto func) {
+		double best = 1e300;
+		for (int r = 0; r < repeats; r++) {
+			auto start = std::chrono::steady_clock::now();
+			func();
+			auto end = std::chrono::steady_clock::now();
+			double t = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+			best = t < best ? t : best;
+		}
+		std::cout << name << ":\t" << num_splines / best << " splines per second\n";
+	};
+	time_construction("One at a time", [&]() {
+		std::vector<HBTK::CubicSpline1D> splines;
+		splines.reserve(num_splines);
+		for (int s = 0; s < num_splines; s++) {
+			splines.emplace_back(station_knots, station_values[s]);
+			splines.back()(0.5);	// Forces setup.
+		}
+	});
+	time_construction("construct_many", [&]() {
+		auto splines = HBTK::CubicSpline1D::construct_many(station_knots, station_values);
+	});
+	time_construction("construct_many, all threads", [&]() {
+		auto splines = HBTK::CubicSpline1D::construct_many(station_knots, station_values, max_threads);
+	});
+	return 0;
+}
@@ -0,0 +1,126 @@
+/*////////////////////////////////////////////////////////////////////////////
+DenseSolverBenchmark_demo.cpp
+
+Timing of the dense LU and GMRES solvers on vortex panel systems against an
+unblocked LU.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <HBTK/Constants.h>
+#include <HBTK/DenseLinearSolvers.h>
+#include <HBTK/PanelInfluenceMatrix.h>
+
+
+template<typename TyFunc>
+double best_time(TyFunc func, int repeats = 3)
+{
+	double best = 1e300;
+	for (int r = 0; r < repeats; r++) {
+		auto start = std::chrono::steady_clock::now();
+		func();
+		auto end = std::chrono::steady_clock::now();
+		double t = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+		best = t < best ? t : best;
+	}
+	return best;
+}
+
+// Textbook LU with partial pivoting, one column at a time.
+void unblocked_lu(HBTK::DenseMatrix & a, std::vector<int> & pivots)
+{
+	const int n = a.rows();
+	pivots.resize(n);
+	for (int j = 0; j < n; j++) {
+		int pivot = j;
+		for (int i = j + 1; i < n; i++) {
+			if (std::abs(a(i, j)) > std::abs(a(pivot, j))) { pivot = i; }
+		}
+		pivots[j] = pivot;
+		std::swap_ranges(a.row(j), a.row(j) + n, a.row(pivot));
+		for (int i = j + 1; i < n; i++) {
+			const double l = a(i, j) /= a(j, j);
+			for (int c = j + 1; c < n; c++) { a(i, c) -= l * a(j, c); }
+		}
+	}
+}
+
+int main()
+{
+	std::cout << "Dense linear solver benchmark\n";
+	std::vector<int> thread_counts = { 1 };
+	if (std::thread::hardware_concurrency() > 1) {
+		thread_counts.push_back((int)std::thread::hardware_concurrency());
+	}
+	for (int n_panels : { 1000, 2000, 4000 }) {
+		// Zero tangential velocity inside an ellipse with a free stream.
+		std::vector<double> x_nodes, y_nodes;
+		for (int i = 0; i <= n_panels; i++) {
+			double t = 2 * HBTK::Constants::pi() * i / n_panels;
+			x_nodes.push_back(0.5 * cos(t));
+			y_nodes.push_back(-0.1 * sin(t));
+		}
+		auto panels = HBTK::PanelGeometry2D::from_polyline(x_nodes, y_nodes);
+		auto matrix = HBTK::ConstantVortexDistribution::directional_influence_matrix(
+			panels, panels.x_midpoint(), panels.y_midpoint(), 
+			panels.cos_angle(), panels.sin_angle(), (int)thread_counts.back());
+		std::vector<double> rhs(n_panels);
+		for (int i = 0; i < n_panels; i++) { rhs[i] = -panels.cos_angle()[i]; }
+		double flops = 2. / 3. * n_panels * (double)n_panels * n_panels;
+		std::cout << n_panels << " panels:\n";
+
+		if (n_panels <= 2000) {
+			std::vector<int> pivots;
+			double t = best_time([&]() {
+				HBTK::DenseMatrix a = matrix;
+				unblocked_lu(a, pivots);
+			}, 1);
+			std::cout << "\tunblocked LU:\t\t\t" << t << "s\t(" << flops / t / 1e9 << " GFLOP/s)\n";
+		}
+		for (int threads : thread_counts) {
+			double t = best_time([&]() {
+				HBTK::LUFactorisation lu(matrix, threads);
+			});
+			std::cout << "\tLUFactorisation, " << threads << " thread(s):\t" << t << "s\t(" 
+				<< flops / t / 1e9 << " GFLOP/s)\n";
+		}
+		HBTK::LUFactorisation lu(matrix, thread_counts.back());
+		double t = best_time([&]() { auto x = lu.solve(rhs); }, 10);
+		std::cout << "\treused factorisation solve:\t" << t << "s\n";
+		HBTK::IterativeSolveReport report;
+		for (int threads : thread_counts) {
+			t = best_time([&]() {
+				auto x = HBTK::gmres(matrix, rhs, {}, 1e-10, 50, 1000, threads, &report);
+			});
+			std::cout << "\tGMRES, " << threads << " thread(s):\t\t" << t << "s\t(" 
+				<< report.iterations << " iterations)\n";
+		}
+	}
+	return 0;
+}
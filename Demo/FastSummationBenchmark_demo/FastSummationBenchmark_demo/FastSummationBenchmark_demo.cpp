@@ -0,0 +1,144 @@
+/*////////////////////////////////////////////////////////////////////////////
+FastSummationBenchmark_demo.cpp
+
+Timing and accuracy of the fast multipole method for 2D point vortices
+and the treecode for 3D vortex filaments against direct summation.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <HBTK/PotentialFlowDistributions.h>
+
+
+template<typename TyFunc>
+double best_time(TyFunc func, int repeats = 3)
+{
+	double best = 1e300;
+	for (int r = 0; r < repeats; r++) {
+		auto start = std::chrono::steady_clock::now();
+		func();
+		auto end = std::chrono::steady_clock::now();
+		double t = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+		best = t < best ? t : best;
+	}
+	return best;
+}
+
+// Largest difference between two velocity fields relative to the largest 
+// velocity of the second.
+double relative_error(const std::vector<double> & u0, const std::vector<double> & v0,
+	const std::vector<double> & u1, const std::vector<double> & v1,
+	const std::vector<double> & w0 = {}, const std::vector<double> & w1 = {})
+{
+	double error = 0, scale = 0;
+	for (size_t i = 0; i < u0.size(); i++) {
+		double dw = w0.empty() ? 0 : w0[i] - w1[i];
+		double w = w1.empty() ? 0 : w1[i];
+		error = std::max(error, sqrt(pow(u0[i] - u1[i], 2) + pow(v0[i] - v1[i], 2) + dw * dw));
+		scale = std::max(scale, sqrt(u1[i] * u1[i] + v1[i] * v1[i] + w * w));
+	}
+	return error / scale;
+}
+
+// A 2D wake rolling up into a spiral, measured at its own vortices.
+void benchmark_2d()
+{
+	std::cout << "2D point vortices, measured at the vortices:\n";
+	for (int n : { 10000, 100000, 1000000 }) {
+		std::vector<double> x, y, strengths;
+		for (int j = 0; j < n; j++) {
+			double s = (double)j / n;
+			x.push_back(sqrt(s) * cos(60 * s));
+			y.push_back(sqrt(s) * sin(60 * s));
+			strengths.push_back(1. / n);
+		}
+		std::pair<std::vector<double>, std::vector<double>> direct;
+		double t_direct = -1;
+		if (n <= 100000) {
+			t_direct = best_time([&]() {
+				direct = HBTK::PointVortex::induced_vel(x, y, x, y, strengths);
+			}, 1);
+		}
+		std::cout << "\t" << n << " vortices, direct:\t" << t_direct << "s\n";
+		for (double tolerance : { 1e-4, 1e-8, 1e-12 }) {
+			std::pair<std::vector<double>, std::vector<double>> fmm;
+			double t = best_time([&]() {
+				fmm = HBTK::PointVortex::induced_vel_fmm(x, y, x, y, strengths, tolerance);
+			}, 1);
+			std::cout << "\t" << n << " vortices, FMM tol " << tolerance << ":\t" << t << "s";
+			if (t_direct > 0) {
+				std::cout << "\t(x" << t_direct / t << ", error " 
+					<< relative_error(fmm.first, fmm.second, direct.first, direct.second) << ")";
+			}
+			std::cout << "\n";
+		}
+	}
+}
+
+// A helical 3D wake of n filaments measured at its own nodes. The filaments 
+// are singular: the treecode doesn't apply cores to distant filaments.
+void benchmark_3d()
+{
+	const int n_threads = std::max(1, (int)std::thread::hardware_concurrency());
+	std::cout << "3D vortex filaments, measured at the filament starts, " 
+		<< n_threads << " thread(s):\n";
+	for (int n : { 10000, 100000 }) {
+		HBTK::PointCloud3D starts, ends;
+		std::vector<double> strengths;
+		const double turns = 20;
+		for (int j = 0; j < n; j++) {
+			double t0 = 2 * turns * 3.14159265 * j / n, t1 = 2 * turns * 3.14159265 * (j + 1) / n;
+			starts.push_back(HBTK::CartesianPoint3D({ cos(t0), sin(t0), 0.5 * t0 }));
+			ends.push_back(HBTK::CartesianPoint3D({ cos(t1), sin(t1), 0.5 * t1 }));
+			strengths.push_back(1);
+		}
+		HBTK::VectorField3D direct;
+		double t_direct = best_time([&]() {
+			direct = HBTK::BiotSavart::induced_vel(starts, starts, ends, strengths, 0, n_threads);
+		}, 1);
+		std::cout << "\t" << n << " filaments, direct:\t\t" << t_direct << "s\n";
+		for (double opening_angle : { 0.7, 0.5, 0.3 }) {
+			HBTK::VectorField3D tree;
+			double t = best_time([&]() {
+				tree = HBTK::BiotSavart::induced_vel_treecode(starts, starts, ends, strengths, 0, 
+					n_threads, opening_angle);
+			}, 1);
+			std::cout << "\t" << n << " filaments, treecode " << opening_angle << ":\t" << t << "s\t(x"
+				<< t_direct / t << ", error " << relative_error(tree.x(), tree.y(), direct.x(), direct.y(),
+					tree.z(), direct.z()) << ")\n";
+		}
+	}
+}
+
+int main()
+{
+	std::cout << "Fast summation benchmark\n";
+	benchmark_2d();
+	benchmark_3d();
+	return 0;
+}
@@ -1,4 +1,6 @@
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <vector>
 #include <chrono>
@@ -96,6 +98,62 @@ int main()
 	acc_plt.replot_on();
 	acc_plt.replot();
 
+	// Newton iteration (O(n^2)) vs asymptotic expansion (O(n)) for large quadratures.
+	std::cout << "Points\tNewton (s)\tAsymptotic (s)\tMax point difference\n";
+	for (int n : { 1000, 3000, 10000, 30000, 100000 }) {
+		std::vector<double> newton_points(n), newton_weights(n), asym_points, asym_weights;
+		double newton_time = NAN, difference = NAN;
+		if (n <= 10000) {
+			auto start = std::chrono::steady_clock::now();
+			HBTK::gauss_legendre<double>(n, newton_points, newton_weights);
+			auto end = std::chrono::steady_clock::now();
+			newton_time = std::chrono::duration_cast<std::chrono::duration<double> >(end - start).count();
+		}
+		auto start = std::chrono::steady_clock::now();
+		HBTK::gauss_legendre_asymptotic(n, asym_points, asym_weights);
+		auto end = std::chrono::steady_clock::now();
+		double asym_time = std::chrono::duration_cast<std::chrono::duration<double> >(end - start).count();
+		if (n <= 10000) {
+			difference = 0;
+			for (int i = 0; i < n; i++) {
+				difference = std::max(difference, std::abs(newton_points[i] - asym_points[i]));
+			}
+		}
+		std::cout << n << "\t" << newton_time << "\t" << asym_time << "\t" << difference << "\n";
+	}
+
+	// Runtime generated versus compile time generated 16 point quadrature.
+	{
+		const int num_integrals = 1000000;
+		auto integrand = [](double x) { return cos(x); };
+		double sink = 0;
+		auto start = std::chrono::steady_clock::now();
+		std::array<double, 16> array_points, array_weights;
+		HBTK::gauss_legendre<16, double>(array_points, array_weights);
+		auto end = std::chrono::steady_clock::now();
+		double setup_time = std::chrono::duration_cast<std::chrono::duration<double> >(end - start).count();
+
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < num_integrals; i++) {
+			sink += HBTK::static_integrate<16>(integrand, array_points, array_weights);
+		}
+		end = std::chrono::steady_clock::now();
+		double runtime_table_time = std::chrono::duration_cast<std::chrono::duration<double> >(end - start).count();
+
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < num_integrals; i++) {
+			sink += HBTK::gauss_legendre_integrate<16>(integrand);
+		}
+		end = std::chrono::steady_clock::now();
+		double constexpr_table_time = std::chrono::duration_cast<std::chrono::duration<double> >(end - start).count();
+
+		std::cout << "\n16 point Gauss-Legendre, " << num_integrals << " integrals:\n";
+		std::cout << "Runtime table setup (s):\t" << setup_time << "\n";
+		std::cout << "Runtime table integrals (s):\t" << runtime_table_time << "\n";
+		std::cout << "Compile time table integrals (s):\t" << constexpr_table_time 
+			<< "\t(" << sink << ")\n";
+	}
+
 	system("pause");
 	return 0;
 }
@@ -0,0 +1,160 @@
+/*////////////////////////////////////////////////////////////////////////////
+GmshReaderBenchmark_demo.cpp
+
+Throughput of the memory mapped .msh reader against GmshParser, on a large 
+generated triangle mesh in ASCII and binary form.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <HBTK/GmshMeshArrays.h>
+#include <HBTK/GmshMeshHolder.h>
+#include <HBTK/GmshParser.h>
+
+
+template<typename TyFunc>
+double best_time(TyFunc func, int repeats = 3)
+{
+	double best = 1e300;
+	for (int r = 0; r < repeats; r++) {
+		auto start = std::chrono::steady_clock::now();
+		func();
+		auto end = std::chrono::steady_clock::now();
+		double t = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+		best = t < best ? t : best;
+	}
+	return best;
+}
+
+// A square of n by n cells, each split into two triangles, with the 
+// boundary as line elements.
+void write_mesh(const std::string & path, int n, bool binary)
+{
+	FILE * file = fopen(path.c_str(), "wb");
+	fprintf(file, "$MeshFormat\n2.2 %d 8\n", binary ? 1 : 0);
+	const int one = 1;
+	if (binary) { fwrite(&one, sizeof(int), 1, file); fprintf(file, "\n"); }
+	fprintf(file, "$EndMeshFormat\n$PhysicalNames\n2\n1 1 \"Boundary\"\n2 2 \"Surface\"\n$EndPhysicalNames\n");
+	fprintf(file, "$Nodes\n%d\n", (n + 1) * (n + 1));
+	for (int j = 0; j <= n; j++) {
+		for (int i = 0; i <= n; i++) {
+			int tag = j * (n + 1) + i + 1;
+			double xyz[3] = { (double)i / n, (double)j / n + 0.1 * sin((double)i / n), 0 };
+			if (binary) {
+				fwrite(&tag, sizeof(int), 1, file);
+				fwrite(xyz, sizeof(double), 3, file);
+			}
+			else {
+				fprintf(file, "%d %.16g %.16g %.16g\n", tag, xyz[0], xyz[1], xyz[2]);
+			}
+		}
+	}
+	fprintf(file, "%s$EndNodes\n", binary ? "\n" : "");
+	fprintf(file, "$Elements\n%d\n", 2 * n * n + 4 * n);
+	int element = 1;
+	auto node = [n](int i, int j) { return j * (n + 1) + i + 1; };
+	auto write_block = [&](int type, const std::vector<std::vector<int>> & nodes, int group) {
+		if (binary) {
+			int header[3] = { type, (int)nodes.size(), 2 };
+			fwrite(header, sizeof(int), 3, file);
+		}
+		for (auto & element_nodes : nodes) {
+			if (binary) {
+				int record[3 + 3] = { element++, group, group };
+				for (size_t k = 0; k < element_nodes.size(); k++) { record[3 + k] = element_nodes[k]; }
+				fwrite(record, sizeof(int), 3 + element_nodes.size(), file);
+			}
+			else {
+				fprintf(file, "%d %d 2 %d %d", element++, type, group, group);
+				for (int k : element_nodes) { fprintf(file, " %d", k); }
+				fprintf(file, "\n");
+			}
+		}
+	};
+	std::vector<std::vector<int>> lines;
+	for (int i = 0; i < n; i++) {
+		lines.push_back({ node(i, 0), node(i + 1, 0) });
+		lines.push_back({ node(n, i), node(n, i + 1) });
+		lines.push_back({ node(i + 1, n), node(i, n) });
+		lines.push_back({ node(0, i + 1), node(0, i) });
+	}
+	write_block(1, lines, 1);
+	// Rows of triangles are written in blocks to bound the memory used.
+	for (int j = 0; j < n; j++) {
+		std::vector<std::vector<int>> triangles;
+		for (int i = 0; i < n; i++) {
+			triangles.push_back({ node(i, j), node(i + 1, j), node(i + 1, j + 1) });
+			triangles.push_back({ node(i, j), node(i + 1, j + 1), node(i, j + 1) });
+		}
+		write_block(2, triangles, 2);
+	}
+	fprintf(file, "%s$EndElements\n", binary ? "\n" : "");
+	fclose(file);
+}
+
+int main(int argc, char * argv[])
+{
+	// About 10 million elements by default.
+	const int target_elements = argc > 1 ? atoi(argv[1]) : 10000000;
+	const int n = (int)sqrt(target_elements / 2.);
+	std::cout << "Gmsh .msh reader benchmark\n";
+	for (bool binary : { false, true }) {
+		const std::string path = binary ? "GmshReaderBenchmark_binary.msh" : "GmshReaderBenchmark_ascii.msh";
+		write_mesh(path, n, binary);
+		HBTK::Gmsh::GmshMeshArrays mesh;
+		double t_arrays = best_time([&]() { mesh = HBTK::Gmsh::read_mesh_arrays(path); });
+		FILE * file = fopen(path.c_str(), "rb");
+		fseek(file, 0, SEEK_END);
+		const double megabytes = ftell(file) / 1e6;
+		fclose(file);
+		std::cout << (binary ? "Binary" : "ASCII") << " file, " << mesh.number_of_nodes() << " nodes, "
+			<< mesh.number_of_elements() << " elements, " << megabytes << " MB:\n";
+
+		int nodes = 0, elements = 0;
+		HBTK::Gmsh::GmshParser parser;
+		parser.add_node_function([&](int, double, double, double)->bool { nodes++; return true; });
+		parser.add_elem_function([&](int, int, std::vector<int>, std::vector<int>)->bool { elements++; return true; });
+		double t_parser = best_time([&]() { parser.parse(path); }, 1);
+		std::cout << "\tGmshParser:\t\t" << t_parser << "s\t(" << megabytes / t_parser << " MB/s)\n";
+
+		HBTK::Gmsh::GmshParser block_parser;
+		block_parser.add_node_block_function([&](const HBTK::Gmsh::NodeBlock & block) { nodes += block.size; });
+		block_parser.add_elem_block_function([&](const HBTK::Gmsh::ElementBlock & block) { elements += block.size; });
+		double t_block = best_time([&]() { block_parser.parse(path); });
+		std::cout << "\tGmshParser (blocks):\t" << t_block << "s\t(" << megabytes / t_block << " MB/s)\n";
+
+		double t_holder = best_time([&]() {
+			HBTK::Gmsh::GmshMeshHolder holder;
+			holder.get_parser().parse(path); }, 1);
+		std::cout << "\tGmshMeshHolder:\t\t" << t_holder << "s\t(" << megabytes / t_holder << " MB/s)\n";
+		std::cout << "\tread_mesh_arrays:\t" << t_arrays << "s\t(" << megabytes / t_arrays << " MB/s)\n";
+		std::remove(path.c_str());
+	}
+	return 0;
+}
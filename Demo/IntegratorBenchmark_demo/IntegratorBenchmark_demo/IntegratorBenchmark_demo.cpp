@@ -0,0 +1,218 @@
+/*////////////////////////////////////////////////////////////////////////////
+IntegratorBenchmark_demo.cpp
+
+Timing of the integrators in HBTK/Integrators.h.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <HBTK/GaussKronrod.h>
+#include <HBTK/GaussLegendre.h>
+#include <HBTK/Integrators.h>
+#include <HBTK/ParallelIntegrators.h>
+#include <HBTK/Remaps.h>
+
+
+// Count every heap allocation made by the program.
+static std::atomic<long> g_allocations(0);
+
+void * operator new(std::size_t size)
+{
+	g_allocations++;
+	void * ptr = std::malloc(size == 0 ? 1 : size);
+	if (ptr == nullptr) { throw std::bad_alloc(); }
+	return ptr;
+}
+
+void operator delete(void * ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+
+template<typename TyFunc>
+double best_time(TyFunc func, int repeats = 5)
+{
+	double best = 1e300;
+	for (int r = 0; r < repeats; r++) {
+		auto start = std::chrono::steady_clock::now();
+		func();
+		auto end = std::chrono::steady_clock::now();
+		double t = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+		best = t < best ? t : best;
+	}
+	return best;
+}
+
+int main()
+{
+	std::cout << "IntegratorBenchmark demo\n\n";
+
+	// Many kernels integrated on one rule: one integrand per collocation point.
+	{
+		const int num_points = 16;
+		const int num_kernels = 4000;
+		std::vector<double> points(num_points), weights(num_points);
+		HBTK::gauss_legendre<double>(num_points, points, weights);
+		std::vector<double> collocation(num_kernels);
+		for (int j = 0; j < num_kernels; j++) { collocation[j] = 1.5 + j * 1e-3; }
+		std::vector<double> results(num_kernels);
+		double sink = 0;
+
+		double scalar = best_time([&]() {
+			for (int j = 0; j < num_kernels; j++) {
+				double c = collocation[j];
+				auto kernel = [=](double x) { return 1. / (c - x); };
+				results[j] = HBTK::static_integrate(kernel, points, weights, num_points);
+			}
+			sink += results[0];
+		});
+		double batch = best_time([&]() {
+			auto kernels = [&](const std::vector<double> & x, std::vector<double> & f) {
+				for (int j = 0; j < num_kernels; j++) {
+					const double c = collocation[j];
+					double * fj = f.data() + j * num_points;
+					for (int i = 0; i < num_points; i++) { fj[i] = 1. / (c - x[i]); }
+				}
+			};
+			results = HBTK::static_integrate_batch(kernels, points, weights, num_kernels);
+			sink += results[0];
+		});
+		std::cout << num_kernels << " kernels on a " << num_points << " point rule:\n";
+		std::cout << "static_integrate:\t" << num_kernels / scalar << " integrals per second\n";
+		std::cout << "static_integrate_batch:\t" << num_kernels / batch << " integrals per second\n";
+		std::cout << "(" << sink << ")\n\n";
+	}
+
+	// Adaptive integrators: time, evaluations and heap allocations per integral.
+	{
+		const int num_integrals = 2000;
+		HBTK::AdaptiveIntegrationReport report;
+		double sink = 0;
+		auto run = [&](const char * name, auto integrator) {
+			long evaluations = 0;
+			long allocations = g_allocations;
+			auto start = std::chrono::steady_clock::now();
+			for (int j = 0; j < num_integrals; j++) {
+				double c = 1e-2 + j * 1e-5;
+				auto kernel = [=](double x) { return 1. / (x * x + c); };
+				sink += integrator(kernel, report);
+				evaluations += report.evaluations;
+			}
+			auto end = std::chrono::steady_clock::now();
+			allocations = g_allocations - allocations;
+			double t = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+			std::cout << name << ":\t" << num_integrals / t << " integrals per second, "
+				<< (double)evaluations / num_integrals << " evaluations and "
+				<< (double)allocations / num_integrals << " allocations per integral\n";
+		};
+		run("adaptive_trapezoidal_integrate", [](auto & f, HBTK::AdaptiveIntegrationReport & r) {
+			return HBTK::adaptive_trapezoidal_integrate(f, 1e-5, -1.0, 1.0, 100000, &r); });
+		run("adaptive_simpsons_integrate", [](auto & f, HBTK::AdaptiveIntegrationReport & r) {
+			return HBTK::adaptive_simpsons_integrate(f, 1e-10, -1.0, 1.0, 100000, &r); });
+		run("adaptive_gauss_lobatto_integrate", [](auto & f, HBTK::AdaptiveIntegrationReport & r) {
+			return HBTK::adaptive_gauss_lobatto_integrate(f, 1e-10, -1.0, 1.0, 100000, &r); });
+		run("adaptive_simpsons_integrate, 200 evaluation budget", [](auto & f, HBTK::AdaptiveIntegrationReport & r) {
+			return HBTK::adaptive_simpsons_integrate(f, 1e-10, -1.0, 1.0, 200, &r); });
+		std::cout << "(" << sink << ")\n\n";
+	}
+
+	// Parallel adaptive integration of an expensive integrand. Each 
+	// evaluation is itself a quadrature, like an influence integral.
+	{
+		std::vector<double> points(64), weights(64);
+		HBTK::gauss_legendre<double>(64, points, weights);
+		auto expensive = [&](double y)->double {
+			double sum = 0;
+			for (int rep = 0; rep < 50; rep++) {
+				for (int i = 0; i < 64; i++) {
+					sum += weights[i] / sqrt((points[i] - y) * (points[i] - y) + 1e-2 + rep * 1e-6);
+				}
+			}
+			return sum / 50;
+		};
+		HBTK::AdaptiveIntegrationReport report;
+		double serial_result = 0, sink = 0;
+		double serial = best_time([&]() {
+			serial_result = HBTK::adaptive_gauss_lobatto_integrate(expensive, 1e-10, -1.0, 1.0, 
+				1000000, &report);
+		}, 3);
+		std::cout << "adaptive_gauss_lobatto_integrate:\t" << serial << " s, " 
+			<< report.evaluations << " evaluations\n";
+		int max_threads = std::max(1, (int)std::thread::hardware_concurrency());
+		for (int threads = 1; threads <= max_threads; threads *= 2) {
+			double result = 0;
+			double t = best_time([&]() {
+				result = HBTK::parallel_adaptive_gauss_lobatto_integrate(expensive, 1e-10, 
+					-1.0, 1.0, threads, 1000000, &report);
+			}, 3);
+			sink += result;
+			std::cout << "parallel_adaptive_gauss_lobatto_integrate, " << threads 
+				<< " threads:\t" << t << " s, speedup " << serial / t 
+				<< ", difference from serial " << result - serial_result << "\n";
+		}
+		std::cout << "(" << sink << ")\n\n";
+	}
+
+	// Evaluations needed for a log singular panel integral to 1e-10.
+	{
+		int calls = 0;
+		auto singular = [&](double x)->double { calls++; return log(std::abs(x - 0.3)); };
+		const double exact = 1.3 * log(1.3) + 0.7 * log(0.7) - 2;
+		auto show = [&](const char * name, double result) {
+			std::cout << name << ":\t" << calls << " evaluations, error " 
+				<< result - exact << "\n";
+			calls = 0;
+		};
+		show("adaptive_gauss_lobatto_integrate", 
+			HBTK::adaptive_gauss_lobatto_integrate(singular, 1e-10, -1.0, 1.0));
+		show("gauss_kronrod_integrate, 10/21, no extrapolation",
+			HBTK::gauss_kronrod_integrate(singular, -1.0, 1.0, 1e-10, 1e-10,
+				HBTK::gauss_kronrod_10_21, false));
+		show("gauss_kronrod_integrate, 7/15",
+			HBTK::gauss_kronrod_integrate(singular, -1.0, 1.0, 1e-10, 1e-10,
+				HBTK::gauss_kronrod_7_15));
+		show("gauss_kronrod_integrate, 10/21",
+			HBTK::gauss_kronrod_integrate(singular, -1.0, 1.0, 1e-10, 1e-10));
+		auto telles = [](double & p, double & w) { HBTK::telles_cubic_remap(p, w, 0.3); };
+		show("gauss_kronrod_integrate_remapped, Telles cubic, 7/15",
+			HBTK::gauss_kronrod_integrate_remapped(singular, telles, -1.0, 1.0, 1e-10, 1e-10,
+				HBTK::gauss_kronrod_7_15));
+		std::cout << "\n";
+	}
+	return 0;
+}
@@ -0,0 +1,104 @@
+/*////////////////////////////////////////////////////////////////////////////
+PanelInfluenceBenchmark_demo.cpp
+
+Timing of vortex panel influence matrix assembly against a loop over the
+single panel functions.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <HBTK/Constants.h>
+#include <HBTK/PanelInfluenceMatrix.h>
+#include <HBTK/PotentialFlowDistributions.h>
+
+
+template<typename TyFunc>
+double best_time(TyFunc func, int repeats = 3)
+{
+	double best = 1e300;
+	for (int r = 0; r < repeats; r++) {
+		auto start = std::chrono::steady_clock::now();
+		func();
+		auto end = std::chrono::steady_clock::now();
+		double t = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+		best = t < best ? t : best;
+	}
+	return best;
+}
+
+int main()
+{
+	std::cout << "Vortex panel influence matrix benchmark\n";
+	std::vector<int> thread_counts = { 1 };
+	if (std::thread::hardware_concurrency() > 1) {
+		thread_counts.push_back((int)std::thread::hardware_concurrency());
+	}
+	for (int n_panels : { 1000, 3000, 10000 }) {
+		std::vector<double> x_nodes, y_nodes;
+		for (int i = 0; i <= n_panels; i++) {
+			double t = 2 * HBTK::Constants::pi() * i / n_panels;
+			x_nodes.push_back(0.5 * cos(t));
+			y_nodes.push_back(-0.06 * sin(t));
+		}
+		auto panels = HBTK::PanelGeometry2D::from_polyline(x_nodes, y_nodes);
+		auto x_mid = panels.x_midpoint(), y_mid = panels.y_midpoint();
+		auto x_normal = panels.x_normal(), y_normal = panels.y_normal();
+		double entries = (double)n_panels * n_panels;
+		std::cout << n_panels << " panels, normal velocity at the midpoints:\n";
+
+		{
+			HBTK::DenseMatrix matrix(n_panels, n_panels);
+			double t = best_time([&]() {
+				for (int i = 0; i < n_panels; i++) {
+					for (int j = 0; j < n_panels; j++) {
+						auto vel = HBTK::ConstantVortexDistribution::unity_vel(x_mid[i], y_mid[i],
+							x_nodes[j], y_nodes[j], x_nodes[j + 1], y_nodes[j + 1]);
+						matrix(i, j) = vel.first * x_normal[i] + vel.second * y_normal[i];
+					}
+				}
+			}, 1);
+			std::cout << "\tunity_vel loop:\t\t\t" << t << "s\t(" 
+				<< entries / t / 1e6 << " M entries/s)\n";
+		}
+		for (int threads : thread_counts) {
+			double t = best_time([&]() {
+				auto matrix = HBTK::ConstantVortexDistribution::directional_influence_matrix(
+					panels, x_mid, y_mid, x_normal, y_normal, threads);
+			}, n_panels < 10000 ? 3 : 1);
+			std::cout << "\tconstant assembly, " << threads << " thread(s):\t" << t << "s\t("
+				<< entries / t / 1e6 << " M entries/s)\n";
+			t = best_time([&]() {
+				auto matrix = HBTK::LinearVortexDistribution::directional_influence_matrix(
+					panels, x_mid, y_mid, x_normal, y_normal, threads);
+			}, n_panels < 10000 ? 3 : 1);
+			std::cout << "\tlinear assembly, " << threads << " thread(s):\t" << t << "s\t("
+				<< entries / t / 1e6 << " M panel-point pairs/s)\n";
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,127 @@
+/*////////////////////////////////////////////////////////////////////////////
+PointSingularityBenchmark_demo.cpp
+
+Timing of the fused point source, vortex and doublet kernels against loops 
+over the scalar templates.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <HBTK/PotentialFlowDistributions.h>
+
+
+template<typename TyFunc>
+double best_time(TyFunc func, int repeats = 3)
+{
+	double best = 1e300;
+	for (int r = 0; r < repeats; r++) {
+		auto start = std::chrono::steady_clock::now();
+		func();
+		auto end = std::chrono::steady_clock::now();
+		double t = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+		best = t < best ? t : best;
+	}
+	return best;
+}
+
+int main()
+{
+	std::cout << "Point singularity (u, v, potential) benchmark\n";
+	std::vector<int> thread_counts = { 1 };
+	if (std::thread::hardware_concurrency() > 1) {
+		thread_counts.push_back((int)std::thread::hardware_concurrency());
+	}
+	const int n_points = 4000, n_singularities = 4000;
+	std::vector<double> xm(n_points), ym(n_points), xs(n_singularities), ys(n_singularities);
+	std::vector<double> strengths(n_singularities), angles(n_singularities);
+	for (int i = 0; i < n_points; i++) {
+		xm[i] = 2 * sin(1.1 * i);
+		ym[i] = cos(0.37 * i);
+	}
+	for (int j = 0; j < n_singularities; j++) {
+		xs[j] = 1.5 * cos(0.9 * j);
+		ys[j] = sin(2.3 * j) - 0.2;
+		strengths[j] = 1 + 0.5 * sin(0.1 * j);
+		angles[j] = 0.4 * j;
+	}
+	const double pairs = (double)n_points * n_singularities;
+	std::vector<double> u(n_points), v(n_points), p(n_points);
+	auto report = [&](const char * name, double t) {
+		std::cout << "\t" << name << t << "s\t(" << pairs / t / 1e6 << " M pairs/s)\n";
+	};
+	// The scalar loops keep a running sum so that nothing is optimised away.
+	auto scalar_loop = [&](auto u_func, auto v_func, auto p_func) {
+		for (int i = 0; i < n_points; i++) {
+			double su = 0, sv = 0, sp = 0;
+			for (int j = 0; j < n_singularities; j++) {
+				su += strengths[j] * u_func(i, j);
+				sv += strengths[j] * v_func(i, j);
+				sp += strengths[j] * p_func(i, j);
+			}
+			u[i] = su; v[i] = sv; p[i] = sp;
+		}
+	};
+
+	std::cout << n_points << " points, " << n_singularities << " singularities:\n";
+	report("source templates:\t\t", best_time([&]() {
+		scalar_loop(
+			[&](int i, int j) { return HBTK::PointSource::unity_u_vel(xm[i], ym[i], xs[j], ys[j]); },
+			[&](int i, int j) { return HBTK::PointSource::unity_v_vel(xm[i], ym[i], xs[j], ys[j]); },
+			[&](int i, int j) { return HBTK::PointSource::unity_vel_pot(xm[i], ym[i], xs[j], ys[j]); });
+	}, 1));
+	for (int threads : thread_counts) {
+		std::cout << "\tsource fused, " << threads << " thread(s):";
+		report("\t", best_time([&]() {
+			HBTK::PointSource::induced_vel_and_pot(xm, ym, xs, ys, strengths, u, v, p, threads);
+		}));
+	}
+	report("vortex templates:\t\t", best_time([&]() {
+		scalar_loop(
+			[&](int i, int j) { return HBTK::PointVortex::unity_u_vel(xm[i], ym[i], xs[j], ys[j]); },
+			[&](int i, int j) { return HBTK::PointVortex::unity_v_vel(xm[i], ym[i], xs[j], ys[j]); },
+			[&](int i, int j) { return HBTK::PointVortex::unity_vel_pot(xm[i], ym[i], xs[j], ys[j]); });
+	}, 1));
+	for (int threads : thread_counts) {
+		std::cout << "\tvortex fused, " << threads << " thread(s):";
+		report("\t", best_time([&]() {
+			HBTK::PointVortex::induced_vel_and_pot(xm, ym, xs, ys, strengths, u, v, p, threads);
+		}));
+	}
+	report("doublet templates:\t\t", best_time([&]() {
+		scalar_loop(
+			[&](int i, int j) { return HBTK::PointDoublet::unity_u_vel(xm[i], ym[i], xs[j], ys[j], angles[j]); },
+			[&](int i, int j) { return HBTK::PointDoublet::unity_v_vel(xm[i], ym[i], xs[j], ys[j], angles[j]); },
+			[&](int i, int j) { return HBTK::PointDoublet::unity_vel_pot(xm[i], ym[i], xs[j], ys[j], angles[j]); });
+	}, 1));
+	for (int threads : thread_counts) {
+		std::cout << "\tdoublet fused, " << threads << " thread(s):";
+		report("\t", best_time([&]() {
+			HBTK::PointDoublet::induced_vel_and_pot(xm, ym, xs, ys, strengths, angles, u, v, p, threads);
+		}));
+	}
+	return 0;
+}
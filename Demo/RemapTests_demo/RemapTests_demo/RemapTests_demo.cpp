@@ -25,6 +25,7 @@ SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <functional>
 #include <iostream>
@@ -33,6 +34,7 @@ SOFTWARE.
 #include <HBTK/Generators.h>
 #include <HBTK/GnuPlot.h>
 #include <HBTK/Integrators.h>
+#include <HBTK/QuadratureSelector.h>
 #include <HBTK/Remaps.h>
 
 
@@ -203,9 +205,32 @@ void inf_limit_plot_1(std::function<double(double)> func, double true_int, std::
 
 
 
+// Print the remap and number of points QuadratureSelector picks for a 
+// singularity at -1 (end) and 0.3 (interior) as it moves away from the element.
+void print_quadrature_selections()
+{
+	auto start = std::chrono::steady_clock::now();
+	HBTK::QuadratureSelector::select(0, 1, 1e-6);	// Triggers the calibration.
+	auto end = std::chrono::steady_clock::now();
+	std::cout << "Quadrature selector calibration took " 
+		<< std::chrono::duration<double>(end - start).count() << "s\n";
+	const char* names[] = { "none", "telles_quadratic", "telles_cubic",
+		"sato4", "sato5", "doblare" };
+	for (double position : { -1., 0.3 }) {
+		std::cout << "Singularity at " << position << ", tolerance 1e-6:\n";
+		for (double distance : HBTK::QuadratureSelector::calibrated_distances()) {
+			auto choice = HBTK::QuadratureSelector::select(position, distance, 1e-6);
+			std::cout << "\tdistance " << distance << ": " << names[choice.remap] 
+				<< " with " << choice.num_points << " points" 
+				<< (choice.meets_tolerance ? "" : " (subdivide the element)") << "\n";
+		}
+	}
+}
+
 int main()
 {
 	std::cout << "Remap tests demo\n";
+	print_quadrature_selections();
 
 	plot_remaps_1([](double x) {return log(abs(x - 0.4)); });
 	plot_remaps_1([](double x) {return 1.0 / abs(x - 0.4); });
@@ -35,28 +35,27 @@ namespace HBTK {
 
 	class CartesianFiniteLine3D {
 	public:
-		CartesianFiniteLine3D();
-		CartesianFiniteLine3D(const CartesianPoint3D & start, const CartesianPoint3D & end);
-		CartesianFiniteLine3D(const CartesianPoint3D & start, const CartesianVector3D & direction);
-		CartesianFiniteLine3D(const CartesianVector3D & direction, const CartesianPoint3D & end);
-		~CartesianFiniteLine3D();
+		constexpr CartesianFiniteLine3D() noexcept;
+		constexpr CartesianFiniteLine3D(const CartesianPoint3D & start, const CartesianPoint3D & end) noexcept;
+		constexpr CartesianFiniteLine3D(const CartesianPoint3D & start, const CartesianVector3D & direction) noexcept;
+		constexpr CartesianFiniteLine3D(const CartesianVector3D & direction, const CartesianPoint3D & end) noexcept;
 
 		explicit operator CartesianLine3D() const;
 
 		// Get a point on the line. Position in 0, 1 -> start to end.
-		CartesianPoint3D operator()(double position) const;
-		CartesianPoint3D evaluate(double position) const;
+		constexpr CartesianPoint3D operator()(double position) const noexcept;
+		constexpr CartesianPoint3D evaluate(double position) const noexcept;
 
-		CartesianPoint3D & start();
-		const CartesianPoint3D & start() const;
-		CartesianPoint3D & end();
-		const CartesianPoint3D & end() const;
+		CartesianPoint3D & start() noexcept;
+		constexpr const CartesianPoint3D & start() const noexcept;
+		CartesianPoint3D & end() noexcept;
+		constexpr const CartesianPoint3D & end() const noexcept;
 		// Returns a vector of direction and length of the line:
-		CartesianVector3D vector() const;
-		CartesianPoint3D midpoint() const;
+		constexpr CartesianVector3D vector() const noexcept;
+		constexpr CartesianPoint3D midpoint() const noexcept;
 
 		// length of the line
-		double magnitude() const;
+		double magnitude() const noexcept;
 
 		// Distance between this line and a point.
 		double distance(const CartesianPoint3D & other) const;
@@ -67,8 +66,8 @@ namespace HBTK {
 		double intersection(const CartesianPoint3D & other) const;
 		double intersection(const CartesianFiniteLine3D & other) const;
 
-		bool operator==(const CartesianFiniteLine3D & other) const;
-		bool operator!=(const CartesianFiniteLine3D & other) const;
+		constexpr bool operator==(const CartesianFiniteLine3D & other) const noexcept;
+		constexpr bool operator!=(const CartesianFiniteLine3D & other) const noexcept;
 
 	protected:
 		CartesianPoint3D m_start;
@@ -77,35 +76,191 @@ namespace HBTK {
 
 	class CartesianFiniteLine2D {
 	public:
-		CartesianFiniteLine2D();
-		CartesianFiniteLine2D(const CartesianPoint2D & start, const CartesianPoint2D & end);
-		CartesianFiniteLine2D(const CartesianPoint2D & start, const CartesianVector2D & direction);
-		CartesianFiniteLine2D(const CartesianVector2D & direction, const CartesianPoint2D & end);
-		~CartesianFiniteLine2D();
+		constexpr CartesianFiniteLine2D() noexcept;
+		constexpr CartesianFiniteLine2D(const CartesianPoint2D & start, const CartesianPoint2D & end) noexcept;
+		constexpr CartesianFiniteLine2D(const CartesianPoint2D & start, const CartesianVector2D & direction) noexcept;
+		constexpr CartesianFiniteLine2D(const CartesianVector2D & direction, const CartesianPoint2D & end) noexcept;
 
 		explicit operator CartesianLine2D() const;
 
 		// Get a point on the line. Position in 0, 1 -> start to end.
-		CartesianPoint2D operator()(double position) const;
-		CartesianPoint2D evaluate(double position) const;
+		constexpr CartesianPoint2D operator()(double position) const noexcept;
+		constexpr CartesianPoint2D evaluate(double position) const noexcept;
 
-		CartesianPoint2D & start();
-		const CartesianPoint2D & start() const;
-		CartesianPoint2D & end();
-		const CartesianPoint2D & end() const;
+		CartesianPoint2D & start() noexcept;
+		constexpr const CartesianPoint2D & start() const noexcept;
+		CartesianPoint2D & end() noexcept;
+		constexpr const CartesianPoint2D & end() const noexcept;
 		// Returns a vector of direction and length of the line:
-		CartesianVector2D vector() const;
-		CartesianPoint2D midpoint() const;
+		constexpr CartesianVector2D vector() const noexcept;
+		constexpr CartesianPoint2D midpoint() const noexcept;
 
 		// length of the line
-		double magnitude() const;
+		double magnitude() const noexcept;
 
-		bool operator==(const CartesianFiniteLine2D & other) const;
-		bool operator!=(const CartesianFiniteLine2D & other) const;
+		constexpr bool operator==(const CartesianFiniteLine2D & other) const noexcept;
+		constexpr bool operator!=(const CartesianFiniteLine2D & other) const noexcept;
 
 	protected:
 		CartesianPoint2D m_start;
 		CartesianPoint2D m_end;
 	};
-}
 
+	constexpr CartesianFiniteLine3D::CartesianFiniteLine3D() noexcept
+		: m_start({ 0.0, 0.0, 0.0 }),
+		m_end({ 1.0, 0.0, 0.0 })
+	{
+	}
+
+	constexpr CartesianFiniteLine3D::CartesianFiniteLine3D(const CartesianPoint3D & start, const CartesianPoint3D & end) noexcept
+		: m_start(start),
+		m_end(end)
+	{
+	}
+
+	constexpr CartesianFiniteLine3D::CartesianFiniteLine3D(const CartesianPoint3D & start, const CartesianVector3D & direction) noexcept
+		: m_start(start),
+		m_end(start + direction)
+	{
+	}
+
+	constexpr CartesianFiniteLine3D::CartesianFiniteLine3D(const CartesianVector3D & direction, const CartesianPoint3D & end) noexcept
+		: m_start(end - direction),
+		m_end(end)
+	{
+	}
+
+	constexpr CartesianPoint3D CartesianFiniteLine3D::operator()(double position) const noexcept
+	{
+		return m_start + (m_end - m_start) * position;
+	}
+
+	constexpr CartesianPoint3D CartesianFiniteLine3D::evaluate(double position) const noexcept
+	{
+		return operator()(position);
+	}
+
+	inline CartesianPoint3D & CartesianFiniteLine3D::start() noexcept
+	{
+		return m_start;
+	}
+
+	constexpr const CartesianPoint3D & CartesianFiniteLine3D::start() const noexcept
+	{
+		return m_start;
+	}
+
+	inline CartesianPoint3D & CartesianFiniteLine3D::end() noexcept
+	{
+		return m_end;
+	}
+
+	constexpr const CartesianPoint3D & CartesianFiniteLine3D::end() const noexcept
+	{
+		return m_end;
+	}
+
+	constexpr CartesianVector3D CartesianFiniteLine3D::vector() const noexcept
+	{
+		return m_end - m_start;
+	}
+
+	constexpr CartesianPoint3D CartesianFiniteLine3D::midpoint() const noexcept
+	{
+		return start() + (end() - start()) * 0.5;
+	}
+
+	inline double CartesianFiniteLine3D::magnitude() const noexcept
+	{
+		return vector().magnitude();
+	}
+
+	constexpr bool CartesianFiniteLine3D::operator==(const CartesianFiniteLine3D & other) const noexcept
+	{
+		return (other.start() == m_start) && (other.end() == m_end);
+	}
+
+	constexpr bool CartesianFiniteLine3D::operator!=(const CartesianFiniteLine3D & other) const noexcept
+	{
+		return !operator==(other);
+	}
+
+	constexpr CartesianFiniteLine2D::CartesianFiniteLine2D() noexcept
+		: m_start({ 0.0, 0.0 }),
+		m_end({ 1.0, 0.0 })
+	{
+	}
+
+	constexpr CartesianFiniteLine2D::CartesianFiniteLine2D(const CartesianPoint2D & start, const CartesianPoint2D & end) noexcept
+		: m_start(start),
+		m_end(end)
+	{
+	}
+
+	constexpr CartesianFiniteLine2D::CartesianFiniteLine2D(const CartesianPoint2D & start, const CartesianVector2D & direction) noexcept
+		: m_start(start),
+		m_end(start + direction)
+	{
+	}
+
+	constexpr CartesianFiniteLine2D::CartesianFiniteLine2D(const CartesianVector2D & direction, const CartesianPoint2D & end) noexcept
+		: m_start(end - direction),
+		m_end(end)
+	{
+	}
+
+	constexpr CartesianPoint2D CartesianFiniteLine2D::operator()(double position) const noexcept
+	{
+		return m_start + (m_end - m_start) * position;
+	}
+
+	constexpr CartesianPoint2D CartesianFiniteLine2D::evaluate(double position) const noexcept
+	{
+		return operator()(position);
+	}
+
+	inline CartesianPoint2D & CartesianFiniteLine2D::start() noexcept
+	{
+		return m_start;
+	}
+
+	constexpr const CartesianPoint2D & CartesianFiniteLine2D::start() const noexcept
+	{
+		return m_start;
+	}
+
+	inline CartesianPoint2D & CartesianFiniteLine2D::end() noexcept
+	{
+		return m_end;
+	}
+
+	constexpr const CartesianPoint2D & CartesianFiniteLine2D::end() const noexcept
+	{
+		return m_end;
+	}
+
+	constexpr CartesianVector2D CartesianFiniteLine2D::vector() const noexcept
+	{
+		return m_end - m_start;
+	}
+
+	constexpr CartesianPoint2D CartesianFiniteLine2D::midpoint() const noexcept
+	{
+		return start() + (end() - start()) * 0.5;
+	}
+
+	inline double CartesianFiniteLine2D::magnitude() const noexcept
+	{
+		return vector().magnitude();
+	}
+
+	constexpr bool CartesianFiniteLine2D::operator==(const CartesianFiniteLine2D & other) const noexcept
+	{
+		return (other.start() == m_start) && (other.end() == m_end);
+	}
+
+	constexpr bool CartesianFiniteLine2D::operator!=(const CartesianFiniteLine2D & other) const noexcept
+	{
+		return !operator==(other);
+	}
+}
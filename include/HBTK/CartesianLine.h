@@ -31,24 +31,23 @@ SOFTWARE.
 namespace HBTK {
 	class CartesianLine3D {
 	public:
-		CartesianLine3D();
+		CartesianLine3D() = default;
 
 		// Initialise from the origin and a point on the line.
 		// Direction becomes point_on_line - origin
-		CartesianLine3D(const CartesianPoint3D & origin, const CartesianPoint3D & point_on_line);
+		constexpr CartesianLine3D(const CartesianPoint3D & origin, const CartesianPoint3D & point_on_line) noexcept;
 
 		// Inialise from origin and direction.
-		CartesianLine3D(const CartesianPoint3D & origin, const CartesianVector3D & direction);
-		~CartesianLine3D();
+		constexpr CartesianLine3D(const CartesianPoint3D & origin, const CartesianVector3D & direction) noexcept;
 
 		// Get a point on the line. position * direction from origin.
-		CartesianPoint3D operator()(double position) const;
-		CartesianPoint3D evaluate(double position) const;
+		constexpr CartesianPoint3D operator()(double position) const noexcept;
+		constexpr CartesianPoint3D evaluate(double position) const noexcept;
 
-		CartesianPoint3D & origin();
-		const CartesianPoint3D & origin() const;
-		CartesianVector3D & direction();
-		const CartesianVector3D & direction() const;
+		CartesianPoint3D & origin() noexcept;
+		constexpr const CartesianPoint3D & origin() const noexcept;
+		CartesianVector3D & direction() noexcept;
+		constexpr const CartesianVector3D & direction() const noexcept;
 		
 		// Distance between this line and a point.
 		double distance(const CartesianPoint3D & other) const;
@@ -59,8 +58,8 @@ namespace HBTK {
 		double intersection(const CartesianPoint3D & other) const;
 		double intersection(const CartesianLine3D & other) const;
 
-		bool operator==(const CartesianLine3D & other) const;
-		bool operator!=(const CartesianLine3D & other) const;
+		constexpr bool operator==(const CartesianLine3D & other) const noexcept;
+		constexpr bool operator!=(const CartesianLine3D & other) const noexcept;
 
 	protected:
 		CartesianPoint3D m_origin;
@@ -69,26 +68,134 @@ namespace HBTK {
 
 	class CartesianLine2D {
 	public:
-		CartesianLine2D();
-		CartesianLine2D(const CartesianPoint2D & origin, const CartesianPoint2D & point_on_line);
-		CartesianLine2D(const CartesianPoint2D & origin, const CartesianVector2D & direction);
-		~CartesianLine2D();
+		constexpr CartesianLine2D() noexcept;
+		constexpr CartesianLine2D(const CartesianPoint2D & origin, const CartesianPoint2D & point_on_line) noexcept;
+		constexpr CartesianLine2D(const CartesianPoint2D & origin, const CartesianVector2D & direction) noexcept;
 
 		// Get a point on the line. position * direction from origin.
-		CartesianPoint2D operator()(double position) const;
-		CartesianPoint2D evaluate(double position) const;
+		constexpr CartesianPoint2D operator()(double position) const noexcept;
+		constexpr CartesianPoint2D evaluate(double position) const noexcept;
 
-		CartesianPoint2D & origin();
-		const CartesianPoint2D & origin() const;
-		CartesianVector2D & direction();
-		const CartesianVector2D & direction() const;
+		CartesianPoint2D & origin() noexcept;
+		constexpr const CartesianPoint2D & origin() const noexcept;
+		CartesianVector2D & direction() noexcept;
+		constexpr const CartesianVector2D & direction() const noexcept;
 
-		bool operator==(const CartesianLine2D & other) const;
-		bool operator!=(const CartesianLine2D & other) const;
+		constexpr bool operator==(const CartesianLine2D & other) const noexcept;
+		constexpr bool operator!=(const CartesianLine2D & other) const noexcept;
 
 	protected:
 		CartesianPoint2D m_origin;
 		CartesianVector2D m_direction;
 	};
-}
 
+	constexpr CartesianLine3D::CartesianLine3D(const CartesianPoint3D & start, const CartesianPoint3D & end) noexcept
+		: m_origin(start),
+		m_direction(end - start)
+	{
+	}
+
+	constexpr CartesianLine3D::CartesianLine3D(const CartesianPoint3D & start, const CartesianVector3D & direction) noexcept
+		: m_origin(start),
+		m_direction(direction)
+	{
+	}
+
+	constexpr CartesianPoint3D CartesianLine3D::operator()(double position) const noexcept
+	{
+		return m_origin + m_direction * position;
+	}
+
+	constexpr CartesianPoint3D CartesianLine3D::evaluate(double position) const noexcept
+	{
+		return operator()(position);
+	}
+
+	inline CartesianPoint3D & CartesianLine3D::origin() noexcept
+	{
+		return m_origin;
+	}
+
+	constexpr const CartesianPoint3D & CartesianLine3D::origin() const noexcept
+	{
+		return m_origin;
+	}
+
+	inline CartesianVector3D & CartesianLine3D::direction() noexcept
+	{
+		return m_direction;
+	}
+
+	constexpr const CartesianVector3D & CartesianLine3D::direction() const noexcept
+	{
+		return m_direction;
+	}
+
+	constexpr bool CartesianLine3D::operator==(const CartesianLine3D & other) const noexcept
+	{
+		return (other.origin() == m_origin) && (other.direction() == m_direction);
+	}
+
+	constexpr bool CartesianLine3D::operator!=(const CartesianLine3D & other) const noexcept
+	{
+		return !operator==(other);
+	}
+
+	constexpr CartesianLine2D::CartesianLine2D() noexcept
+		: m_origin({ 0.0, 0.0 }),
+		m_direction({ 1.0, 0.0 })
+	{
+	}
+
+	constexpr CartesianLine2D::CartesianLine2D(const CartesianPoint2D & start, const CartesianPoint2D & end) noexcept
+		: m_origin(start),
+		m_direction(end - start)
+	{
+	}
+
+	constexpr CartesianLine2D::CartesianLine2D(const CartesianPoint2D & start, const CartesianVector2D & direction) noexcept
+		: m_origin(start),
+		m_direction(direction)
+	{
+	}
+
+	constexpr CartesianPoint2D CartesianLine2D::operator()(double position) const noexcept
+	{
+		return m_origin + m_direction * position;
+	}
+
+	constexpr CartesianPoint2D CartesianLine2D::evaluate(double position) const noexcept
+	{
+		return operator()(position);
+	}
+
+	inline CartesianPoint2D & CartesianLine2D::origin() noexcept
+	{
+		return m_origin;
+	}
+
+	constexpr const CartesianPoint2D & CartesianLine2D::origin() const noexcept
+	{
+		return m_origin;
+	}
+
+	inline CartesianVector2D & CartesianLine2D::direction() noexcept
+	{
+		return m_direction;
+	}
+
+	constexpr const CartesianVector2D & CartesianLine2D::direction() const noexcept
+	{
+		return m_direction;
+	}
+
+	constexpr bool CartesianLine2D::operator==(const CartesianLine2D & other) const noexcept
+	{
+		return (other.origin() == m_origin) && (other.direction() == m_direction);
+	}
+
+	constexpr bool CartesianLine2D::operator!=(const CartesianLine2D & other) const noexcept
+	{
+		return !operator==(other);
+	}
+}
@@ -32,31 +32,33 @@ namespace HBTK {
 	class CartesianVector3D;
 	class CartesianVector2D;
 
+	// Arithmetic is defined inline at the bottom of the file so that it can
+	// be inlined into tight loops without link time optimisation. The
+	// classes are trivially copyable.
 	class CartesianPoint3D {
 	public:
-		CartesianPoint3D();
-		CartesianPoint3D(const std::array<double, 3> & location);
-		~CartesianPoint3D();
-
-		double & x();
-		const double & x() const;
-		double & y();
-		const double & y() const;
-		double & z();
-		const double & z() const;
-		std::array<double, 3> & as_array();
-		const std::array<double, 3> & as_array() const;
-
-		CartesianVector3D operator-(const HBTK::CartesianPoint3D & other) const;
-		CartesianPoint3D operator+(const HBTK::CartesianVector3D & other) const;
-		CartesianPoint3D & operator+=(const HBTK::CartesianVector3D & other);
-		CartesianPoint3D operator-(const HBTK::CartesianVector3D & other) const;
-		CartesianPoint3D & operator-=(const HBTK::CartesianVector3D & other);
-
-		static CartesianPoint3D origin();
-
-		bool operator==(const CartesianPoint3D & other) const;
-		bool operator!=(const CartesianPoint3D & other) const;
+		CartesianPoint3D() = default;
+		constexpr CartesianPoint3D(const std::array<double, 3> & location) noexcept;
+
+		double & x() noexcept;
+		constexpr const double & x() const noexcept;
+		double & y() noexcept;
+		constexpr const double & y() const noexcept;
+		double & z() noexcept;
+		constexpr const double & z() const noexcept;
+		std::array<double, 3> & as_array() noexcept;
+		constexpr const std::array<double, 3> & as_array() const noexcept;
+
+		constexpr CartesianVector3D operator-(const HBTK::CartesianPoint3D & other) const noexcept;
+		constexpr CartesianPoint3D operator+(const HBTK::CartesianVector3D & other) const noexcept;
+		CartesianPoint3D & operator+=(const HBTK::CartesianVector3D & other) noexcept;
+		constexpr CartesianPoint3D operator-(const HBTK::CartesianVector3D & other) const noexcept;
+		CartesianPoint3D & operator-=(const HBTK::CartesianVector3D & other) noexcept;
+
+		static constexpr CartesianPoint3D origin() noexcept;
+
+		constexpr bool operator==(const CartesianPoint3D & other) const noexcept;
+		constexpr bool operator!=(const CartesianPoint3D & other) const noexcept;
 
 		double distance(const CartesianPlane & plane) const;
 
@@ -64,40 +66,225 @@ namespace HBTK {
 		std::array<double, 3> m_coord;
 	};
 
-
 	class CartesianPoint2D {
 	public:
-		CartesianPoint2D();
-		CartesianPoint2D(const std::array<double, 2> & location);
-		~CartesianPoint2D();
+		CartesianPoint2D() = default;
+		constexpr CartesianPoint2D(const std::array<double, 2> & location) noexcept;
 
 		// Rotate about the origin anticlockwise angle in radians.
 		void rotate(double angle);
 		// Rotate about another point anticlockwise some angle in rads.
 		void rotate(double angle, CartesianPoint2D other);
 
-		double & x();
-		const double & x() const;
-		double & y();
-		const double & y() const;
-		std::array<double, 2> & as_array();
-		const std::array<double, 2> & as_array() const;
+		double & x() noexcept;
+		constexpr const double & x() const noexcept;
+		double & y() noexcept;
+		constexpr const double & y() const noexcept;
+		std::array<double, 2> & as_array() noexcept;
+		constexpr const std::array<double, 2> & as_array() const noexcept;
 
-		CartesianVector2D operator-(const HBTK::CartesianPoint2D & other) const;
-		CartesianPoint2D operator+(const HBTK::CartesianVector2D & other) const;
-		CartesianPoint2D operator+=(const HBTK::CartesianVector2D & other);
-		CartesianPoint2D operator-(const HBTK::CartesianVector2D & other) const;
-		CartesianPoint2D operator-=(const HBTK::CartesianVector2D & other);
+		constexpr CartesianVector2D operator-(const HBTK::CartesianPoint2D & other) const noexcept;
+		constexpr CartesianPoint2D operator+(const HBTK::CartesianVector2D & other) const noexcept;
+		CartesianPoint2D operator+=(const HBTK::CartesianVector2D & other) noexcept;
+		constexpr CartesianPoint2D operator-(const HBTK::CartesianVector2D & other) const noexcept;
+		CartesianPoint2D operator-=(const HBTK::CartesianVector2D & other) noexcept;
 
-		static CartesianPoint2D origin();
+		static constexpr CartesianPoint2D origin() noexcept;
 
-		bool operator==(const CartesianPoint2D & other) const;
-		bool operator!=(const CartesianPoint2D & other) const;
+		constexpr bool operator==(const CartesianPoint2D & other) const noexcept;
+		constexpr bool operator!=(const CartesianPoint2D & other) const noexcept;
 
 	private:
 		std::array<double, 2> m_coord;
 	};
 }
 
+// The inline definitions need both points and vectors to be complete.
+#include "CartesianVector.h"
+
+namespace HBTK {
+	constexpr CartesianPoint3D::CartesianPoint3D(const std::array<double, 3> & location) noexcept
+		: m_coord(location)
+	{
+	}
+
+	inline double & CartesianPoint3D::x() noexcept
+	{
+		return m_coord[0];
+	}
+
+	constexpr const double & CartesianPoint3D::x() const noexcept
+	{
+		return m_coord[0];
+	}
+
+	inline double & CartesianPoint3D::y() noexcept
+	{
+		return m_coord[1];
+	}
+
+	constexpr const double & CartesianPoint3D::y() const noexcept
+	{
+		return m_coord[1];
+	}
+
+	inline double & CartesianPoint3D::z() noexcept
+	{
+		return m_coord[2];
+	}
+
+	constexpr const double & CartesianPoint3D::z() const noexcept
+	{
+		return m_coord[2];
+	}
+
+	inline std::array<double, 3>& CartesianPoint3D::as_array() noexcept
+	{
+		return m_coord;
+	}
+
+	constexpr const std::array<double, 3>& CartesianPoint3D::as_array() const noexcept
+	{
+		return m_coord;
+	}
+
+	constexpr CartesianPoint3D CartesianPoint3D::operator+(const CartesianVector3D & other) const noexcept
+	{
+		return CartesianPoint3D({
+			x() + other.x(),
+			y() + other.y(),
+			z() + other.z() });
+	}
+
+	inline CartesianPoint3D & CartesianPoint3D::operator+=(const CartesianVector3D & other) noexcept
+	{
+		x() += other.x();
+		y() += other.y();
+		z() += other.z();
+		return *this;
+	}
+
+	constexpr CartesianPoint3D CartesianPoint3D::operator-(const CartesianVector3D & other) const noexcept
+	{
+		return CartesianPoint3D({
+			x() - other.x(),
+			y() - other.y(),
+			z() - other.z() });
+	}
+
+	inline CartesianPoint3D & CartesianPoint3D::operator-=(const CartesianVector3D & other) noexcept
+	{
+		x() -= other.x();
+		y() -= other.y();
+		z() -= other.z();
+		return *this;
+	}
 
+	constexpr CartesianVector3D CartesianPoint3D::operator-(const CartesianPoint3D & other) const noexcept
+	{
+		return CartesianVector3D({
+			x() - other.x(),
+			y() - other.y(),
+			z() - other.z() });
+	}
 
+	constexpr CartesianPoint3D CartesianPoint3D::origin() noexcept
+	{
+		return CartesianPoint3D({ 0, 0, 0 });
+	}
+
+	constexpr bool CartesianPoint3D::operator==(const CartesianPoint3D & other) const noexcept
+	{
+		return (x() == other.x()) && (y() == other.y()) && (z() == other.z());
+	}
+
+	constexpr bool CartesianPoint3D::operator!=(const CartesianPoint3D & other) const noexcept
+	{
+		return !operator==(other);
+	}
+
+	constexpr CartesianPoint2D::CartesianPoint2D(const std::array<double, 2> & location) noexcept
+		: m_coord(location)
+	{
+	}
+
+	inline double & CartesianPoint2D::x() noexcept
+	{
+		return m_coord[0];
+	}
+
+	constexpr const double & CartesianPoint2D::x() const noexcept
+	{
+		return m_coord[0];
+	}
+
+	inline double & CartesianPoint2D::y() noexcept
+	{
+		return m_coord[1];
+	}
+
+	constexpr const double & CartesianPoint2D::y() const noexcept
+	{
+		return m_coord[1];
+	}
+
+	inline std::array<double, 2>& CartesianPoint2D::as_array() noexcept
+	{
+		return m_coord;
+	}
+
+	constexpr const std::array<double, 2>& CartesianPoint2D::as_array() const noexcept
+	{
+		return m_coord;
+	}
+
+	constexpr CartesianPoint2D CartesianPoint2D::operator+(const CartesianVector2D & other) const noexcept
+	{
+		return CartesianPoint2D({
+			x() + other.x(),
+			y() + other.y() });
+	}
+
+	inline CartesianPoint2D CartesianPoint2D::operator+=(const CartesianVector2D & other) noexcept
+	{
+		x() += other.x();
+		y() += other.y();
+		return *this;
+	}
+
+	constexpr CartesianPoint2D CartesianPoint2D::operator-(const CartesianVector2D & other) const noexcept
+	{
+		return CartesianPoint2D({
+			x() - other.x(),
+			y() - other.y() });
+	}
+
+	inline CartesianPoint2D CartesianPoint2D::operator-=(const CartesianVector2D & other) noexcept
+	{
+		x() -= other.x();
+		y() -= other.y();
+		return *this;
+	}
+
+	constexpr CartesianVector2D CartesianPoint2D::operator-(const CartesianPoint2D & other) const noexcept
+	{
+		return CartesianVector2D({
+			x() - other.x(),
+			y() - other.y() });
+	}
+
+	constexpr CartesianPoint2D CartesianPoint2D::origin() noexcept
+	{
+		return CartesianPoint2D({ 0, 0 });
+	}
+
+	constexpr bool CartesianPoint2D::operator==(const CartesianPoint2D & other) const noexcept
+	{
+		return (x() == other.x()) && (y() == other.y());
+	}
+
+	constexpr bool CartesianPoint2D::operator!=(const CartesianPoint2D & other) const noexcept
+	{
+		return !operator==(other);
+	}
+}
@@ -0,0 +1,154 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+CartesianPointCloud.h
+
+Structure-of-arrays collections of points and vectors in Cartesian space.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <utility>
+#include <vector>
+
+#include "CartesianPoint.h"
+#include "CartesianVector.h"
+
+namespace HBTK {
+	class VectorField3D;
+
+	// Many points stored as separate x, y and z arrays. Bulk operations
+	// are simple loops over contiguous arrays that the compiler can 
+	// vectorise, unlike operations on a std::vector<CartesianPoint3D>.
+	//
+	// \code
+	// HBTK::PointCloud3D cloud(my_points);	// std::vector<CartesianPoint3D>
+	// cloud.translate(HBTK::CartesianVector3D({ 1, 0, 0 }));
+	// std::vector<double> r = cloud.distance(HBTK::CartesianPoint3D::origin());
+	// \endcode
+	class PointCloud3D {
+	public:
+		PointCloud3D();
+		// num_points points at the origin.
+		PointCloud3D(int num_points);
+		PointCloud3D(const std::vector<CartesianPoint3D> & points);
+		~PointCloud3D();
+
+		int size() const;
+		void resize(int num_points);
+		void reserve(int num_points);
+		void push_back(const CartesianPoint3D & point);
+
+		// Copy a point out of / into the cloud.
+		CartesianPoint3D operator[](int index) const;
+		void set(int index, const CartesianPoint3D & point);
+		// Convert to the array-of-structures representation.
+		std::vector<CartesianPoint3D> as_points() const;
+
+		// The coordinate arrays.
+		std::vector<double> & x();
+		const std::vector<double> & x() const;
+		std::vector<double> & y();
+		const std::vector<double> & y() const;
+		std::vector<double> & z();
+		const std::vector<double> & z() const;
+
+		// Move every point by delta.
+		void translate(const CartesianVector3D & delta);
+		// Rotate every point about an axis through centre by angle radians,
+		// anticlockwise looking down the axis towards centre (right hand rule).
+		void rotate(const CartesianVector3D & axis, double angle,
+			const CartesianPoint3D & centre = CartesianPoint3D::origin());
+		// Distance of every point from point.
+		std::vector<double> distance(const CartesianPoint3D & point) const;
+		// Vectors from point to every point in the cloud.
+		VectorField3D operator-(const CartesianPoint3D & point) const;
+		// Vectors from the points of other to the points of this.
+		VectorField3D operator-(const PointCloud3D & other) const;
+		// The corners with the smallest and largest coordinates. 
+		// The cloud must not be empty.
+		std::pair<CartesianPoint3D, CartesianPoint3D> bounding_box() const;
+
+		bool operator==(const PointCloud3D & other) const;
+		bool operator!=(const PointCloud3D & other) const;
+
+	private:
+		std::vector<double> m_x, m_y, m_z;
+	};
+
+	// Many vectors stored as separate x, y and z arrays. See PointCloud3D.
+	class VectorField3D {
+	public:
+		VectorField3D();
+		// num_vectors zero vectors.
+		VectorField3D(int num_vectors);
+		VectorField3D(const std::vector<CartesianVector3D> & vectors);
+		~VectorField3D();
+
+		int size() const;
+		void resize(int num_vectors);
+		void reserve(int num_vectors);
+		void push_back(const CartesianVector3D & vector);
+
+		CartesianVector3D operator[](int index) const;
+		void set(int index, const CartesianVector3D & vector);
+		std::vector<CartesianVector3D> as_vectors() const;
+
+		std::vector<double> & x();
+		const std::vector<double> & x() const;
+		std::vector<double> & y();
+		const std::vector<double> & y() const;
+		std::vector<double> & z();
+		const std::vector<double> & z() const;
+
+		// Element-wise arithmetic. Fields must be the same size.
+		VectorField3D operator+(const VectorField3D & other) const;
+		VectorField3D & operator+=(const VectorField3D & other);
+		VectorField3D operator-(const VectorField3D & other) const;
+		VectorField3D & operator-=(const VectorField3D & other);
+		VectorField3D operator*(double multiplier) const;
+		VectorField3D & operator*=(double multiplier);
+		// Multiply each vector by its own factor. factors.size() == size().
+		VectorField3D & scale(const std::vector<double> & factors);
+
+		// Lengths of every vector.
+		std::vector<double> magnitude() const;
+		// Set every vector's length to 1.
+		void normalise();
+		// Element-wise dot product.
+		std::vector<double> dot(const VectorField3D & other) const;
+		// Dot product of every vector with other.
+		std::vector<double> dot(const CartesianVector3D & other) const;
+		// Element-wise cross product, this x other.
+		VectorField3D cross(const VectorField3D & other) const;
+		// Cross product of every vector with other, this x other.
+		VectorField3D cross(const CartesianVector3D & other) const;
+		// Rotate every vector about axis by angle radians (right hand rule).
+		void rotate(const CartesianVector3D & axis, double angle);
+		// Sum of all the vectors.
+		CartesianVector3D sum() const;
+
+		bool operator==(const VectorField3D & other) const;
+		bool operator!=(const VectorField3D & other) const;
+
+	private:
+		std::vector<double> m_x, m_y, m_z;
+	};
+}
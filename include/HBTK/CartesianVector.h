@@ -26,114 +26,442 @@ SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
 #include <array>
+#include <cmath>
 
 namespace HBTK {
 	class CartesianPoint3D;	// Include CartesianPoint.h
 	class CartesianPoint2D;	// Include CartesianPoint.h
 
+	// Arithmetic is defined inline at the bottom of the file. See 
+	// CartesianPoint.h.
 	class CartesianVector3D {
 	public:
-		CartesianVector3D();
-		CartesianVector3D(const std::array<double, 3> vector);
-		~CartesianVector3D();
-
-		CartesianVector3D operator+(const CartesianVector3D & other) const;
-		CartesianVector3D & operator+=(const CartesianVector3D & other);
-		CartesianVector3D operator-(const CartesianVector3D & other) const;
-		CartesianVector3D operator-() const;
-		CartesianVector3D & operator-=(const CartesianVector3D & other);
-		CartesianPoint3D operator+(const CartesianPoint3D & other) const;
-		CartesianVector3D operator*(const double & multiplyer) const;
-		CartesianVector3D & operator*=(const double & multiplyer);
-		CartesianVector3D operator/(const double & divisor) const;
-		CartesianVector3D & operator/=(const double & divisor);
+		CartesianVector3D() = default;
+		constexpr CartesianVector3D(const std::array<double, 3> vector) noexcept;
+
+		constexpr CartesianVector3D operator+(const CartesianVector3D & other) const noexcept;
+		CartesianVector3D & operator+=(const CartesianVector3D & other) noexcept;
+		constexpr CartesianVector3D operator-(const CartesianVector3D & other) const noexcept;
+		constexpr CartesianVector3D operator-() const noexcept;
+		CartesianVector3D & operator-=(const CartesianVector3D & other) noexcept;
+		constexpr CartesianPoint3D operator+(const CartesianPoint3D & other) const noexcept;
+		constexpr CartesianVector3D operator*(const double & multiplyer) const noexcept;
+		CartesianVector3D & operator*=(const double & multiplyer) noexcept;
+		constexpr CartesianVector3D operator/(const double & divisor) const noexcept;
+		CartesianVector3D & operator/=(const double & divisor) noexcept;
 
 		// Returns the length of the vector. Same as: abs(this)
-		double magnitude() const;
+		double magnitude() const noexcept;
 		// Set vector length to 1.
-		void normalise();
+		void normalise() noexcept;
 		// Dot product between to vectors.
-		double dot(const CartesianVector3D & other) const;
+		constexpr double dot(const CartesianVector3D & other) const noexcept;
 		// Cross product of two vectors
-		CartesianVector3D cross(const CartesianVector3D & other) const;
+		constexpr CartesianVector3D cross(const CartesianVector3D & other) const noexcept;
 		// The cos of the angle between two vectors.
 		double cos_angle(const CartesianVector3D & other) const;
 		// The angle between two vectors in radians.
 		double angle(const CartesianVector3D & other) const;
 
+		double & x() noexcept;
+		constexpr const double & x() const noexcept;
+		double & y() noexcept;
+		constexpr const double & y() const noexcept;
+		double & z() noexcept;
+		constexpr const double & z() const noexcept;
+		std::array<double, 3> & as_array() noexcept;
+		constexpr const std::array<double, 3> & as_array() const noexcept;
+		constexpr operator std::array<double, 3>() const noexcept;
 
-		double & x();
-		const double & x() const;
-		double & y();
-		const double & y() const;
-		double & z();
-		const double & z() const;
-		std::array<double, 3> & as_array();
-		const std::array<double, 3> & as_array() const;
-
-		operator std::array<double, 3>() const;
+		constexpr bool operator==(const CartesianVector3D & other) const noexcept;
+		constexpr bool operator!=(const CartesianVector3D & other) const noexcept;
 
-		bool operator==(const CartesianVector3D & other) const;
-		bool operator!=(const CartesianVector3D & other) const;
 	private:
 		std::array<double, 3> m_coord;
 	};
 
-	double abs(const CartesianVector3D & vector);
-	CartesianVector3D operator*(const double lhs, const CartesianVector3D & rhs);
+	double abs(const CartesianVector3D & vector) noexcept;
+	constexpr CartesianVector3D operator*(const double lhs, const CartesianVector3D & rhs) noexcept;
 
 	class CartesianVector2D {
 	public:
-		CartesianVector2D();
-		CartesianVector2D(const std::array<double, 2> & vector);
-		~CartesianVector2D();
-
-		CartesianVector2D operator+(const CartesianVector2D & other) const;
-		CartesianVector2D& operator+=(const CartesianVector2D & other);
-		CartesianVector2D operator-(const CartesianVector2D & other) const;
-		CartesianVector2D operator-() const;
-		CartesianVector2D& operator-=(const CartesianVector2D & other);
-		CartesianPoint2D operator+(const CartesianPoint2D & other) const;
-		CartesianVector2D operator*(const double & multiplyer) const;
-		CartesianVector2D& operator*=(const double & multiplyer);
-		CartesianVector2D operator/(const double & divisor)const ;
-		CartesianVector2D& operator/=(const double & divisor);
+		CartesianVector2D() = default;
+		constexpr CartesianVector2D(const std::array<double, 2> & vector) noexcept;
+
+		constexpr CartesianVector2D operator+(const CartesianVector2D & other) const noexcept;
+		CartesianVector2D& operator+=(const CartesianVector2D & other) noexcept;
+		constexpr CartesianVector2D operator-(const CartesianVector2D & other) const noexcept;
+		constexpr CartesianVector2D operator-() const noexcept;
+		CartesianVector2D& operator-=(const CartesianVector2D & other) noexcept;
+		constexpr CartesianPoint2D operator+(const CartesianPoint2D & other) const noexcept;
+		constexpr CartesianVector2D operator*(const double & multiplyer) const noexcept;
+		CartesianVector2D& operator*=(const double & multiplyer) noexcept;
+		constexpr CartesianVector2D operator/(const double & divisor) const noexcept;
+		CartesianVector2D& operator/=(const double & divisor) noexcept;
 
 		// Set vector length to 1.
-		void normalise();
+		void normalise() noexcept;
 		// Rotate clockwise by angle (Radians) - mutating.
 		CartesianVector2D & rotate(double angle);
 		// Get a vector that is this one rotated clockwise.
 		CartesianVector2D rotated(double angle) const;
 
 		// Returns the length of the vector. Same as: abs(this)
-		double magnitude() const;
+		double magnitude() const noexcept;
 		// Dot product between to vectors.
-		double dot(const CartesianVector2D & other) const;
+		constexpr double dot(const CartesianVector2D & other) const noexcept;
 		// Cross product of.. well, its just a single vector.
-		CartesianVector2D cross() const;
+		constexpr CartesianVector2D cross() const noexcept;
 		// The cos of the angle between two vectors.
 		double cos_angle(const CartesianVector2D & other) const;
 		// The angle between two vectors in radians.
 		double angle(const CartesianVector2D & other) const;
 
-		double & x();
-		const double & x() const;
-		double & y();
-		const double & y() const;
-		std::array<double, 2> & as_array();
-		const std::array<double, 2> & as_array() const;
-
-		operator std::array<double, 2>() const;
+		double & x() noexcept;
+		constexpr const double & x() const noexcept;
+		double & y() noexcept;
+		constexpr const double & y() const noexcept;
+		std::array<double, 2> & as_array() noexcept;
+		constexpr const std::array<double, 2> & as_array() const noexcept;
+		constexpr operator std::array<double, 2>() const noexcept;
 
-		bool operator==(const CartesianVector2D & other) const;
-		bool operator!=(const CartesianVector2D & other) const;
+		constexpr bool operator==(const CartesianVector2D & other) const noexcept;
+		constexpr bool operator!=(const CartesianVector2D & other) const noexcept;
 
 	private:
 		std::array<double, 2> m_coord;
 	};
 
-	double abs(const CartesianVector2D & vector);
-	CartesianVector2D operator*(const double lhs, const CartesianVector2D & rhs);
-
+	double abs(const CartesianVector2D & vector) noexcept;
+	constexpr CartesianVector2D operator*(const double lhs, const CartesianVector2D & rhs) noexcept;
 } // End namespace HBTK
+
+// The inline definitions need both points and vectors to be complete.
+#include "CartesianPoint.h"
+
+namespace HBTK {
+	constexpr CartesianVector3D::CartesianVector3D(const std::array<double, 3> vector) noexcept
+		: m_coord(vector)
+	{
+	}
+
+	constexpr CartesianVector3D CartesianVector3D::operator+(const CartesianVector3D & other) const noexcept
+	{
+		return CartesianVector3D({
+			x() + other.x(),
+			y() + other.y(),
+			z() + other.z() });
+	}
+
+	inline CartesianVector3D & CartesianVector3D::operator+=(const CartesianVector3D & other) noexcept
+	{
+		x() += other.x();
+		y() += other.y();
+		z() += other.z();
+		return *this;
+	}
+
+	constexpr CartesianVector3D CartesianVector3D::operator-(const CartesianVector3D & other) const noexcept
+	{
+		return CartesianVector3D({
+			x() - other.x(),
+			y() - other.y(),
+			z() - other.z() });
+	}
+
+	constexpr CartesianVector3D CartesianVector3D::operator-() const noexcept
+	{
+		return CartesianVector3D({ -x(), -y(), -z() });
+	}
+
+	inline CartesianVector3D & CartesianVector3D::operator-=(const CartesianVector3D & other) noexcept
+	{
+		x() -= other.x();
+		y() -= other.y();
+		z() -= other.z();
+		return *this;
+	}
+
+	constexpr CartesianPoint3D CartesianVector3D::operator+(const CartesianPoint3D & other) const noexcept
+	{
+		return CartesianPoint3D({
+			x() + other.x(),
+			y() + other.y(),
+			z() + other.z() });
+	}
+
+	constexpr CartesianVector3D CartesianVector3D::operator*(const double & multiplyer) const noexcept
+	{
+		return CartesianVector3D({
+			x() * multiplyer,
+			y() * multiplyer,
+			z() * multiplyer });
+	}
+
+	inline CartesianVector3D & CartesianVector3D::operator*=(const double & multiplyer) noexcept
+	{
+		x() *= multiplyer;
+		y() *= multiplyer;
+		z() *= multiplyer;
+		return *this;
+	}
+
+	constexpr CartesianVector3D CartesianVector3D::operator/(const double & divisor) const noexcept
+	{
+		return CartesianVector3D({
+			x() / divisor,
+			y() / divisor,
+			z() / divisor });
+	}
+
+	inline CartesianVector3D & CartesianVector3D::operator/=(const double & divisor) noexcept
+	{
+		x() /= divisor;
+		y() /= divisor;
+		z() /= divisor;
+		return *this;
+	}
+
+	inline double CartesianVector3D::magnitude() const noexcept
+	{
+		return std::sqrt(dot(*this));
+	}
+
+	inline void CartesianVector3D::normalise() noexcept
+	{
+		double len = magnitude();
+		x() /= len;
+		y() /= len;
+		z() /= len;
+		return;
+	}
+
+	constexpr double CartesianVector3D::dot(const CartesianVector3D & other) const noexcept
+	{
+		return x() * other.x() + y() * other.y() + z() * other.z();
+	}
+
+	constexpr CartesianVector3D CartesianVector3D::cross(const CartesianVector3D & other) const noexcept
+	{
+		return CartesianVector3D({
+			y() * other.z() - z() * other.y(),
+			z() * other.x() - x() * other.z(),
+			x() * other.y() - y() * other.x() });
+	}
+
+	inline double & CartesianVector3D::x() noexcept
+	{
+		return m_coord[0];
+	}
+
+	constexpr const double & CartesianVector3D::x() const noexcept
+	{
+		return m_coord[0];
+	}
+
+	inline double & CartesianVector3D::y() noexcept
+	{
+		return m_coord[1];
+	}
+
+	constexpr const double & CartesianVector3D::y() const noexcept
+	{
+		return m_coord[1];
+	}
+
+	inline double & CartesianVector3D::z() noexcept
+	{
+		return m_coord[2];
+	}
+
+	constexpr const double & CartesianVector3D::z() const noexcept
+	{
+		return m_coord[2];
+	}
+
+	inline std::array<double, 3>& CartesianVector3D::as_array() noexcept
+	{
+		return m_coord;
+	}
+
+	constexpr const std::array<double, 3>& CartesianVector3D::as_array() const noexcept
+	{
+		return m_coord;
+	}
+
+	constexpr CartesianVector3D::operator std::array<double, 3>() const noexcept
+	{
+		return m_coord;
+	}
+
+	constexpr bool CartesianVector3D::operator==(const CartesianVector3D & other) const noexcept
+	{
+		return (x() == other.x()) && (y() == other.y()) && (z() == other.z());
+	}
+
+	constexpr bool CartesianVector3D::operator!=(const CartesianVector3D & other) const noexcept
+	{
+		return !operator==(other);
+	}
+
+	inline double abs(const CartesianVector3D & vector) noexcept
+	{
+		return vector.magnitude();
+	}
+
+	constexpr CartesianVector3D operator*(const double lhs, const CartesianVector3D & rhs) noexcept
+	{
+		return rhs * lhs;
+	}
+
+	constexpr CartesianVector2D::CartesianVector2D(const std::array<double, 2> & vector) noexcept
+		: m_coord(vector)
+	{
+	}
+
+	constexpr CartesianVector2D CartesianVector2D::operator+(const CartesianVector2D & other) const noexcept
+	{
+		return CartesianVector2D({
+			x() + other.x(),
+			y() + other.y() });
+	}
+
+	inline CartesianVector2D & CartesianVector2D::operator+=(const CartesianVector2D & other) noexcept
+	{
+		x() += other.x();
+		y() += other.y();
+		return *this;
+	}
+
+	constexpr CartesianVector2D CartesianVector2D::operator-(const CartesianVector2D & other) const noexcept
+	{
+		return CartesianVector2D({
+			x() - other.x(),
+			y() - other.y() });
+	}
+
+	constexpr CartesianVector2D CartesianVector2D::operator-() const noexcept
+	{
+		return CartesianVector2D({ -x(), -y() });
+	}
+
+	inline CartesianVector2D & CartesianVector2D::operator-=(const CartesianVector2D & other) noexcept
+	{
+		x() -= other.x();
+		y() -= other.y();
+		return *this;
+	}
+
+	constexpr CartesianPoint2D CartesianVector2D::operator+(const CartesianPoint2D & other) const noexcept
+	{
+		return CartesianPoint2D({
+			x() + other.x(),
+			y() + other.y() });
+	}
+
+	constexpr CartesianVector2D CartesianVector2D::operator*(const double & multiplyer) const noexcept
+	{
+		return CartesianVector2D({
+			x() * multiplyer,
+			y() * multiplyer });
+	}
+
+	inline CartesianVector2D & CartesianVector2D::operator*=(const double & multiplyer) noexcept
+	{
+		x() *= multiplyer;
+		y() *= multiplyer;
+		return *this;
+	}
+
+	constexpr CartesianVector2D CartesianVector2D::operator/(const double & divisor) const noexcept
+	{
+		return CartesianVector2D({
+			x() / divisor,
+			y() / divisor });
+	}
+
+	inline CartesianVector2D & CartesianVector2D::operator/=(const double & divisor) noexcept
+	{
+		x() /= divisor;
+		y() /= divisor;
+		return *this;
+	}
+
+	inline double CartesianVector2D::magnitude() const noexcept
+	{
+		return std::sqrt(dot(*this));
+	}
+
+	inline void CartesianVector2D::normalise() noexcept
+	{
+		double len = magnitude();
+		x() /= len;
+		y() /= len;
+		return;
+	}
+
+	constexpr double CartesianVector2D::dot(const CartesianVector2D & other) const noexcept
+	{
+		return x() * other.x() + y() * other.y();
+	}
+
+	constexpr CartesianVector2D CartesianVector2D::cross() const noexcept
+	{
+		return CartesianVector2D({ y(), -x() });
+	}
+
+	inline double & CartesianVector2D::x() noexcept
+	{
+		return m_coord[0];
+	}
+
+	constexpr const double & CartesianVector2D::x() const noexcept
+	{
+		return m_coord[0];
+	}
+
+	inline double & CartesianVector2D::y() noexcept
+	{
+		return m_coord[1];
+	}
+
+	constexpr const double & CartesianVector2D::y() const noexcept
+	{
+		return m_coord[1];
+	}
+
+	inline std::array<double, 2>& CartesianVector2D::as_array() noexcept
+	{
+		return m_coord;
+	}
+
+	constexpr const std::array<double, 2>& CartesianVector2D::as_array() const noexcept
+	{
+		return m_coord;
+	}
+
+	constexpr CartesianVector2D::operator std::array<double, 2>() const noexcept
+	{
+		return m_coord;
+	}
+
+	constexpr bool CartesianVector2D::operator==(const CartesianVector2D & other) const noexcept
+	{
+		return (x() == other.x()) && (y() == other.y());
+	}
+
+	constexpr bool CartesianVector2D::operator!=(const CartesianVector2D & other) const noexcept
+	{
+		return !operator==(other);
+	}
+
+	inline double abs(const CartesianVector2D & vector) noexcept
+	{
+		return vector.magnitude();
+	}
+
+	constexpr CartesianVector2D operator*(const double lhs, const CartesianVector2D & rhs) noexcept
+	{
+		return rhs * lhs;
+	}
+}
@@ -25,8 +25,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
 #include <vector>
-#include <mutex>
 
 namespace HBTK {
 	class CubicSpline1D {
@@ -48,26 +48,72 @@ namespace HBTK {
 			std::vector<double> point_values);
 		// Copy constructor
 		CubicSpline1D(const CubicSpline1D & other);
+		// Move constructor
+		CubicSpline1D(CubicSpline1D && other);
 
 		~CubicSpline1D();
 
 		// Evaluate the spline.
-		double operator()(double location);
-		double evaluate(double location);
+		double operator()(double location) const;
+		double evaluate(double location) const;
 
 		// first derivative of the spline:
-		double derivative(double location);
+		double derivative(double location) const;
 		// second derivative of the spline
-		double derivative2(double location);
+		double derivative2(double location) const;
 		// third derivative of the spline
-		double derivative3(double location);
+		double derivative3(double location) const;
 		// nth derivative
-		double derivative(double location, int n);
-
-		double lower_input_bound();
-		double upper_input_bound();
-
-		CubicSpline1D& operator=(CubicSpline1D& spline);
+		double derivative(double location, int n) const;
+
+		// Evaluate the spline at many locations at once. Locations given in
+		// ascending order reuse the previous bracket rather than bisecting
+		// from scratch for each point.
+		std::vector<double> evaluate(const std::vector<double> & locations) const;
+		// As above, but also computes the first, second and third derivatives.
+		// Output vectors are resized to match locations.
+		void evaluate(const std::vector<double> & locations,
+			std::vector<double> & values,
+			std::vector<double> & derivatives,
+			std::vector<double> & derivatives2,
+			std::vector<double> & derivatives3) const;
+
+		// Precompute the polynomial coefficients of each interval. Subsequent
+		// evaluation uses these rather than the second derivatives, avoiding
+		// divisions, and locates intervals on a uniform grid with a single
+		// multiply. Results may differ from the uncompiled form by rounding.
+		// Call before sharing the spline between threads: evaluation of a
+		// compiled spline takes no locks. Throws std::domain_error if the
+		// spline has fewer than 2 points.
+		void compile();
+		bool is_compiled() const;
+
+		double lower_input_bound() const;
+		double upper_input_bound() const;
+
+		// The knots of the spline.
+		const std::vector<double> & point_locations() const;
+		// For each interval klo, c0 to c3 of y = c0 + c1 t + c2 t^2 + c3 t^3
+		// where t = x - x_klo. Returned as {c0_0, c1_0, c2_0, c3_0, c0_1 ...}.
+		std::vector<double> polynomial_coefficients() const;
+
+		CubicSpline1D& operator=(const CubicSpline1D& spline);
+		CubicSpline1D& operator=(CubicSpline1D&& spline);
+
+		// Construct many splines with natural boundary conditions at both
+		// ends. Every spline must have the same number of points. The spline
+		// systems are solved together, interleaved so that the solver 
+		// vectorises across splines, and optionally split over num_threads.
+		// The returned splines are ready to evaluate without further setup.
+		static std::vector<CubicSpline1D> construct_many(
+			const std::vector<std::vector<double>> & point_locations,
+			const std::vector<std::vector<double>> & point_values,
+			int num_threads = 1);
+		// As above, with all splines sharing the same point locations.
+		static std::vector<CubicSpline1D> construct_many(
+			const std::vector<double> & point_locations,
+			const std::vector<std::vector<double>> & point_values,
+			int num_threads = 1);
 	private:
 
 		// The reference inputs x to interpolate y = f(x);
@@ -75,25 +121,58 @@ namespace HBTK {
 		// The reference outputs y of for interpolation y = f(x);
 		std::vector<double> m_point_values;
 		// The second derivatives needed to construct a cubic
-		// spline.
-		std::vector<double> m_second_derivatives;
-
-		// Mutex: the second derivatives should not be computed at construction, but only 
-		// when the spline is first evaluated. In a multihreaded enviroment, this causes
-		// issues. 
-		std::mutex m_deriv_compute_mutex;
+		// spline. These are computed when the spline is first evaluated.
+		mutable std::vector<double> m_second_derivatives;
 
 		// Boundary conditions.
 		double m_derivative_x0, m_derivative_xn;
 		bool m_natural_bc_x0, m_natural_bc_xn;
 
 		// Compute information needed for spline:
-		void compute_second_derivatives();
-		// Have we computed compute_second_derivatives() yet?
-		volatile bool m_derivatives_computed;
+		void compute_second_derivatives() const;
+		// Compute the second derivatives of count natural splines of equal
+		// size together and mark them computed.
+		static void compute_second_derivatives_many(CubicSpline1D * splines, int count);
+		// Call compute_second_derivatives_many for blocks of splines over
+		// num_threads threads.
+		static void compute_second_derivatives_threaded(
+			std::vector<CubicSpline1D> & splines, int num_threads);
+		// State of m_second_derivatives. The first thread to evaluate the
+		// spline moves this from not_computed to computing, and then to
+		// computed. Once computed, evaluation only needs an atomic load.
+		enum derivative_state : int {
+			not_computed = 0,
+			computing = 1,
+			computed = 2
+		};
+		mutable std::atomic<int> m_derivative_state;
+		// Wait for any computation in progress and return the state.
+		int settled_derivative_state() const;
 
 		// Check that the derivatives have been computed and compute if needed.
-		void check_computed_blocking();
+		void check_computed_blocking() const;
+
+		// Compiled form: for each interval, c0 to c3 of 
+		// y = c0 + c1 t + c2 t^2 + c3 t^3 where t = x - x_klo, interleaved.
+		// Padded so that the table can start on a cache line boundary.
+		std::vector<double> m_coefficients;
+		bool m_compiled;
+		// If the point locations are evenly spaced, 1 / spacing. Else 0.
+		double m_uniform_inverse_spacing;
+		// Write polynomial_coefficients() into an array of 4 * (n - 1).
+		void compute_coefficients(double * coefficients) const;
+		// Pointer to the cache line aligned start of m_coefficients.
+		const double * compiled_coefficients() const;
+		// Interval location for the compiled form.
+		int compiled_interval(double location, int guess) const;
+
+		// Find klo such that m_point_locations[klo] <= location < 
+		// m_point_locations[klo + 1], clamped to the first and last intervals.
+		// guess is tried (along with the interval after it) before bisecting.
+		int find_interval(double location, int guess) const;
+		// Find the intervals for many locations.
+		void find_intervals(const std::vector<double> & locations,
+			std::vector<int> & intervals) const;
 	};
 }
 
@@ -26,6 +26,9 @@ SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
 #include <array>
+#include <cassert>
+#include <cmath>
+#include <vector>
 
 #include "CubicSpline1D.h"
 #include "Generators.h"
@@ -45,23 +48,54 @@ namespace HBTK {
 		~CubicSplineND();
 
 		// Evaluate the spline.
-		std::array<double, TNumDimensions> operator()(double local_position);
-		std::array<double, TNumDimensions> evaluate(double local_position);
+		std::array<double, TNumDimensions> operator()(double local_position) const;
+		std::array<double, TNumDimensions> evaluate(double local_position) const;
+		// Evaluate the spline and its derivative with a single interval search.
+		void evaluate(double local_position,
+			std::array<double, TNumDimensions> & value,
+			std::array<double, TNumDimensions> & derivative) const;
+
+		// Evaluate the spline at many positions, such as a whole curve. Positions
+		// given in ascending order reuse the previous interval. One output vector
+		// per dimension, resized to match local_positions.
+		std::array<std::vector<double>, TNumDimensions> evaluate(
+			const std::vector<double> & local_positions) const;
+		void evaluate(const std::vector<double> & local_positions,
+			std::array<std::vector<double>, TNumDimensions> & values,
+			std::array<std::vector<double>, TNumDimensions> & derivatives) const;
 
 		// Get a subspline if you're only interested in one dimension:
-		CubicSpline1D & operator[](const int dimension);
+		const CubicSpline1D & operator[](const int dimension) const;
 
 		// The derivatives with respect to the input parameter.
-		std::array<double, TNumDimensions> derivative(double local_position);
+		std::array<double, TNumDimensions> derivative(double local_position) const;
 
-		double lower_input_bound();
-		double upper_input_bound();
+		double lower_input_bound() const;
+		double upper_input_bound() const;
 
 	protected:
 		// The spline is defined {X} = f(h) where h is a paramater
 		// that controls the point on the spline. Each component of
 		// X is defined by a "subspline".
 		std::array<CubicSpline1D, TNumDimensions> m_subsplines;
+
+		// If all the subsplines share knots, they are also stored fused: one
+		// knot vector and, for interval i, coefficient k and dimension d, 
+		// m_coefficients[(4 * i + k) * TNumDimensions + d] for
+		// X_d = c0 + c1 t + c2 t^2 + c3 t^3 where t = h - m_knots[i].
+		// Otherwise m_knots is empty and the subsplines are used.
+		std::vector<double> m_knots;
+		std::vector<double> m_coefficients;
+		// If the knots are evenly spaced, 1 / spacing. Else 0.
+		double m_uniform_inverse_spacing;
+
+		// Build m_knots and m_coefficients from m_subsplines if possible.
+		void fuse();
+		// Find the interval of m_knots containing local_position.
+		int find_interval(double local_position, int guess) const;
+		// Evaluate using the fused coefficients of an interval.
+		void evaluate_interval(int interval, double local_position,
+			double * value, double * derivative) const;
 	};
 } // End namespace HBTK
 
@@ -69,12 +103,15 @@ namespace HBTK {
 namespace HBTK {
 	template<int TNumDimensions>
 	inline CubicSplineND<TNumDimensions>::CubicSplineND(std::array<CubicSpline1D, TNumDimensions> dimensional_splines)
-		: m_subsplines(dimensional_splines)
+		: m_subsplines(dimensional_splines),
+		m_uniform_inverse_spacing(0)
 	{
+		fuse();
 	}
 
 	template<int TNumDimensions>
 	inline CubicSplineND<TNumDimensions>::CubicSplineND(std::array<std::vector<double>, TNumDimensions> control_points)
+		: m_uniform_inverse_spacing(0)
 	{
 		int num_points = (int)control_points[0].size();
 		for (auto & vector : control_points) { assert(num_points == (int)vector.size()); }
@@ -83,6 +120,7 @@ namespace HBTK {
 			CubicSpline1D spline(input_points, control_points[i]);
 			m_subsplines[i] = spline;
 		}
+		fuse();
 	}
 
 	template<int TNumDimensions>
@@ -91,15 +129,20 @@ namespace HBTK {
 	}
 
 	template<int TNumDimensions>
-	inline std::array<double, TNumDimensions> CubicSplineND<TNumDimensions>::operator()(double local_position)
+	inline std::array<double, TNumDimensions> CubicSplineND<TNumDimensions>::operator()(double local_position) const
 	{
 		return evaluate(local_position);
 	}
 
 	template<int TNumDimensions>
-	inline std::array<double, TNumDimensions> CubicSplineND<TNumDimensions>::evaluate(double local_position)
+	inline std::array<double, TNumDimensions> CubicSplineND<TNumDimensions>::evaluate(double local_position) const
 	{
 		std::array<double, TNumDimensions> result;
+		if (!m_knots.empty()) {
+			int interval = find_interval(local_position, 0);
+			evaluate_interval(interval, local_position, result.data(), nullptr);
+			return result;
+		}
 		for (int i = 0; i < TNumDimensions; i++) {
 			result[i] = m_subsplines[i](local_position);
 		}
@@ -107,18 +150,91 @@ namespace HBTK {
 	}
 
 	template<int TNumDimensions>
-	inline CubicSpline1D & CubicSplineND<TNumDimensions>::operator[](const int dimension)
+	inline void CubicSplineND<TNumDimensions>::evaluate(double local_position,
+		std::array<double, TNumDimensions>& value,
+		std::array<double, TNumDimensions>& derivative) const
+	{
+		if (!m_knots.empty()) {
+			int interval = find_interval(local_position, 0);
+			evaluate_interval(interval, local_position, value.data(), derivative.data());
+			return;
+		}
+		for (int i = 0; i < TNumDimensions; i++) {
+			value[i] = m_subsplines[i](local_position);
+			derivative[i] = m_subsplines[i].derivative(local_position);
+		}
+		return;
+	}
+
+	template<int TNumDimensions>
+	inline std::array<std::vector<double>, TNumDimensions> 
+		CubicSplineND<TNumDimensions>::evaluate(const std::vector<double>& local_positions) const
+	{
+		std::array<std::vector<double>, TNumDimensions> values;
+		if (m_knots.empty()) {
+			for (int i = 0; i < TNumDimensions; i++) {
+				values[i] = m_subsplines[i].evaluate(local_positions);
+			}
+			return values;
+		}
+		const int n = (int)local_positions.size();
+		for (auto & vector : values) { vector.resize(n); }
+		std::array<double, TNumDimensions> value;
+		int interval = 0;
+		for (int j = 0; j < n; j++) {
+			interval = find_interval(local_positions[j], interval);
+			evaluate_interval(interval, local_positions[j], value.data(), nullptr);
+			for (int i = 0; i < TNumDimensions; i++) { values[i][j] = value[i]; }
+		}
+		return values;
+	}
+
+	template<int TNumDimensions>
+	inline void CubicSplineND<TNumDimensions>::evaluate(const std::vector<double>& local_positions,
+		std::array<std::vector<double>, TNumDimensions>& values,
+		std::array<std::vector<double>, TNumDimensions>& derivatives) const
+	{
+		if (m_knots.empty()) {
+			std::vector<double> d2, d3;
+			for (int i = 0; i < TNumDimensions; i++) {
+				m_subsplines[i].evaluate(local_positions, values[i], derivatives[i], d2, d3);
+			}
+			return;
+		}
+		const int n = (int)local_positions.size();
+		for (auto & vector : values) { vector.resize(n); }
+		for (auto & vector : derivatives) { vector.resize(n); }
+		std::array<double, TNumDimensions> value, derivative;
+		int interval = 0;
+		for (int j = 0; j < n; j++) {
+			interval = find_interval(local_positions[j], interval);
+			evaluate_interval(interval, local_positions[j], value.data(), derivative.data());
+			for (int i = 0; i < TNumDimensions; i++) { 
+				values[i][j] = value[i]; 
+				derivatives[i][j] = derivative[i];
+			}
+		}
+		return;
+	}
+
+	template<int TNumDimensions>
+	inline const CubicSpline1D & CubicSplineND<TNumDimensions>::operator[](const int dimension) const
 	{
-		assert(dimension > 0);
+		assert(dimension >= 0);
 		assert(dimension < TNumDimensions);
 		return m_subsplines[dimension];
 	}
 
 	template<int TNumDimensions>
 	inline std::array<double, TNumDimensions>
-		CubicSplineND<TNumDimensions>::derivative(double local_position)
+		CubicSplineND<TNumDimensions>::derivative(double local_position) const
 	{
 		std::array<double, TNumDimensions> derivs;
+		if (!m_knots.empty()) {
+			std::array<double, TNumDimensions> values;
+			evaluate(local_position, values, derivs);
+			return derivs;
+		}
 		for (int i = 0; i < TNumDimensions; i++){
 			derivs[i] = m_subsplines[i].derivative(local_position);
 		}
@@ -126,24 +242,103 @@ namespace HBTK {
 	}
 
 	template<int TNumDimensions>
-	inline double CubicSplineND<TNumDimensions>::lower_input_bound()
+	inline double CubicSplineND<TNumDimensions>::lower_input_bound() const
 	{
-		double lower_bound = m_subsplines[0].lower_bound();
+		double lower_bound = m_subsplines[0].lower_input_bound();
 		for (int i = 1; i < TNumDimensions; i++) {
-			double other_lb = m_subsplines[i].lower_bound();
+			double other_lb = m_subsplines[i].lower_input_bound();
 			if (lower_bound > other_lb) lower_bound = other_lb;
 		}
 		return lower_bound;
 	}
 
 	template<int TNumDimensions>
-	inline double CubicSplineND<TNumDimensions>::upper_input_bound()
+	inline double CubicSplineND<TNumDimensions>::upper_input_bound() const
 	{
-		double upper_bound = m_subsplines[0].upper_bound();
+		double upper_bound = m_subsplines[0].upper_input_bound();
 		for (int i = 1; i < TNumDimensions; i++) {
-			double other_lb = m_subsplines[i].upper_bound();
+			double other_lb = m_subsplines[i].upper_input_bound();
 			if (upper_bound < other_lb) upper_bound = other_lb;
 		}
 		return upper_bound;
 	}
+
+	template<int TNumDimensions>
+	inline void CubicSplineND<TNumDimensions>::fuse()
+	{
+		m_knots.clear();
+		m_coefficients.clear();
+		m_uniform_inverse_spacing = 0;
+		const std::vector<double> & knots = m_subsplines[0].point_locations();
+		if (knots.size() < 2) { return; }
+		for (int i = 1; i < TNumDimensions; i++) {
+			if (m_subsplines[i].point_locations() != knots) { return; }
+		}
+		const int num_intervals = (int)knots.size() - 1;
+		m_coefficients.resize(4 * num_intervals * TNumDimensions);
+		for (int d = 0; d < TNumDimensions; d++) {
+			std::vector<double> coeffs = m_subsplines[d].polynomial_coefficients();
+			for (int i = 0; i < 4 * num_intervals; i++) {
+				m_coefficients[i * TNumDimensions + d] = coeffs[i];
+			}
+		}
+		m_knots = knots;
+		double spacing = (knots.back() - knots[0]) / num_intervals;
+		bool uniform = true;
+		for (int i = 1; i <= num_intervals; i++) {
+			if (std::abs(knots[i] - (knots[0] + i * spacing)) > 1e-12 * std::abs(knots.back() - knots[0])) {
+				uniform = false;
+				break;
+			}
+		}
+		m_uniform_inverse_spacing = uniform ? 1. / spacing : 0.;
+		return;
+	}
+
+	template<int TNumDimensions>
+	inline int CubicSplineND<TNumDimensions>::find_interval(double local_position, int guess) const
+	{
+		const int last = (int)m_knots.size() - 2;
+		if (m_uniform_inverse_spacing != 0.) {
+			double k = (local_position - m_knots[0]) * m_uniform_inverse_spacing;
+			k = k >= 0. ? k : 0.;	// Also catches NaN.
+			k = k <= last ? k : last;
+			return (int)k;
+		}
+		const double * x = m_knots.data();
+		if (guess >= 0 && guess <= last) {
+			if (guess == 0 || x[guess] <= local_position) {
+				if (guess == last || x[guess + 1] > local_position) { return guess; }
+				if (guess + 1 == last || x[guess + 2] > local_position) { return guess + 1; }
+			}
+		}
+		int klo = 0;
+		int khi = last + 1;
+		while (khi - klo > 1) {
+			int k = (khi + klo) / 2;
+			if (x[k] > local_position) { khi = k; }
+			else { klo = k; }
+		}
+		return klo;
+	}
+
+	template<int TNumDimensions>
+	inline void CubicSplineND<TNumDimensions>::evaluate_interval(int interval, 
+		double local_position, double * value, double * derivative) const
+	{
+		const double t = local_position - m_knots[interval];
+		const double * c0 = m_coefficients.data() + 4 * interval * TNumDimensions;
+		const double * c1 = c0 + TNumDimensions;
+		const double * c2 = c1 + TNumDimensions;
+		const double * c3 = c2 + TNumDimensions;
+		for (int d = 0; d < TNumDimensions; d++) {
+			value[d] = c0[d] + t * (c1[d] + t * (c2[d] + t * c3[d]));
+		}
+		if (derivative != nullptr) {
+			for (int d = 0; d < TNumDimensions; d++) {
+				derivative[d] = c1[d] + t * (2. * c2[d] + t * 3. * c3[d]);
+			}
+		}
+		return;
+	}
 }
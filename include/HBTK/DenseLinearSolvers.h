@@ -0,0 +1,105 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+DenseLinearSolvers.h
+
+Direct and iterative solution of dense linear systems, such as those made
+from panel influence matrices.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <functional>
+#include <vector>
+
+#include "DenseMatrix.h"
+
+namespace HBTK {
+	// LU factorisation with partial pivoting, P A = L U. The factorisation 
+	// is done once and then reused for as many right hand sides as needed,
+	// for example in a time-marching solver where only the right hand side 
+	// changes between steps.
+	class LUFactorisation {
+	public:
+		LUFactorisation();
+		// Throws std::runtime_error if the matrix is singular.
+		explicit LUFactorisation(const DenseMatrix & matrix, int num_threads = 1);
+		// Factorise the matrix in its own storage.
+		explicit LUFactorisation(DenseMatrix && matrix, int num_threads = 1);
+
+		int size() const noexcept;
+
+		std::vector<double> solve(const std::vector<double> & rhs) const;
+		void solve_in_place(std::vector<double> & rhs) const;
+
+		// L (unit diagonal, not stored) below the diagonal, U on and above.
+		const DenseMatrix & factors() const noexcept;
+		// Row i was swapped with row pivots()[i] at step i.
+		const std::vector<int> & pivots() const noexcept;
+
+	private:
+		DenseMatrix m_lu;
+		std::vector<int> m_pivots;
+
+		void factorise(int num_threads);
+	};
+
+	// Computes result = A x for some matrix A that needn't be stored. The 
+	// result vector is already the correct size.
+	using LinearOperator = std::function<void(const std::vector<double> & x, 
+		std::vector<double> & result)>;
+
+	/// \brief Information about a call to an iterative solver.
+	struct IterativeSolveReport {
+		int iterations = 0;			// Number of Krylov iterations.
+		double residual = 0;		// Final |b - A x| / |b|.
+		bool converged = false;		// True if residual <= tolerance.
+	};
+
+	/// \param matrix the operator A. Must be thread safe if the 
+	/// preconditioner is.
+	/// \param rhs the right hand side b.
+	/// \param initial_guess the starting x. Empty for zero.
+	/// \param tolerance the relative residual |b - A x| / |b| to reach.
+	/// \param restart the size of the Krylov subspace before restarting.
+	/// \param max_iterations the maximum number of Krylov iterations. Each
+	/// restart also costs an extra application of the operator.
+	/// \param preconditioner if not empty, applies an approximation of the 
+	/// inverse of A. Used as a right preconditioner, so the residual 
+	/// tested is that of the unpreconditioned system.
+	/// \param report if not null, filled with the number of iterations and 
+	/// the final residual.
+	/// \returns the solution x.
+	///
+	/// \brief Solve A x = b using restarted GMRES with A given only by its 
+	/// action on a vector.
+	std::vector<double> gmres(const LinearOperator & matrix, 
+		const std::vector<double> & rhs, const std::vector<double> & initial_guess,
+		double tolerance = 1e-10, int restart = 50, int max_iterations = 1000,
+		const LinearOperator & preconditioner = LinearOperator(),
+		IterativeSolveReport * report = nullptr);
+
+	/// \brief Solve A x = b using restarted GMRES with a multithreaded 
+	/// product with the assembled matrix.
+	std::vector<double> gmres(const DenseMatrix & matrix, 
+		const std::vector<double> & rhs, const std::vector<double> & initial_guess,
+		double tolerance = 1e-10, int restart = 50, int max_iterations = 1000,
+		int num_threads = 1, IterativeSolveReport * report = nullptr);
+}
@@ -0,0 +1,110 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+DenseMatrix.h
+
+A dense, row major matrix of doubles.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace HBTK {
+	// A dense matrix stored row by row in one contiguous array. Element 
+	// (i, j) is data()[i * cols() + j]. Element access is inline so that
+	// loops over a matrix don't pay for a function call per element.
+	class DenseMatrix {
+	public:
+		DenseMatrix();
+		DenseMatrix(int rows, int cols, double value = 0);
+
+		int rows() const noexcept;
+		int cols() const noexcept;
+		// Resizing doesn't preserve the values of the matrix.
+		void resize(int rows, int cols, double value = 0);
+
+		double & operator()(int row, int col) noexcept;
+		double operator()(int row, int col) const noexcept;
+
+		// Pointer to the first element of a row.
+		double * row(int row) noexcept;
+		const double * row(int row) const noexcept;
+		double * data() noexcept;
+		const double * data() const noexcept;
+
+		// Matrix-vector product.
+		std::vector<double> operator*(const std::vector<double> & vector) const;
+
+		static DenseMatrix identity(int size);
+
+	private:
+		int m_rows, m_cols;
+		std::vector<double> m_data;
+	};
+
+	inline int DenseMatrix::rows() const noexcept
+	{
+		return m_rows;
+	}
+
+	inline int DenseMatrix::cols() const noexcept
+	{
+		return m_cols;
+	}
+
+	inline double & DenseMatrix::operator()(int row, int col) noexcept
+	{
+		assert(row >= 0 && row < m_rows);
+		assert(col >= 0 && col < m_cols);
+		return m_data[(size_t)row * m_cols + col];
+	}
+
+	inline double DenseMatrix::operator()(int row, int col) const noexcept
+	{
+		assert(row >= 0 && row < m_rows);
+		assert(col >= 0 && col < m_cols);
+		return m_data[(size_t)row * m_cols + col];
+	}
+
+	inline double * DenseMatrix::row(int row) noexcept
+	{
+		assert(row >= 0 && row < m_rows);
+		return m_data.data() + (size_t)row * m_cols;
+	}
+
+	inline const double * DenseMatrix::row(int row) const noexcept
+	{
+		assert(row >= 0 && row < m_rows);
+		return m_data.data() + (size_t)row * m_cols;
+	}
+
+	inline double * DenseMatrix::data() noexcept
+	{
+		return m_data.data();
+	}
+
+	inline const double * DenseMatrix::data() const noexcept
+	{
+		return m_data.data();
+	}
+}
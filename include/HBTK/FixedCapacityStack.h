@@ -0,0 +1,82 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+FixedCapacityStack.h
+
+A stack with storage of fixed size that never allocates on the heap.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <cstddef>
+
+namespace HBTK {
+
+	/// \brief A last in first out stack of at most Capacity elements.
+	///
+	/// Storage is held inside the object, so a FixedCapacityStack placed on
+	/// the call stack never touches the heap. Pushing to a full stack is an
+	/// error - check full() first.
+	///
+	/// \code
+	/// HBTK::FixedCapacityStack<double, 64> stack;
+	/// stack.push(1.0);
+	/// if (!stack.full()) stack.push(2.0);
+	/// double top = stack.top();	// 2.0
+	/// stack.pop();
+	/// \endcode
+	template<typename Ty, std::size_t Capacity>
+	class FixedCapacityStack
+	{
+	public:
+		FixedCapacityStack() : m_size(0) {}
+
+		void push(const Ty & value) { 
+			assert(!full());
+			m_data[m_size++] = value; 
+		}
+
+		void pop() { 
+			assert(!empty());
+			m_size--; 
+		}
+
+		Ty & top() { 
+			assert(!empty());
+			return m_data[m_size - 1]; 
+		}
+
+		const Ty & top() const { 
+			assert(!empty());
+			return m_data[m_size - 1]; 
+		}
+
+		bool empty() const { return m_size == 0; }
+		bool full() const { return m_size == Capacity; }
+		std::size_t size() const { return m_size; }
+		static constexpr std::size_t capacity() { return Capacity; }
+		void clear() { m_size = 0; }
+
+	private:
+		Ty m_data[Capacity];
+		std::size_t m_size;
+	};
+}
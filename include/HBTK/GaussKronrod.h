@@ -0,0 +1,410 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+GaussKronrod.h
+
+Globally adaptive Gauss-Kronrod integration with extrapolation.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace HBTK {
+
+	enum gauss_kronrod_rule {
+		gauss_kronrod_7_15,
+		gauss_kronrod_10_21,
+		gauss_kronrod_30_61
+	};
+
+	/// \brief The nodes and weights of a Gauss-Kronrod rule on [-1, 1].
+	///
+	/// Only the non-negative half is stored, in descending order, so the 
+	/// last node is the centre 0. gauss_weights is zero for Kronrod only
+	/// nodes.
+	struct GaussKronrodTable {
+		int num_nodes;
+		const double * nodes;
+		const double * kronrod_weights;
+		const double * gauss_weights;
+	};
+
+	GaussKronrodTable gauss_kronrod_table(gauss_kronrod_rule rule);
+
+	/// \brief Information about a call to gauss_kronrod_integrate.
+	struct GaussKronrodReport {
+		int evaluations = 0;		// Number of calls to the integrand.
+		int subintervals = 0;		// Number of subintervals at exit.
+		double error_estimate = 0;	// Estimated absolute error of the result.
+		bool converged = true;		// False if the tolerance wasn't met.
+		bool extrapolated = false;	// True if the result is from extrapolation.
+	};
+
+	/// \brief Wynn's epsilon algorithm for accelerating the convergence of
+	/// a sequence.
+	///
+	/// Add the terms of a sequence one at a time. result() is the estimate 
+	/// of the limit from the epsilon table and error_estimate() is based on
+	/// the last three results, as in QUADPACK's qelg. Only the last 
+	/// max_terms terms are used.
+	/// \code
+	/// HBTK::WynnEpsilon epsilon;
+	/// double partial_sum = 0;
+	/// for (int i = 1; i < 12; i++) {
+	///		partial_sum += (i % 2 ? 1. : -1.) / i;
+	///		epsilon.add(partial_sum);
+	/// }
+	/// epsilon.result(); // ~ log(2)
+	/// \endcode
+	class WynnEpsilon {
+	public:
+		WynnEpsilon(int max_terms = 50);
+
+		void add(double term);
+		double result() const;
+		// Infinite until three results have been computed.
+		double error_estimate() const;
+		int size() const;
+		void clear();
+
+	private:
+		int m_max_terms;
+		std::vector<double> m_terms;
+		std::vector<double> m_last_results;
+		double m_result, m_error;
+	};
+
+	template<typename Tf>
+	double gauss_kronrod_integrate(Tf & func, double lower_limit, double upper_limit,
+		double absolute_tolerance, double relative_tolerance,
+		gauss_kronrod_rule rule = gauss_kronrod_10_21, bool extrapolate = true,
+		int max_subintervals = 1000, GaussKronrodReport * report = nullptr);
+
+	template<typename Tf, typename Tremap>
+	double gauss_kronrod_integrate_remapped(Tf & func, Tremap & remap, 
+		double lower_limit, double upper_limit,
+		double absolute_tolerance, double relative_tolerance,
+		gauss_kronrod_rule rule = gauss_kronrod_10_21, bool extrapolate = true,
+		int max_subintervals = 1000, GaussKronrodReport * report = nullptr);
+
+	/// \brief The Gauss-Kronrod estimate of the integral over one interval.
+	struct GaussKronrodInterval {
+		double lower_limit, upper_limit;
+		double result, error;
+	};
+
+	template<typename Tf>
+	GaussKronrodInterval gauss_kronrod_evaluate(Tf & func, const GaussKronrodTable & table,
+		double lower_limit, double upper_limit);
+
+
+	// DEFINITIONS
+
+	/// \param func a function taking and returning a double.
+	/// \param table the Gauss-Kronrod rule to use.
+	/// \param lower_limit lower limit of the interval.
+	/// \param upper_limit upper limit of the interval.
+	///
+	/// \brief Apply a Gauss-Kronrod rule to a single interval.
+	///
+	/// Makes 2 * table.num_nodes - 1 evaluations of func. The error 
+	/// estimate follows QUADPACK's qk routines.
+	template<typename Tf>
+	GaussKronrodInterval gauss_kronrod_evaluate(Tf & func, const GaussKronrodTable & table,
+		double lower_limit, double upper_limit)
+	{
+		assert(table.num_nodes > 0 && table.num_nodes <= 31);
+		const int centre_idx = table.num_nodes - 1;
+		const double centre = (upper_limit + lower_limit) / 2;
+		const double half_length = (upper_limit - lower_limit) / 2;
+		double lower_values[31], upper_values[31];
+
+		const double f_centre = func(centre);
+		double result_kronrod = f_centre * table.kronrod_weights[centre_idx];
+		double result_gauss = f_centre * table.gauss_weights[centre_idx];
+		double result_abs = std::abs(result_kronrod);
+		for (int j = 0; j < centre_idx; j++) {
+			const double offset = half_length * table.nodes[j];
+			const double f1 = func(centre - offset);
+			const double f2 = func(centre + offset);
+			lower_values[j] = f1;
+			upper_values[j] = f2;
+			result_kronrod += table.kronrod_weights[j] * (f1 + f2);
+			result_gauss += table.gauss_weights[j] * (f1 + f2);
+			result_abs += table.kronrod_weights[j] * (std::abs(f1) + std::abs(f2));
+		}
+		// Approximation to the integral of |f - mean(f)|
+		const double mean = result_kronrod / 2;
+		double result_asc = table.kronrod_weights[centre_idx] * std::abs(f_centre - mean);
+		for (int j = 0; j < centre_idx; j++) {
+			result_asc += table.kronrod_weights[j] 
+				* (std::abs(lower_values[j] - mean) + std::abs(upper_values[j] - mean));
+		}
+		result_abs *= std::abs(half_length);
+		result_asc *= std::abs(half_length);
+
+		GaussKronrodInterval interval;
+		interval.lower_limit = lower_limit;
+		interval.upper_limit = upper_limit;
+		interval.result = result_kronrod * half_length;
+		interval.error = std::abs((result_kronrod - result_gauss) * half_length);
+		if (result_asc != 0 && interval.error != 0) {
+			interval.error = result_asc * std::min(1., pow(200 * interval.error / result_asc, 1.5));
+		}
+		if (result_abs > DBL_MIN / (50 * DBL_EPSILON)) {
+			interval.error = std::max(DBL_EPSILON * 50 * result_abs, interval.error);
+		}
+		return interval;
+	}
+
+
+	/// \param func a function taking and returning a double.
+	/// \param lower_limit the lower limit of integration.
+	/// \param upper_limit the upper limit of integration.
+	/// \param absolute_tolerance requested absolute error.
+	/// \param relative_tolerance requested error relative to the result.
+	/// \param rule the Gauss-Kronrod rule applied to each subinterval.
+	/// \param extrapolate use Wynn's epsilon algorithm to accelerate 
+	/// convergence for singular integrands.
+	/// \param max_subintervals the maximum number of subintervals.
+	/// \param report if not null, filled with information about the integration.
+	///
+	/// \brief Evaluate an integral with a globally adaptive Gauss-Kronrod
+	/// method.
+	///
+	/// The subinterval with the largest error estimate is always bisected 
+	/// next, so effort is spent where the integrand is hardest. The 
+	/// subintervals are kept in a priority queue. The integration stops 
+	/// when the total error estimate is below 
+	/// max(absolute_tolerance, relative_tolerance * |result|).
+	///
+	/// With extrapolate, this is a simplified form of QUADPACK's QAGS. Each
+	/// time a bisection makes a new smallest subinterval width, the larger 
+	/// subintervals are refined until their error is acceptable, and 
+	/// the total is passed to a WynnEpsilon. This cuts the number of 
+	/// evaluations for integrable endpoint singularities such as 
+	/// \f$x^{-1/2}\f$ or \f$\log(x)\f$. The extrapolated result is used if
+	/// its error estimate is smaller.
+	/// \code
+	/// #include "HBTK/GaussKronrod.h"
+	/// auto my_f = [](double x)->double { return log(x); };
+	/// HBTK::GaussKronrodReport report;
+	/// double result = HBTK::gauss_kronrod_integrate(my_f, 0.0, 1.0, 
+	///		1e-12, 1e-12, HBTK::gauss_kronrod_10_21, true, 1000, &report);
+	/// // result ~ -1.
+	/// \endcode
+	template<typename Tf>
+	double gauss_kronrod_integrate(Tf & func, double lower_limit, double upper_limit,
+		double absolute_tolerance, double relative_tolerance,
+		gauss_kronrod_rule rule, bool extrapolate,
+		int max_subintervals, GaussKronrodReport * report)
+	{
+		assert(lower_limit < upper_limit);
+		assert(absolute_tolerance >= 0 && relative_tolerance >= 0);
+		assert(absolute_tolerance > 0 || relative_tolerance > 0);
+		assert(max_subintervals > 0);
+
+		const GaussKronrodTable table = gauss_kronrod_table(rule);
+		const int evals_per_interval = 2 * table.num_nodes - 1;
+		auto acceptable = [&](double result, double error) {
+			return std::isfinite(result) && 
+				error <= std::max(absolute_tolerance, relative_tolerance * std::abs(result));
+		};
+		auto less_error = [](const GaussKronrodInterval & a, const GaussKronrodInterval & b) {
+			return a.error < b.error;
+		};
+
+		// A max-heap on the error estimate.
+		std::vector<GaussKronrodInterval> heap;
+		heap.reserve(max_subintervals);
+		heap.push_back(gauss_kronrod_evaluate(func, table, lower_limit, upper_limit));
+		int evaluations = evals_per_interval;
+		double result_sum = heap[0].result;
+		double error_sum = heap[0].error;
+
+		double best_result = result_sum;
+		double best_error = error_sum;
+		bool extrapolated = false;
+		bool converged = acceptable(result_sum, error_sum);
+
+		WynnEpsilon epsilon;
+		epsilon.add(result_sum);
+		double small_width = upper_limit - lower_limit;
+		bool refining_large = false;	// Working on the larger subintervals?
+
+		while (!converged && (int)heap.size() < max_subintervals)
+		{
+			// Choose the subinterval to bisect. Normally this is the worst,
+			// but before extrapolation the larger subintervals are resolved.
+			int idx = 0;
+			if (refining_large) {
+				idx = -1;
+				for (int i = 0; i < (int)heap.size(); i++) {
+					if (heap[i].upper_limit - heap[i].lower_limit > small_width * 1.5 &&
+						(idx < 0 || heap[i].error > heap[idx].error)) { idx = i; }
+				}
+				if (idx < 0) {
+					refining_large = false;
+					idx = 0;
+				}
+			}
+			GaussKronrodInterval parent = heap[idx];
+			if (idx == 0) {
+				std::pop_heap(heap.begin(), heap.end(), less_error);
+				heap.pop_back();
+			}
+			else {
+				heap[idx] = heap.back();
+				heap.pop_back();
+				std::make_heap(heap.begin(), heap.end(), less_error);
+			}
+
+			double mid = (parent.lower_limit + parent.upper_limit) / 2;
+			if (mid <= parent.lower_limit || mid >= parent.upper_limit) {
+				// Can't resolve any further in floating point.
+				heap.push_back(parent);
+				std::push_heap(heap.begin(), heap.end(), less_error);
+				break;
+			}
+			GaussKronrodInterval left = gauss_kronrod_evaluate(func, table, parent.lower_limit, mid);
+			GaussKronrodInterval right = gauss_kronrod_evaluate(func, table, mid, parent.upper_limit);
+			evaluations += 2 * evals_per_interval;
+			result_sum += left.result + right.result - parent.result;
+			error_sum += left.error + right.error - parent.error;
+			heap.push_back(left);
+			std::push_heap(heap.begin(), heap.end(), less_error);
+			heap.push_back(right);
+			std::push_heap(heap.begin(), heap.end(), less_error);
+			if (!std::isfinite(result_sum) || !std::isfinite(error_sum)) {
+				// A non-finite value, ie. func evaluated at a singularity, 
+				// can't be removed by subtraction.
+				result_sum = 0;
+				error_sum = 0;
+				for (auto & interval : heap) {
+					result_sum += interval.result;
+					error_sum += interval.error;
+				}
+			}
+
+			if (acceptable(result_sum, error_sum)) {
+				best_result = result_sum;
+				best_error = error_sum;
+				extrapolated = false;
+				converged = true;
+				break;
+			}
+			if (error_sum < best_error || !extrapolated) {
+				best_result = result_sum;
+				best_error = error_sum;
+				extrapolated = false;
+			}
+			if (!extrapolate) { continue; }
+
+			double width = mid - parent.lower_limit;
+			if (width < small_width / 1.5) {
+				small_width = width;
+				refining_large = true;
+			}
+			if (refining_large) {
+				double error_large = 0;
+				for (auto & interval : heap) {
+					if (interval.upper_limit - interval.lower_limit > small_width * 1.5) { 
+						error_large += interval.error; 
+					}
+				}
+				if (!acceptable(result_sum, error_large)) { continue; }
+				refining_large = false;
+				epsilon.add(result_sum);
+				double error_extrapolated = std::max(epsilon.error_estimate(), error_large);
+				if (error_extrapolated < best_error) {
+					best_result = epsilon.result();
+					best_error = error_extrapolated;
+					extrapolated = true;
+				}
+				if (extrapolated && acceptable(best_result, best_error)) {
+					converged = true;
+					break;
+				}
+			}
+		}
+
+		if (report != nullptr) {
+			report->evaluations = evaluations;
+			report->subintervals = (int)heap.size();
+			report->error_estimate = best_error;
+			report->converged = converged;
+			report->extrapolated = extrapolated;
+		}
+		return best_result;
+	}
+
+
+	/// \param func a function taking and returning a double.
+	/// \param remap a function/lambda with signature void(double & point, 
+	/// double & weight) that maps a point in [-1, 1] onto [-1, 1].
+	/// \param lower_limit the lower limit of integration.
+	/// \param upper_limit the upper limit of integration.
+	/// \param absolute_tolerance requested absolute error.
+	/// \param relative_tolerance requested error relative to the result.
+	/// \param rule the Gauss-Kronrod rule applied to each subinterval.
+	/// \param extrapolate use Wynn's epsilon algorithm.
+	/// \param max_subintervals the maximum number of subintervals.
+	/// \param report if not null, filled with information about the integration.
+	///
+	/// \brief Evaluate an integral with gauss_kronrod_integrate after a 
+	/// change of variable given by a remap from Remaps.h.
+	///
+	/// The remaps in Remaps.h act on a quadrature point and weight on 
+	/// [-1, 1]. Applied to a point t with weight 1, they give the new 
+	/// coordinate and the Jacobian of the change of variable. The 
+	/// remapped integrand is integrated adaptively over [-1, 1], which
+	/// smooths singularities that the remap is designed for.
+	/// \code
+	/// #include "HBTK/GaussKronrod.h"
+	/// #include "HBTK/Remaps.h"
+	/// auto my_f = [](double x)->double { return log(std::abs(x - 0.3)); };
+	/// auto telles = [](double & p, double & w) { 
+	///		HBTK::telles_cubic_remap(p, w, 0.3); };
+	/// double result = HBTK::gauss_kronrod_integrate_remapped(my_f, telles,
+	///		-1.0, 1.0, 1e-12, 1e-12);
+	/// \endcode
+	template<typename Tf, typename Tremap>
+	double gauss_kronrod_integrate_remapped(Tf & func, Tremap & remap, 
+		double lower_limit, double upper_limit,
+		double absolute_tolerance, double relative_tolerance,
+		gauss_kronrod_rule rule, bool extrapolate,
+		int max_subintervals, GaussKronrodReport * report)
+	{
+		const double half_length = (upper_limit - lower_limit) / 2;
+		auto remapped = [&](double t)->double {
+			double point = t, weight = 1;
+			remap(point, weight);
+			return func(lower_limit + (point + 1) * half_length) * weight * half_length;
+		};
+		return gauss_kronrod_integrate(remapped, -1.0, 1.0, absolute_tolerance, 
+			relative_tolerance, rule, extrapolate, max_subintervals, report);
+	}
+}
@@ -38,6 +38,9 @@ namespace HBTK {
 
 	StaticQuadrature gauss_legendre(int n_points);
 
+	void gauss_legendre_asymptotic(int n_points, std::vector<double> & points,
+		std::vector<double> & weights);
+
 	template <typename Ty, typename TyStor>
 	constexpr void gauss_legendre(int n_points, TyStor & points, 
 												TyStor & weights);
@@ -46,6 +49,15 @@ namespace HBTK {
 	constexpr void gauss_legendre(std::array<Ty, n_points> & points, 
 								  std::array<Ty, n_points> & weights);
 
+	template <int n_points, typename Ty = double>
+	struct GaussLegendreTable;
+
+	template <int n_points, typename Ty = double>
+	constexpr GaussLegendreTable<n_points, Ty> gauss_legendre_table();
+
+	template <int n_points, typename Ty = double, typename TyFunc>
+	auto gauss_legendre_integrate(TyFunc & func) -> decltype(func(Ty(0)) * Ty(0));
+
 
 	// DEFINITIONS
 
@@ -121,17 +133,16 @@ namespace HBTK {
 	/// \param weights std::array of Ty, length n_ponts-  
 	/// Weights of points written here
 	///
-	/// \brief generate gauss legendre quadrature - likely to be evaluated 
-	/// at compile time.
+	/// \brief generate gauss legendre quadrature into std::arrays.
 	///
 	/// Generates points and weights for a gauss legendre quadrature.
 	/// \code 
 	/// std::array<double, 100> p, w;
 	/// HBTK::gauss_legendre<100, double>(p, w);
 	/// \endcode
-	/// p now contians quadrature points, and w weights. This code 
-	/// should be optimised away such that the solution is precalcuated
-	/// at compile time.
+	/// p now contians quadrature points, and w weights. This is computed
+	/// at runtime. For a table computed at compile time, see
+	/// gauss_legendre_table.
 	template <long unsigned int n_points, typename Ty>
 	constexpr void gauss_legendre(std::array<Ty, n_points> & points, 
 								  std::array<Ty, n_points> & weights) 
@@ -142,6 +153,92 @@ namespace HBTK {
 	}
 
 
+	/// \brief Gauss-Legendre points and weights held in plain arrays so that
+	/// they can be computed at compile time. See gauss_legendre_table.
+	template <int n_points, typename Ty>
+	struct GaussLegendreTable {
+		static_assert(n_points > 0, "Table must have more than 0 points");
+		Ty points[n_points];
+		Ty weights[n_points];
+	};
+
+	/// \brief cos(x) usable in constant expressions.
+	///
+	/// Only intended for generating the initial guesses of gauss_legendre_table.
+	template <typename Ty>
+	constexpr Ty constexpr_cos(Ty x)
+	{
+		const Ty pi = HBTK::Constants::pi<Ty>();
+		x = x - 2 * pi * (Ty)(long long)(x / (2 * pi));
+		if (x > pi) { x = x - 2 * pi; }
+		if (x < -pi) { x = x + 2 * pi; }
+		Ty term(1), sum(1);
+		for (int i = 1; i < 20; i++) {
+			term = -term * x * x / ((2 * i - 1) * (2 * i));
+			sum = sum + term;
+		}
+		return sum;
+	}
+
+	/// \returns a GaussLegendreTable of n_points points and weights.
+	///
+	/// \brief generate a gauss legendre quadrature at compile time.
+	///
+	/// The same Newton iteration as gauss_legendre<Ty, TyStor>, but 
+	/// written so that it can be evaluated in a constant expression:
+	/// \code
+	/// constexpr auto table = HBTK::gauss_legendre_table<16>();
+	/// static_assert(table.weights[0] > 0, "");
+	/// \endcode
+	/// Compile time cost grows as n_points^2, so this is intended for
+	/// small rules (up to 64 points or so).
+	template <int n_points, typename Ty>
+	constexpr GaussLegendreTable<n_points, Ty> gauss_legendre_table()
+	{
+		GaussLegendreTable<n_points, Ty> table{};
+		for (int idxO = 0; idxO < (n_points + 1) / 2; idxO++) {
+			Ty z = constexpr_cos(HBTK::Constants::pi<Ty>() * (Ty)(idxO + 0.75) / (Ty)(n_points + 0.5));
+			Ty z1(12), pp(0);
+			for (int iter = 0; iter < 100; iter++) {
+				Ty p1(1), p2(0), p3(0);
+				for (int idxI = 0; idxI < n_points; idxI++) {
+					p3 = p2;	p2 = p1;
+					p1 = ((Ty)(2 * idxI + 1) * z * p2 - (Ty)idxI * p3) / (Ty)(idxI + 1);
+				}
+				pp = n_points * (z * p1 - p2) / (z * z - 1);
+				z1 = z;
+				z = z1 - p1 / pp;
+				if ((z - z1 < 0 ? z1 - z : z - z1) <= HBTK::tolerance<Ty>()) { break; }
+			}
+			table.points[idxO] = z;
+			table.points[n_points - idxO - 1] = -z;
+			table.weights[idxO] = 2 / ((1 - z * z) * pp * pp);
+			table.weights[n_points - idxO - 1] = table.weights[idxO];
+		}
+		// Odd n_points has a point at exactly 0.
+		if (n_points % 2 == 1) { table.points[n_points / 2] = 0; }
+		return table;
+	}
+
+	/// \param func function to integrate over [-1, 1].
+	///
+	/// \brief integrate using an n_points Gauss-Legendre rule that is
+	/// generated at compile time.
+	///
+	/// There is no setup cost at runtime and the sum is unrolled by
+	/// static_integrate<n_points>.
+	/// \code
+	/// auto my_fun = [](double x)->double { return x*x*x + x*x + 3; };
+	/// double result = HBTK::gauss_legendre_integrate<6>(my_fun);
+	/// \endcode
+	template <int n_points, typename Ty, typename TyFunc>
+	auto gauss_legendre_integrate(TyFunc & func) -> decltype(func(Ty(0)) * Ty(0))
+	{
+		static constexpr GaussLegendreTable<n_points, Ty> table = gauss_legendre_table<n_points, Ty>();
+		return static_integrate<n_points>(func, table.points, table.weights);
+	}
+
+
 
 
 
@@ -0,0 +1,100 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+GmshMeshArrays.h
+
+Fast reading of a whole Gmsh .msh (version 2) file into flat arrays.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace HBTK {
+	namespace Gmsh {
+		// The physical names, nodes and elements of a .msh file in contiguous
+		// arrays, in the order they appear in the file. The node tags and 
+		// group tags of element i are
+		//   element_node_tags[element_node_offsets[i] : element_node_offsets[i + 1]]
+		//   element_group_tags[element_group_offsets[i] : element_group_offsets[i + 1]]
+		// where the group tags are all the tags the file gives the element, 
+		// as passed to GmshParser's element functions.
+		struct GmshMeshArrays {
+			std::vector<int> group_tags, group_dimensions;
+			std::vector<std::string> group_names;
+
+			std::vector<int> node_tags;
+			std::vector<double> node_x, node_y, node_z;
+
+			std::vector<int> element_tags, element_types;
+			std::vector<int> element_node_offsets, element_node_tags;
+			std::vector<int> element_group_offsets, element_group_tags;
+
+			int number_of_nodes() const noexcept;
+			int number_of_elements() const noexcept;
+		};
+
+		// A block of consecutive nodes of a .msh file. The arrays have size 
+		// entries, and are only valid during the call they're passed to.
+		// The block starts at section_offset of the section_size nodes of its
+		// $Nodes section, so storage can be reserved on the first block.
+		struct NodeBlock {
+			int size, section_offset, section_size;
+			const int * tags;
+			const double * x, * y, * z;
+		};
+
+		// A block of consecutive elements, with node and group tags in the 
+		// same form as GmshMeshArrays. The offset arrays have size + 1 
+		// entries, starting from zero. section_offset and section_size are
+		// as for NodeBlock.
+		struct ElementBlock {
+			int size, section_offset, section_size;
+			const int * tags, * types;
+			const int * node_offsets, * node_tags;
+			const int * group_offsets, * group_tags;
+		};
+
+		// Functions to pass the contents of a .msh file to. Any may be empty.
+		struct MeshBlockFunctions {
+			std::function<void(int tag, int dimensions, const std::string & name)> physical_name;
+			std::function<void(const NodeBlock &)> nodes;
+			std::function<void(const ElementBlock &)> elements;
+		};
+
+		// Read an ASCII or binary .msh file of version 2. The file is memory 
+		// mapped and parsed without going through streams or strings. 
+		// Sections other than $MeshFormat, $PhysicalNames, $Nodes and 
+		// $Elements are skipped. Throws std::runtime_error on a malformed 
+		// or unsupported file.
+		GmshMeshArrays read_mesh_arrays(const std::string & file_path);
+
+		// As read_mesh_arrays, for the contents of a file already in memory.
+		GmshMeshArrays parse_mesh_arrays(const char * begin, const char * end);
+
+		// Parse the contents of a .msh file already in memory, passing the 
+		// nodes and elements on in blocks of up to block_size rather than 
+		// storing them.
+		void scan_mesh_blocks(const char * begin, const char * end,
+			const MeshBlockFunctions & functions, int block_size = 4096);
+	}
+}
@@ -103,6 +103,10 @@ namespace HBTK {
 			// And lookup group tag by group name
 			std::unordered_map<std::string, int> m_group_names_lookup;
 
+			// add_element from arrays, as used by the parser's block functions.
+			void add_element(int element_tag, int element_id,
+				const int * node_tags, int num_node_tags,
+				const int * group_tags, int num_group_tags);
 		};
 	}
 
@@ -31,6 +31,7 @@ SOFTWARE.
 #include <fstream>
 
 #include "BasicParser.h"
+#include "GmshMeshArrays.h"
 
 namespace HBTK {
 	namespace Gmsh {
@@ -55,6 +56,15 @@ namespace HBTK {
 			// [tag, type, phys_group_tags, node_tags]
 			void add_elem_function(std::function<bool(int, int, std::vector<int>, std::vector<int>)> func);
 
+			// Bulk alternatives to the above, called with blocks of consecutive
+			// nodes or elements in structure of arrays form. Much faster for 
+			// large meshes. The block's arrays are only valid during the call.
+			// Giving either makes the parser stricter: rather than skipping 
+			// malformed lines, it reports the first one to the error stream and 
+			// throws the int -1.
+			void add_node_block_function(std::function<void(const NodeBlock &)> func);
+			void add_elem_block_function(std::function<void(const ElementBlock &)> func);
+
 			// To set the parser going, one of the following may be used (inherited from BasicParser):
 			// void parse(fs::path file_path);
 			// void parse(std::ifstream & input_stream);
@@ -102,6 +112,12 @@ namespace HBTK {
 			std::vector<std::function<bool(int, int, std::string)>> phys_name_funcs;
 			std::vector<std::function<bool(int, double, double, double)>> node_funcs;
 			std::vector<std::function<bool(int, int, std::vector<int>, std::vector<int>)>> elem_funcs;
+			std::vector<std::function<void(const NodeBlock &)>> node_block_funcs;
+			std::vector<std::function<void(const ElementBlock &)>> elem_block_funcs;
+
+			// Parse the whole remaining stream in one go, used when there are 
+			// block functions.
+			void block_parser(std::ifstream & input_stream, std::ostream & error_stream);
 
 			// Parse a line starting with "$".
 			file_section parse_file_section(std::string, file_section);
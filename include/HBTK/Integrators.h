@@ -26,15 +26,25 @@ SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
 
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <limits>
 #include <type_traits>
-#include <stack>
+#include <utility>
+#include <vector>
 
+#include "FixedCapacityStack.h"
 #include "Tolerances.h"
 
 namespace HBTK {
 
+	/// \brief Information about a call to a budgeted adaptive integrator.
+	struct AdaptiveIntegrationReport {
+		int evaluations = 0;		// Number of calls to the integrand.
+		bool converged = true;		// False if the budget or stack ran out.
+	};
+
 	// DECLARATIONS
 
 	template< typename Tf, typename Tp, typename Tw>
@@ -45,21 +55,54 @@ namespace HBTK {
 	auto static_integrate(Tf & func, Tp & points, Tw & weights)
 		 -> decltype(func(points[0]) * weights[0]) ;
 
+	template<typename Tf, typename Tp, typename Tw, std::size_t... Idx>
+	auto static_integrate_unrolled(Tf & func, Tp & points, Tw & weights,
+		std::index_sequence<Idx...>)
+		-> decltype(func(points[0]) * weights[0]);
+
+	template<typename Tf>
+	std::vector<double> static_integrate_batch(Tf & func, const std::vector<double> & points,
+		const std::vector<double> & weights, int num_integrands);
+
+	double pairwise_dot(const double * values, const double * weights, int n);
+
 	template<typename Tf_in, typename Tf, typename Ttol>
 	auto adaptive_trapezoidal_integrate(Tf & func, Ttol tolerance, 
 				Tf_in lower_limit, Tf_in upper_limit)
 		->decltype(func(lower_limit));
 
+	template<typename Tf_in, typename Tf, typename Ttol>
+	auto adaptive_trapezoidal_integrate(Tf & func, Ttol tolerance,
+		Tf_in lower_limit, Tf_in upper_limit, int max_evaluations,
+		AdaptiveIntegrationReport * report = nullptr)
+		->decltype(func(lower_limit));
+
 	template<typename Tf_in, typename Tf, typename Ttol>
 	auto adaptive_simpsons_integrate(Tf & func, Ttol tolerance, 
 		Tf_in lower_limit, Tf_in upper_limit)
 		->decltype(func(lower_limit));
 
+	template<typename Tf_in, typename Tf, typename Ttol>
+	auto adaptive_simpsons_integrate(Tf & func, Ttol tolerance,
+		Tf_in lower_limit, Tf_in upper_limit, int max_evaluations,
+		AdaptiveIntegrationReport * report = nullptr)
+		->decltype(func(lower_limit));
+
+	template<typename Tf_in, typename R_Type, typename Ttol>
+	R_Type gauss_lobatto_stopping_scale(const std::array<R_Type, 13> & y0,
+		Ttol tolerance, Tf_in lower_limit, Tf_in upper_limit);
+
 	template<typename Tf_in, typename Tf, typename Ttol>
 	auto adaptive_gauss_lobatto_integrate(Tf & func, Ttol tolerance,
 		Tf_in lower_limit, Tf_in upper_limit)
 		->decltype(func(lower_limit));
 
+	template<typename Tf_in, typename Tf, typename Ttol>
+	auto adaptive_gauss_lobatto_integrate(Tf & func, Ttol tolerance,
+		Tf_in lower_limit, Tf_in upper_limit, int max_evaluations,
+		AdaptiveIntegrationReport * report = nullptr)
+		->decltype(func(lower_limit));
+
 	// DEFINITIONS
 
 	/// \param func a function/lambda which accepts the value in points as its 
@@ -116,9 +159,8 @@ namespace HBTK {
 	///
 	/// \brief A specialised integrator templated with set number of points.
 	/// 
-	/// By specifying the number of integration points at compile time, it may be
-	/// possible for the compiler to unroll the loop. It may or may not be
-	/// different to normal...
+	/// The number of integration points is given at compile time and the 
+	/// sum is unrolled.
 	///
 	/// It can be used as
 	/// \code
@@ -139,7 +181,92 @@ namespace HBTK {
 	auto static_integrate(Tf & func, Tp & points, Tw & weights)
 		 -> decltype(func(points[0]) * weights[0]) 
 	{
-		return static_integrate(func, points, weights, n_points);
+		static_assert(n_points > 0, "Must integrate with more than 0 points.");
+		return static_integrate_unrolled(func, points, weights, 
+			std::make_index_sequence<n_points - 1>());
+	}
+
+	// Sums func(points[i]) * weights[i] for i in [0, sizeof...(Idx)] in order,
+	// with the loop unrolled by pack expansion.
+	template<typename Tf, typename Tp, typename Tw, std::size_t... Idx>
+	auto static_integrate_unrolled(Tf & func, Tp & points, Tw & weights,
+		std::index_sequence<Idx...>)
+		-> decltype(func(points[0]) * weights[0])
+	{
+		auto accumulator = func(points[0]) * weights[0];
+		using expand = int[];
+		(void)expand{ 0, (accumulator = accumulator 
+			+ func(points[Idx + 1]) * weights[Idx + 1], 0)... };
+		return accumulator;
+	}
+
+
+	/// \param func a function/lambda with signature 
+	/// void(const std::vector<double> & points, std::vector<double> & values)
+	/// that evaluates every integrand at every point.
+	/// \param points quadrature points.
+	/// \param weights quadrature weights.
+	/// \param num_integrands number of integrands evaluated by func.
+	/// \returns a vector of num_integrands integrals.
+	///
+	/// \brief Integrate many integrands with one quadrature in one call.
+	///
+	/// func is called once. values is sized num_integrands * points.size()
+	/// before the call and func should write integrand j at point i to
+	/// values[j * points.size() + i]. This lets func evaluate a whole rule
+	/// with vectorised code, and lets many kernels share one rule. 
+	/// Sums use pairwise accumulation.
+	/// \code
+	/// #include "HBTK/GaussLegendre.h"
+	/// auto quad = HBTK::gauss_legendre(8).get_quadrature();
+	/// auto powers = [](const std::vector<double> & x, std::vector<double> & f) {
+	/// 	int n = (int)x.size();
+	/// 	for (int i = 0; i < n; i++) { 
+	/// 		f[i] = x[i] * x[i];
+	/// 		f[n + i] = x[i] * x[i] * x[i] * x[i];
+	/// 	}
+	/// };
+	/// std::vector<double> results = 
+	///		HBTK::static_integrate_batch(powers, quad.first, quad.second, 2);
+	/// // results = {2/3, 2/5}
+	/// \endcode
+	template<typename Tf>
+	std::vector<double> static_integrate_batch(Tf & func, const std::vector<double> & points,
+		const std::vector<double> & weights, int num_integrands)
+	{
+		assert(points.size() == weights.size());
+		assert(num_integrands > 0);
+		const int n_points = (int)points.size();
+		std::vector<double> values(n_points * num_integrands);
+		func(points, values);
+		assert((int)values.size() == n_points * num_integrands);
+		std::vector<double> results(num_integrands);
+		for (int j = 0; j < num_integrands; j++) {
+			results[j] = pairwise_dot(values.data() + j * n_points, weights.data(), n_points);
+		}
+		return results;
+	}
+
+
+	/// \param values array of length n
+	/// \param weights array of length n
+	/// \param n length of the arrays
+	///
+	/// \brief Sum of values[i] * weights[i] using pairwise summation.
+	///
+	/// Rounding error grows as O(log n) rather than O(n) for a plain loop.
+	/// Short runs are summed with a simple loop that the compiler can 
+	/// vectorise.
+	inline double pairwise_dot(const double * values, const double * weights, int n)
+	{
+		if (n <= 32) {
+			double sum = 0;
+			for (int i = 0; i < n; i++) { sum += values[i] * weights[i]; }
+			return sum;
+		}
+		int half = n / 2;
+		return pairwise_dot(values, weights, half) 
+			+ pairwise_dot(values + half, weights + half, n - half);
 	}
 
 
@@ -150,13 +277,45 @@ namespace HBTK {
 	/// \param upper_limit the upper limit of integration.
 	///
 	/// \brief Evaluate an integral using an adaptive trapezium rule method.
+	///
+	/// Equivalent to the budgeted overload with an unlimited number of 
+	/// evaluations.
 	template<typename Tf_in, typename Tf, typename Ttol>
 	auto adaptive_trapezoidal_integrate(Tf & func, Ttol tolerance, 
 				Tf_in lower_limit, Tf_in upper_limit)
 		->decltype(func(lower_limit))
+	{
+		return adaptive_trapezoidal_integrate(func, tolerance, lower_limit, 
+			upper_limit, std::numeric_limits<int>::max(), nullptr);
+	}
+
+
+	/// \param func a function that takes a single argument of type Tf_in (ie. 
+	/// that of lower and upper limit) and returns a floating point type.
+	/// \param tolerance a floating point relative tolerance.
+	/// \param lower_limit the lower limit of integration.
+	/// \param upper_limit the upper limit of integration.
+	/// \param max_evaluations the maximum number of calls to func.
+	/// \param report if not null, filled with the number of evaluations and
+	/// whether the tolerance was met.
+	///
+	/// \brief Evaluate an integral using an adaptive trapezium rule method 
+	/// with a limit on the number of function evaluations.
+	///
+	/// The work stack is of fixed size and held on the call stack, so no 
+	/// memory is allocated. An interval is only subdivided if the budget 
+	/// can pay for every interval waiting to be evaluated. If the budget or
+	/// stack is exhausted the best estimate is returned and report->converged
+	/// is set to false. The two end point evaluations are always made.
+	template<typename Tf_in, typename Tf, typename Ttol>
+	auto adaptive_trapezoidal_integrate(Tf & func, Ttol tolerance, 
+				Tf_in lower_limit, Tf_in upper_limit, int max_evaluations,
+				AdaptiveIntegrationReport * report)
+		->decltype(func(lower_limit))
 	{
 		assert(tolerance > 0.0);
 		assert(upper_limit > lower_limit);
+		assert(max_evaluations > 0);
 
 		using R_Type = typename std::result_of<Tf(Tf_in)>::type;
 		R_Type result = 0;
@@ -164,8 +323,6 @@ namespace HBTK {
 		R_Type v_sub;
 		Tf_in p_sub;
 
-		int stack_size = 1;
-
 		auto trap = [&](Tf_in x0, Tf_in x1, R_Type f0, R_Type f1)->R_Type {
 			return (x1 - x0)*(f0 + f1) / 2.0;
 		};
@@ -176,38 +333,49 @@ namespace HBTK {
 		} stack_frame;
 
 		stack_frame tmp;
+		FixedCapacityStack<stack_frame, 128> stack;
+		const int evals_per_frame = 1;
+		int evaluations = 2;
+		bool converged = true;
 
-		std::stack<stack_frame> stack;
-
-		stack.emplace(stack_frame{ lower_limit, upper_limit, 
+		stack.push(stack_frame{ lower_limit, upper_limit, 
 									func(lower_limit), func(upper_limit) });
 
 		while (!stack.empty())
 		{
 			tmp = stack.top();
+			stack.pop();
 			assert(tmp.u_lim != tmp.l_lim);
 			p_sub = (tmp.l_lim + tmp.u_lim)*0.5;
 			v_sub = func(p_sub);
+			evaluations += evals_per_frame;
 
 			coarse = trap(tmp.l_lim, tmp.u_lim, tmp.l, tmp.u);
 			fine = trap(tmp.l_lim, p_sub, tmp.l, v_sub)
 				+ trap(p_sub, tmp.u_lim, v_sub, tmp.u);
 
-            if (std::abs(fine - coarse) > (tmp.u_lim - tmp.l_lim) * tolerance)
+			bool refine = std::abs(fine - coarse) > (tmp.u_lim - tmp.l_lim) * tolerance;
+			if (refine && ((p_sub <= tmp.l_lim) || (p_sub >= tmp.u_lim) 
+				|| (stack.size() + 2 > stack.capacity())
+				|| ((int)(stack.size() + 2) * evals_per_frame > max_evaluations - evaluations)))
+			{
+				refine = false;
+				converged = false;
+			}
+			if (refine)
 			{
-				stack.pop();
-				stack.emplace(stack_frame{ tmp.l_lim, p_sub, tmp.l, v_sub });
-				stack.emplace(stack_frame{ p_sub, tmp.u_lim, v_sub, tmp.u, });
-				stack_size += 1;
+				stack.push(stack_frame{ tmp.l_lim, p_sub, tmp.l, v_sub });
+				stack.push(stack_frame{ p_sub, tmp.u_lim, v_sub, tmp.u, });
 			}
 			else
 			{
-				stack.pop();
-				stack_size--;
 				result += fine;
 			}
 		}
-		assert(stack_size == 0);
+		if (report != nullptr) {
+			report->evaluations = evaluations;
+			report->converged = converged;
+		}
 		return result;
 	}
 
@@ -231,14 +399,56 @@ namespace HBTK {
 	/// auto result = HBTK::adaptive_simpsons_integrate(my_f, 1e-10, 0.0, 1.0);
 	/// \endcode
 	///	Uses a simple adaptive composite simpson's rule to evaluated to a given 
-	/// tolerance.	
+	/// tolerance. Equivalent to the budgeted overload with an unlimited 
+	/// number of evaluations.
 	template<typename Tf_in, typename Tf, typename Ttol>
 	auto adaptive_simpsons_integrate(Tf & func, Ttol tolerance, 
 		Tf_in lower_limit, Tf_in upper_limit)
 		->decltype(func(lower_limit))
 	{
+		return adaptive_simpsons_integrate(func, tolerance, lower_limit,
+			upper_limit, std::numeric_limits<int>::max(), nullptr);
+	}
+
+
+	/// \param func a function that takes a single argument of type Tf_in (ie. 
+	/// that of lower and upper limit) and returns a floating point type.
+	/// \param tolerance a floating point relative tolerance.
+	/// \param lower_limit the lower limit of integration.
+	/// \param upper_limit the upper limit of integration.
+	/// \param max_evaluations the maximum number of calls to func.
+	/// \param report if not null, filled with the number of evaluations and
+	/// whether the tolerance was met.
+	///
+	/// \brief Evaluate an integral using an adaptive Simpson's rule method 
+	/// with a limit on the number of function evaluations.
+	///
+	/// The work stack is of fixed size and held on the call stack, so no 
+	/// memory is allocated. The end and centre values of each interval are
+	/// passed on to its children. The eight evaluations of the initial 
+	/// estimate are always made. After that, an interval is only subdivided 
+	/// if the budget can pay for every interval waiting to be evaluated.
+	/// If the budget or stack is exhausted the best estimate is returned and
+	/// report->converged is set to false.
+	/// \code
+	/// #include "HBTK/Integrators.h"
+	/// auto my_f = [](double x)->double { return 1. / (x + 1e-3); };
+	/// HBTK::AdaptiveIntegrationReport report;
+	/// auto result = HBTK::adaptive_simpsons_integrate(my_f, 1e-10, 0.0, 1.0,
+	///		200, &report);
+	/// if (!report.converged) { ... }
+	/// \endcode
+	template<typename Tf_in, typename Tf, typename Ttol>
+	auto adaptive_simpsons_integrate(Tf & func, Ttol tolerance, 
+		Tf_in lower_limit, Tf_in upper_limit, int max_evaluations,
+		AdaptiveIntegrationReport * report)
+		->decltype(func(lower_limit))
+	{
+		// Gander, W. & Gautschi, W. BIT Numerical Mathematics (2000) 40: 84. 
+		// https://doi.org/10.1023/A:1022318402393
 		assert(tolerance > 0.0);
 		assert(lower_limit < upper_limit);
+		assert(max_evaluations > 0);
 
 		using R_Type = typename std::result_of<Tf(Tf_in)>::type;
 		R_Type result = 0;
@@ -257,51 +467,99 @@ namespace HBTK {
 		} stack_frame;
 
 		stack_frame tmp;
-		int stack_size = 1;
-		std::stack<stack_frame> stack;
-
-		stack.emplace(stack_frame{ lower_limit, upper_limit, func(lower_limit), 
-			func(upper_limit), func((upper_limit - lower_limit) / 2.0) });
-
-		R_Type is = (upper_limit - lower_limit) / 8 * (stack.top().l + stack.top().u + stack.top().c
-			+ (func(lower_limit + 0.9501) + func(lower_limit + 0.2311) + func(lower_limit + 0.6068)
-				+ func(lower_limit + 0.4860) + func(lower_limit + 0.8913)) * (upper_limit - lower_limit));
-		is = (std::abs(is) == 0 ? upper_limit - lower_limit : is);
+		FixedCapacityStack<stack_frame, 128> stack;
+		const int evals_per_frame = 2;
+		int evaluations = 8;
+		bool converged = true;
+
+		stack.push(stack_frame{ lower_limit, upper_limit, func(lower_limit), 
+			func(upper_limit), func((upper_limit + lower_limit) / 2) });
+
+		// A rough estimate of the magnitude of the integral, sampled at 
+		// points relative to the interval.
+		const Tf_in width = upper_limit - lower_limit;
+		R_Type is = width / 8 * (stack.top().l + stack.top().u + stack.top().c
+			+ func(lower_limit + (Tf_in)0.9501 * width) + func(lower_limit + (Tf_in)0.2311 * width) 
+			+ func(lower_limit + (Tf_in)0.6068 * width) + func(lower_limit + (Tf_in)0.4860 * width) 
+			+ func(lower_limit + (Tf_in)0.8913 * width));
+		is = (std::abs(is) == 0 ? width : is);
 		is = is * tolerance / HBTK::tolerance<R_Type>();
 
 		while (!stack.empty())
 		{
 			tmp = stack.top();
+			stack.pop();
 			p_cent = (tmp.l_lim + tmp.u_lim) * 0.5;
 			p_sub_l = tmp.l_lim + (tmp.u_lim - tmp.l_lim) * 0.25;
 			p_sub_u = tmp.l_lim + (tmp.u_lim - tmp.l_lim) * 0.75;
 			v_sub_l = func(p_sub_l);
 			v_sub_u = func(p_sub_u);
+			evaluations += evals_per_frame;
 
 			coarse = simp(tmp.l_lim, tmp.u_lim, tmp.l, tmp.c, tmp.u);
 			fine = simp(tmp.l_lim, p_cent, tmp.l, v_sub_l, tmp.c)
 				+ simp(p_cent, tmp.u_lim, tmp.c, v_sub_u, tmp.u);
 			coarse = (16.0 * fine - coarse) / 15.0;
 
-			if ((is + (coarse - fine) != is) || (p_cent <= tmp.l_lim) || (p_cent >= tmp.u_lim))
+			bool refine = is + (coarse - fine) != is;
+			if (refine && ((p_sub_l <= tmp.l_lim) || (p_sub_u >= tmp.u_lim)
+				|| (stack.size() + 2 > stack.capacity())
+				|| ((int)(stack.size() + 2) * evals_per_frame > max_evaluations - evaluations)))
 			{
-				stack.pop();
-				stack.emplace(stack_frame{ tmp.l_lim, p_cent, tmp.l, tmp.c, v_sub_l });
-				stack.emplace(stack_frame{ p_cent, tmp.u_lim, tmp.c, tmp.u, v_sub_u });
-				stack_size += 1;
+				refine = false;
+				converged = false;
+			}
+			if (refine)
+			{
+				stack.push(stack_frame{ tmp.l_lim, p_cent, tmp.l, tmp.c, v_sub_l });
+				stack.push(stack_frame{ p_cent, tmp.u_lim, tmp.c, tmp.u, v_sub_u });
 			}
 			else
 			{
-				stack.pop();
-				stack_size--;
 				result += coarse;
 			}
 		}
-		assert(stack_size == 0);
+		if (report != nullptr) {
+			report->evaluations = evaluations;
+			report->converged = converged;
+		}
 		return result;
 	}
 
 
+	/// \param y0 the integrand at the 13 Gauss-Lobatto-Kronrod nodes of the
+	/// interval, in ascending order.
+	/// \param tolerance a floating point relative tolerance.
+	/// \param lower_limit the lower limit of integration.
+	/// \param upper_limit the upper limit of integration.
+	///
+	/// \brief The scale used in the Gauss-Lobatto stopping criterion 
+	/// is + (fine - coarse) == is.
+	template<typename Tf_in, typename R_Type, typename Ttol>
+	R_Type gauss_lobatto_stopping_scale(const std::array<R_Type, 13> & y0,
+		Ttol tolerance, Tf_in lower_limit, Tf_in upper_limit)
+	{
+		Tf_in h0 = (upper_limit - lower_limit) / 2;
+		R_Type coarse = (h0 / 6) * (y0[0] + y0[12] + 5 * (y0[4] + y0[8]));
+		R_Type fine = (h0 / 1470)*(77 * (y0[0] + y0[12]) + 432 * (y0[2] + y0[10]) + 
+			625 * (y0[4] + y0[8]) + 672 * y0[6]);
+		R_Type is = h0 * (0.0158271919734802*(y0[0] + y0[12]) + 0.0942738402188500
+			*(y0[1] + y0[11]) + 0.155071987336585*(y0[2] + y0[10]) + 
+			0.188821573960182*(y0[3] + y0[9]) + 0.199773405226859
+			*(y0[4] + y0[8]) + 0.224926465333340*(y0[5] + y0[7])
+			+ 0.242611071901408*y0[6]);
+		int s = (is >= 0.0 * R_Type() ? 1 : -1);
+        R_Type err_fine = std::abs(fine - is);
+        R_Type err_coarse = std::abs(coarse - is);
+		R_Type R = (R_Type)1.0;
+		if (err_coarse != 0.0 * R_Type()) R = err_fine / err_coarse;
+		if ((R > 0) && (R < 1)) tolerance = tolerance / R;
+        is = s * std::abs(is) * tolerance / HBTK::tolerance<R_Type>();
+		if (is == 0) is = upper_limit - lower_limit;
+		return is;
+	}
+
+
 	/// \param func a function that takes a single argument of type Tf_in (ie. 
 	/// that of lower and upper limit) and returns a floating point type.
 	/// \param tolerance a floating point relative tolerance.
@@ -318,16 +576,49 @@ namespace HBTK {
 	/// auto result = HBTK::adaptive_gauss_lobatto_integrate(my_f, 1e-10, 0.0, 1.0);
 	/// \endcode
 	///	Uses an adaptive Gauss-Lobatto quadrature to integrate my func over
-	/// given range. Based on Gander and Gautschi, BIT Numer. Math. 2000
+	/// given range. Based on Gander and Gautschi, BIT Numer. Math. 2000. 
+	/// Equivalent to the budgeted overload with an unlimited number of 
+	/// evaluations.
 	template<typename Tf_in, typename Tf, typename Ttol>
 	auto adaptive_gauss_lobatto_integrate(Tf & func, Ttol tolerance,
 		Tf_in lower_limit, Tf_in upper_limit)
 		->decltype(func(lower_limit))
+	{
+		return adaptive_gauss_lobatto_integrate(func, tolerance, lower_limit,
+			upper_limit, std::numeric_limits<int>::max(), nullptr);
+	}
+
+
+	/// \param func a function that takes a single argument of type Tf_in (ie. 
+	/// that of lower and upper limit) and returns a floating point type.
+	/// \param tolerance a floating point relative tolerance.
+	/// \param lower_limit the lower limit of integration.
+	/// \param upper_limit the upper limit of integration.
+	/// \param max_evaluations the maximum number of calls to func.
+	/// \param report if not null, filled with the number of evaluations and
+	/// whether the tolerance was met.
+	///
+	/// \brief Evaluate an integral using an adaptive Gauss-Lobatto method
+	/// with a limit on the number of function evaluations.
+	///
+	/// The work stack is of fixed size and held on the call stack, so no 
+	/// memory is allocated. The 13 evaluations of the initial Kronrod 
+	/// estimate are always made, and five of them are reused for the first
+	/// subdivision. After that, an interval is only subdivided if the budget
+	/// can pay for every interval waiting to be evaluated. If the budget or 
+	/// stack is exhausted the best estimate is returned and 
+	/// report->converged is set to false.
+	template<typename Tf_in, typename Tf, typename Ttol>
+	auto adaptive_gauss_lobatto_integrate(Tf & func, Ttol tolerance,
+		Tf_in lower_limit, Tf_in upper_limit, int max_evaluations,
+		AdaptiveIntegrationReport * report)
+		->decltype(func(lower_limit))
 	{
 		// Gander, W. & Gautschi, W. BIT Numerical Mathematics (2000) 40: 84. 
 		// https://doi.org/10.1023/A:1022318402393
 		assert(tolerance > 0.0);
 		assert(lower_limit < upper_limit);
+		assert(max_evaluations > 0);
 
 		using R_Type = typename std::result_of<Tf(Tf_in)>::type;
 		R_Type result = 0;
@@ -346,23 +637,7 @@ namespace HBTK {
 			func(m0 + beta * h0), func(m0 + x2 * h0), func(m0 + alpha * h0),
 			func(m0 + x1 * h0), func(upper_limit) };
 
-		R_Type fa(y0[0]), fb(y0[12]);
-		coarse = (h0 / 6) * (y0[0] + y0[12] + 5 * (y0[4] + y0[8]));
-		fine = (h0 / 1470)*(77 * (y0[0] + y0[12]) + 432 * (y0[2] + y0[10]) + 
-			625 * (y0[4] + y0[8]) + 672 * y0[6]);
-		R_Type is = h0 * (0.0158271919734802*(y0[0] + y0[12]) + 0.0942738402188500
-			*(y0[1] + y0[11]) + 0.155071987336585*(y0[2] + y0[10]) + 
-			0.188821573960182*(y0[3] + y0[9]) + 0.199773405226859
-			*(y0[4] + y0[8]) + 0.224926465333340*(y0[5] + y0[7])
-			+ 0.242611071901408*y0[6]);
-		int s = (is >= 0.0 * R_Type() ? 1 : -1);
-        R_Type err_fine = std::abs(fine - is);
-        R_Type err_coarse = std::abs(coarse - is);
-		R_Type R = (R_Type)1.0;
-		if (err_coarse != 0.0 * R_Type()) R = err_fine / err_coarse;
-		if ((R > 0) && (R < 1)) tolerance = tolerance / R;
-        is = s * std::abs(is) * tolerance / HBTK::tolerance<R_Type>();
-		if (is == 0) is = upper_limit - lower_limit;
+		R_Type is = gauss_lobatto_stopping_scale(y0, tolerance, lower_limit, upper_limit);
 
 		// And now onto the adaptive bit - adaptlobstp(...)
 
@@ -371,15 +646,16 @@ namespace HBTK {
 			R_Type l, u;		// l(ower), u(pper)
 		} stack_frame;
 
-		stack_frame tmp;
-		int stack_size = 1;
-		std::stack<stack_frame> stack;
-
-		stack.emplace(stack_frame{ lower_limit, upper_limit, y0[0], y0[12] });
+		FixedCapacityStack<stack_frame, 256> stack;
+		const int evals_per_frame = 5;
+		int evaluations = 13;
+		bool converged = true;
 
-		while (!stack.empty())
+		// Either accept the estimate for an interval or push its six 
+		// subintervals. fmll, fml, fm, fmr, fmrr are the interior values.
+		auto step = [&](const stack_frame & tmp, R_Type fmll, R_Type fml, 
+			R_Type fm, R_Type fmr, R_Type fmrr)
 		{
-			tmp = stack.top();
 			Tf_in ml, mll, m, mr, mrr, h;
 			h = (tmp.u_lim - tmp.l_lim) / 2;
 			m = (tmp.u_lim + tmp.l_lim) / 2;
@@ -387,34 +663,54 @@ namespace HBTK {
 			mrr = m + alpha * h;
 			ml = m - beta * h;
 			mr = m + beta * h;
-			R_Type fml, fmll, fm, fmr, fmrr;
-			fml = func(ml);
-			fmll = func(mll);
-			fm = func(m);
-			fmr = func(mr);
-			fmrr = func(mrr);
 			coarse = (h / 6.) * (tmp.l + tmp.u + 5.0 * (fml + fmr));
 			fine = (h / 1470.) * (77 * (tmp.l + tmp.u) + 432 * (fmll + fmrr) 
 				+ 625 * (fml + fmr) + 672 * fm);
-			if ((is + (fine - coarse) != is) || (mll <= tmp.l_lim) || (mrr >= tmp.u_lim))
+			bool refine = is + (fine - coarse) != is;
+			if (refine && ((mll <= tmp.l_lim) || (mrr >= tmp.u_lim)
+				|| (stack.size() + 6 > stack.capacity())
+				|| ((int)(stack.size() + 6) * evals_per_frame > max_evaluations - evaluations)))
 			{
-				stack.pop();
-				stack.emplace(stack_frame{ tmp.l_lim, mll, tmp.l, fmll });
-				stack.emplace(stack_frame{ mll, ml, fmll, fml});
-				stack.emplace(stack_frame{ ml, m, fml, fm });
-				stack.emplace(stack_frame{ m, mr, fm, fmr });
-				stack.emplace(stack_frame{ mr, mrr, fmr, fmrr });
-				stack.emplace(stack_frame{ mrr, tmp.u_lim, fmrr, tmp.u });
-				stack_size += 5;
+				refine = false;
+				converged = false;
+			}
+			if (refine)
+			{
+				stack.push(stack_frame{ tmp.l_lim, mll, tmp.l, fmll });
+				stack.push(stack_frame{ mll, ml, fmll, fml});
+				stack.push(stack_frame{ ml, m, fml, fm });
+				stack.push(stack_frame{ m, mr, fm, fmr });
+				stack.push(stack_frame{ mr, mrr, fmr, fmrr });
+				stack.push(stack_frame{ mrr, tmp.u_lim, fmrr, tmp.u });
 			}
 			else
 			{
-				stack.pop();
-				stack_size -= 1;
 				result += fine;
 			}
+		};
+
+		// The first interval's interior points were already evaluated in y0.
+		step(stack_frame{ lower_limit, upper_limit, y0[0], y0[12] },
+			y0[2], y0[4], y0[6], y0[8], y0[10]);
+
+		while (!stack.empty())
+		{
+			stack_frame tmp = stack.top();
+			stack.pop();
+			Tf_in h = (tmp.u_lim - tmp.l_lim) / 2;
+			Tf_in m = (tmp.u_lim + tmp.l_lim) / 2;
+			R_Type fmll = func(m - alpha * h);
+			R_Type fml = func(m - beta * h);
+			R_Type fm = func(m);
+			R_Type fmr = func(m + beta * h);
+			R_Type fmrr = func(m + alpha * h);
+			evaluations += evals_per_frame;
+			step(tmp, fmll, fml, fm, fmr, fmrr);
+		}
+		if (report != nullptr) {
+			report->evaluations = evaluations;
+			report->converged = converged;
 		}
-		assert(stack_size == 0);
 		return result;
 	}
 
@@ -26,6 +26,7 @@ SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
 #include <cassert>
+#include <utility>
 #include <vector>
 
 namespace HBTK {
@@ -34,14 +35,54 @@ namespace HBTK {
 	// Linearly interpolates query input value, to give a result based on reference results, 
 	// interpolated lineary.
 	template<typename TyIn, typename TyResult>
-	TyResult linear_interpolate(std::vector<TyIn> reference_inputs,
-		std::vector<TyResult> reference_results, TyIn query_input);
+	TyResult linear_interpolate(const std::vector<TyIn> & reference_inputs,
+		const std::vector<TyResult> & reference_results, TyIn query_input);
 
 	// Reference_inputs is assumed to be sorted ascending. Returns nearest if out of bounds.
 	// Returns the nearest known result to our input.
 	template<typename TyIn, typename TyResult>
-	TyResult nearest_interpolate(std::vector<TyIn> reference_inputs,
-		std::vector<TyResult> reference_results, TyIn query_input);
+	TyResult nearest_interpolate(const std::vector<TyIn> & reference_inputs,
+		const std::vector<TyResult> & reference_results, TyIn query_input);
+
+	// Reference_inputs is assumed to be sorted ascending. Returns the index of the
+	// last reference input <= query_input, or -1 if there isn't one. The search 
+	// "hunts" outwards from guess, so is cheap if the answer is near guess.
+	// A guess outside [-1, size() - 1] gives a plain bisection.
+	template<typename TyIn>
+	int hunt_lower_index(const std::vector<TyIn> & reference_inputs,
+		TyIn query_input, int guess);
+
+	// An object that owns a table of reference inputs and results for 
+	// repeated interpolation. Reference inputs must be sorted ascending.
+	// Out of bounds queries return the nearest end value. Queries in
+	// a vector are bracketed starting from the previous query's bracket, so
+	// resampling a table at monotone inputs is O(n).
+	template<typename TyIn, typename TyResult>
+	class Interpolator {
+	public:
+		Interpolator(std::vector<TyIn> reference_inputs, 
+			std::vector<TyResult> reference_results);
+		~Interpolator();
+
+		// Linear interpolation
+		TyResult linear(TyIn query_input) const;
+		std::vector<TyResult> linear(const std::vector<TyIn> & query_inputs) const;
+
+		// The nearest known result.
+		TyResult nearest(TyIn query_input) const;
+		std::vector<TyResult> nearest(const std::vector<TyIn> & query_inputs) const;
+
+		const std::vector<TyIn> & reference_inputs() const;
+		const std::vector<TyResult> & reference_results() const;
+
+	private:
+		std::vector<TyIn> m_reference_inputs;
+		std::vector<TyResult> m_reference_results;
+
+		// Interpolate given the index from hunt_lower_index.
+		TyResult linear_at(TyIn query_input, int lower_known) const;
+		TyResult nearest_at(TyIn query_input, int lower_known) const;
+	};
 }
 
 
@@ -49,18 +90,13 @@ namespace HBTK {
 namespace HBTK {
 
 	template<typename TyIn, typename TyResult>
-	TyResult linear_interpolate(std::vector<TyIn> reference_inputs, 
-		std::vector<TyResult> reference_results, TyIn query_input)
+	TyResult linear_interpolate(const std::vector<TyIn> & reference_inputs, 
+		const std::vector<TyResult> & reference_results, TyIn query_input)
 	{
 		assert(reference_inputs.size() == reference_results.size());
 		TyResult interpolated_value;
 
-		int lower_known = -1;
-		for (int idx = 0; idx < (int)reference_inputs.size(); idx++) {
-			if (query_input >= reference_inputs[idx]) {
-				lower_known = idx;
-			}
-		}
+		int lower_known = hunt_lower_index(reference_inputs, query_input, -2);
 
 		if ((lower_known != -1) && (lower_known != (int)reference_inputs.size() - 1)) {
 			double fraction = (query_input - reference_inputs[lower_known]) / 
@@ -79,23 +115,19 @@ namespace HBTK {
 	}
 
 	template<typename TyIn, typename TyResult>
-	TyResult nearest_interpolate(std::vector<TyIn> reference_inputs, std::vector<TyResult> reference_results, TyIn query_input)
+	TyResult nearest_interpolate(const std::vector<TyIn> & reference_inputs, 
+		const std::vector<TyResult> & reference_results, TyIn query_input)
 	{
 		assert(reference_inputs.size() == reference_results.size());
 		TyResult interpolated_value;
 
-		int lower_known = -1;
-		for (int idx = 0; idx < (int)reference_inputs.size(); idx++) {
-			if (query_input >= reference_inputs[idx]) {
-				lower_known = idx;
-			}
-		}
+		int lower_known = hunt_lower_index(reference_inputs, query_input, -2);
 
 		if ((lower_known != -1) && (lower_known != (int)reference_inputs.size() - 1)) {
 			double distance_to_lower = query_input - reference_inputs[lower_known];
 			double distance_to_upper = reference_inputs[lower_known + 1] - query_input;
 			interpolated_value = (distance_to_lower < distance_to_upper ?
-				distance_to_lower : distance_to_upper);
+				reference_results[lower_known] : reference_results[lower_known + 1]);
 		}
 		else if (lower_known == -1) {
 			interpolated_value = reference_results[0];
@@ -107,5 +139,137 @@ namespace HBTK {
 		return interpolated_value;
 	}
 
-}
+	template<typename TyIn>
+	int hunt_lower_index(const std::vector<TyIn> & reference_inputs,
+		TyIn query_input, int guess)
+	{
+		// Based on Numerical Recipes "hunt". lo and hi bracket the answer,
+		// with -1 and size() acting as sentinels.
+		const int n = (int)reference_inputs.size();
+		int lo, hi, step = 1;
+		if (guess < -1 || guess > n - 1) {
+			lo = -1;
+			hi = n;
+		}
+		else if (guess == -1 || reference_inputs[guess] <= query_input) {
+			// Hunt upwards.
+			lo = guess;
+			hi = lo + step;
+			while (hi < n && reference_inputs[hi] <= query_input) {
+				lo = hi;
+				step *= 2;
+				hi = lo + step;
+			}
+			if (hi > n) { hi = n; }
+		}
+		else {
+			// Hunt downwards.
+			hi = guess;
+			lo = hi - step;
+			while (lo >= 0 && reference_inputs[lo] > query_input) {
+				hi = lo;
+				step *= 2;
+				lo = hi - step;
+			}
+			if (lo < -1) { lo = -1; }
+		}
+		// Bisection.
+		while (hi - lo > 1) {
+			int mid = (hi + lo) / 2;
+			if (reference_inputs[mid] <= query_input) { lo = mid; }
+			else { hi = mid; }
+		}
+		return lo;
+	}
+
+	template<typename TyIn, typename TyResult>
+	inline Interpolator<TyIn, TyResult>::Interpolator(std::vector<TyIn> reference_inputs, 
+		std::vector<TyResult> reference_results)
+		: m_reference_inputs(std::move(reference_inputs)),
+		m_reference_results(std::move(reference_results))
+	{
+		assert(m_reference_inputs.size() == m_reference_results.size());
+		assert(m_reference_inputs.size() > 0);
+	}
+
+	template<typename TyIn, typename TyResult>
+	inline Interpolator<TyIn, TyResult>::~Interpolator()
+	{
+	}
+
+	template<typename TyIn, typename TyResult>
+	inline TyResult Interpolator<TyIn, TyResult>::linear(TyIn query_input) const
+	{
+		return linear_at(query_input, hunt_lower_index(m_reference_inputs, query_input, -2));
+	}
+
+	template<typename TyIn, typename TyResult>
+	inline std::vector<TyResult> Interpolator<TyIn, TyResult>::linear(
+		const std::vector<TyIn> & query_inputs) const
+	{
+		std::vector<TyResult> results;
+		results.reserve(query_inputs.size());
+		int lower_known = -2;
+		for (const TyIn & query_input : query_inputs) {
+			lower_known = hunt_lower_index(m_reference_inputs, query_input, lower_known);
+			results.push_back(linear_at(query_input, lower_known));
+		}
+		return results;
+	}
+
+	template<typename TyIn, typename TyResult>
+	inline TyResult Interpolator<TyIn, TyResult>::nearest(TyIn query_input) const
+	{
+		return nearest_at(query_input, hunt_lower_index(m_reference_inputs, query_input, -2));
+	}
+
+	template<typename TyIn, typename TyResult>
+	inline std::vector<TyResult> Interpolator<TyIn, TyResult>::nearest(
+		const std::vector<TyIn> & query_inputs) const
+	{
+		std::vector<TyResult> results;
+		results.reserve(query_inputs.size());
+		int lower_known = -2;
+		for (const TyIn & query_input : query_inputs) {
+			lower_known = hunt_lower_index(m_reference_inputs, query_input, lower_known);
+			results.push_back(nearest_at(query_input, lower_known));
+		}
+		return results;
+	}
 
+	template<typename TyIn, typename TyResult>
+	inline const std::vector<TyIn> & Interpolator<TyIn, TyResult>::reference_inputs() const
+	{
+		return m_reference_inputs;
+	}
+
+	template<typename TyIn, typename TyResult>
+	inline const std::vector<TyResult> & Interpolator<TyIn, TyResult>::reference_results() const
+	{
+		return m_reference_results;
+	}
+
+	template<typename TyIn, typename TyResult>
+	inline TyResult Interpolator<TyIn, TyResult>::linear_at(TyIn query_input, int lower_known) const
+	{
+		const std::vector<TyIn> & x = m_reference_inputs;
+		const std::vector<TyResult> & y = m_reference_results;
+		if (lower_known == -1) { return y[0]; }
+		if (lower_known == (int)x.size() - 1) { return y.back(); }
+		double fraction = (query_input - x[lower_known]) /
+			(x[lower_known + 1] - x[lower_known]);
+		return (y[lower_known + 1] - y[lower_known]) * fraction + y[lower_known];
+	}
+
+	template<typename TyIn, typename TyResult>
+	inline TyResult Interpolator<TyIn, TyResult>::nearest_at(TyIn query_input, int lower_known) const
+	{
+		const std::vector<TyIn> & x = m_reference_inputs;
+		const std::vector<TyResult> & y = m_reference_results;
+		if (lower_known == -1) { return y[0]; }
+		if (lower_known == (int)x.size() - 1) { return y.back(); }
+		double distance_to_lower = query_input - x[lower_known];
+		double distance_to_upper = x[lower_known + 1] - query_input;
+		return distance_to_lower < distance_to_upper ? y[lower_known] : y[lower_known + 1];
+	}
+}
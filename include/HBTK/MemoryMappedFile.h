@@ -0,0 +1,61 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+MemoryMappedFile.h
+
+Read only access to the whole of a file through the virtual memory system.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <string>
+
+namespace HBTK {
+	// A file mapped read only into memory. The operating system pages the 
+	// file in as it is read, so nothing is copied into a buffer first. The 
+	// mapping is released on destruction.
+	class MemoryMappedFile {
+	public:
+		MemoryMappedFile();
+		// Throws std::runtime_error if the file can't be opened or mapped.
+		explicit MemoryMappedFile(const std::string & file_path);
+		~MemoryMappedFile();
+
+		MemoryMappedFile(const MemoryMappedFile &) = delete;
+		MemoryMappedFile & operator=(const MemoryMappedFile &) = delete;
+		MemoryMappedFile(MemoryMappedFile && other) noexcept;
+		MemoryMappedFile & operator=(MemoryMappedFile && other) noexcept;
+
+		// The contents of the file. Not null terminated.
+		const char * data() const noexcept;
+		size_t size() const noexcept;
+
+	private:
+		const char * m_data;
+		size_t m_size;
+#ifdef _WIN32
+		void * m_file_handle;
+		void * m_mapping_handle;
+#endif
+
+		void release() noexcept;
+	};
+}
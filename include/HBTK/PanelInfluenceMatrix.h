@@ -0,0 +1,95 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+PanelInfluenceMatrix.h
+
+Assemble the influence matrices of many 2D vortex panels at once.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "DenseMatrix.h"
+
+namespace HBTK {
+	// Straight 2D panels with the frame of each panel computed once. Panel 
+	// i runs from (x0[i], y0[i]) to (x1[i], y1[i]). Its local x axis points 
+	// along the panel, and its normal is the local x axis rotated 90 degrees
+	// anticlockwise.
+	class PanelGeometry2D {
+	public:
+		PanelGeometry2D();
+		PanelGeometry2D(const std::vector<double> & x0, const std::vector<double> & y0,
+			const std::vector<double> & x1, const std::vector<double> & y1);
+		// Panels joining consecutive nodes of a polyline.
+		static PanelGeometry2D from_polyline(const std::vector<double> & x_nodes, 
+			const std::vector<double> & y_nodes);
+
+		int size() const;
+
+		const std::vector<double> & x0() const;
+		const std::vector<double> & y0() const;
+		const std::vector<double> & x1() const;
+		const std::vector<double> & y1() const;
+		const std::vector<double> & length() const;
+		// Components of the unit vector along each panel.
+		const std::vector<double> & cos_angle() const;
+		const std::vector<double> & sin_angle() const;
+
+		std::vector<double> x_midpoint() const;
+		std::vector<double> y_midpoint() const;
+		std::vector<double> x_normal() const;
+		std::vector<double> y_normal() const;
+
+	private:
+		std::vector<double> m_x0, m_y0, m_x1, m_y1;
+		std::vector<double> m_length, m_cos, m_sin;
+	};
+
+	namespace ConstantVortexDistribution {
+		// Velocities at the measurement points per unit strength of each 
+		// panel. The matrices have a row per point and a column per panel.
+		void influence_matrices(const PanelGeometry2D & panels,
+			const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+			DenseMatrix & u_influence, DenseMatrix & v_influence, int num_threads = 1);
+
+		// Velocity in the direction (x_dir[i], y_dir[i]) at each measurement 
+		// point per unit strength of each panel.
+		DenseMatrix directional_influence_matrix(const PanelGeometry2D & panels,
+			const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+			const std::vector<double> & x_dir, const std::vector<double> & y_dir, 
+			int num_threads = 1);
+	}
+
+	namespace LinearVortexDistribution {
+		// As ConstantVortexDistribution, but each panel's strength varies 
+		// linearly between its values at the panel's ends. Columns 2j and 
+		// 2j+1 are per unit strength at the start and end of panel j.
+		void influence_matrices(const PanelGeometry2D & panels,
+			const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+			DenseMatrix & u_influence, DenseMatrix & v_influence, int num_threads = 1);
+
+		DenseMatrix directional_influence_matrix(const PanelGeometry2D & panels,
+			const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+			const std::vector<double> & x_dir, const std::vector<double> & y_dir,
+			int num_threads = 1);
+	}
+}
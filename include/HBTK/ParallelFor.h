@@ -0,0 +1,85 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+ParallelFor.h
+
+Run many independent tasks over several threads.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace HBTK {
+
+	/// \param num_tasks the number of tasks. Tasks are numbered 0 to num_tasks-1.
+	/// \param num_threads the maximum number of threads to use.
+	/// \param task a function/lambda with signature void(int task_index).
+	///
+	/// \brief Run task(i) for every i in [0, num_tasks) on several threads.
+	///
+	/// Threads take the next task from a shared atomic counter as they 
+	/// finish, so uneven task costs are balanced between threads. The 
+	/// calling thread is one of the workers.
+	///
+	/// If a task throws, no further tasks are started, the threads are 
+	/// joined, and the first exception caught is rethrown on the calling 
+	/// thread. Tasks already running on other threads run to completion.
+	template<typename Tf>
+	void parallel_for(int num_tasks, int num_threads, Tf && task)
+	{
+		assert(num_threads > 0);
+		num_threads = std::min(num_threads, num_tasks);
+		if (num_threads <= 1) {
+			for (int i = 0; i < num_tasks; i++) { task(i); }
+			return;
+		}
+		std::atomic<int> next_task(0);
+		std::exception_ptr first_error;
+		std::mutex error_mutex;
+		auto worker = [&]() {
+			try {
+				for (int i = next_task++; i < num_tasks; i = next_task++) { task(i); }
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(error_mutex);
+				if (!first_error) { first_error = std::current_exception(); }
+				next_task = num_tasks;
+			}
+		};
+		std::vector<std::thread> threads;
+		try {
+			for (int t = 1; t < num_threads; t++) { threads.emplace_back(worker); }
+		}
+		catch (const std::system_error &) {
+			// Couldn't start a thread: carry on with those we have.
+		}
+		worker();
+		for (auto & thread : threads) { thread.join(); }
+		if (first_error) { std::rethrow_exception(first_error); }
+	}
+}
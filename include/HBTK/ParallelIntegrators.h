@@ -0,0 +1,212 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+ParallelIntegrators.h
+
+Adaptive integration of expensive functions using many threads.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "Integrators.h"
+#include "ParallelFor.h"
+
+namespace HBTK {
+
+	// DECLARATIONS
+
+	template<typename Tf_in, typename Tf, typename Ttol>
+	auto parallel_adaptive_gauss_lobatto_integrate(Tf & func, Ttol tolerance,
+		Tf_in lower_limit, Tf_in upper_limit, int num_threads,
+		int max_evaluations = std::numeric_limits<int>::max(),
+		AdaptiveIntegrationReport * report = nullptr)
+		->decltype(func(lower_limit));
+
+	// DEFINITIONS
+
+	/// \param func a thread safe function that takes a single argument of 
+	/// type Tf_in (ie. that of lower and upper limit) and returns a floating 
+	/// point type.
+	/// \param tolerance a floating point relative tolerance.
+	/// \param lower_limit the lower limit of integration.
+	/// \param upper_limit the upper limit of integration.
+	/// \param num_threads the number of threads used to evaluate func.
+	/// \param max_evaluations the maximum number of calls to func.
+	/// \param report if not null, filled with the number of evaluations and
+	/// whether the tolerance was met.
+	///
+	/// \brief Evaluate an integral using an adaptive Gauss-Lobatto method 
+	/// with the evaluations of func spread over many threads.
+	///
+	/// Uses the same rule and stopping criterion as 
+	/// adaptive_gauss_lobatto_integrate. When neither integrator runs out 
+	/// of evaluations or subdivision depth, they subdivide the same 
+	/// intervals and make the same number of evaluations. Otherwise they 
+	/// stop at different intervals, since this refines breadth first and 
+	/// the serial integrator depth first. Subintervals are refined 
+	/// breadth first: every evaluation needed by the pending subintervals is
+	/// made in parallel, then the subintervals are accepted or split in 
+	/// order. The accepted estimates are summed from lower to upper limit, 
+	/// so the result does not depend on num_threads. It may differ in the 
+	/// last bits from adaptive_gauss_lobatto_integrate, which sums in a 
+	/// different order.
+	///
+	/// This is only worthwhile when func is expensive, for example when 
+	/// each call is itself an influence integral.
+	/// \code
+	/// #include "HBTK/ParallelIntegrators.h"
+	/// auto my_f = [](double x)->double { return expensive_kernel(x); };
+	/// auto result = HBTK::parallel_adaptive_gauss_lobatto_integrate(
+	///		my_f, 1e-10, 0.0, 1.0, 8);
+	/// \endcode
+	template<typename Tf_in, typename Tf, typename Ttol>
+	auto parallel_adaptive_gauss_lobatto_integrate(Tf & func, Ttol tolerance,
+		Tf_in lower_limit, Tf_in upper_limit, int num_threads,
+		int max_evaluations, AdaptiveIntegrationReport * report)
+		->decltype(func(lower_limit))
+	{
+		assert(tolerance > 0.0);
+		assert(lower_limit < upper_limit);
+		assert(num_threads > 0);
+		assert(max_evaluations > 0);
+
+		using R_Type = typename std::result_of<Tf(Tf_in)>::type;
+		const Tf_in alpha = (Tf_in)sqrt(2. / 3.);
+		const Tf_in beta = (Tf_in)(1. / sqrt(5.));
+		const Tf_in x1 = (Tf_in) 0.942882415695480;
+		const Tf_in x2 = (Tf_in) 0.641853342345781;
+		const Tf_in x3 = (Tf_in) 0.236383199662150;
+		const std::array<Tf_in, 13> kronrod_nodes = { -1, -x1, -alpha, -x2,
+			-beta, -x3, 0, x3, beta, x2, alpha, x1, 1 };
+		const std::array<Tf_in, 5> lobatto_nodes = { -alpha, -beta, 0, beta, alpha };
+
+		Tf_in h0 = (upper_limit - lower_limit) / 2;
+		Tf_in m0 = (upper_limit + lower_limit) / 2;
+		std::array<R_Type, 13> y0;
+		auto initial_task = [&](int i) {
+			Tf_in x = (i == 0 ? lower_limit : (i == 12 ? upper_limit : 
+				m0 + kronrod_nodes[i] * h0));
+			y0[i] = func(x);
+		};
+		parallel_for(13, num_threads, initial_task);
+		R_Type is = gauss_lobatto_stopping_scale(y0, tolerance, lower_limit, upper_limit);
+
+		// Subintervals in order from lower to upper limit. A piece is 
+		// either accepted, with its estimate in value, or pending.
+		typedef struct piece {
+			Tf_in l_lim, u_lim;	// l(ower)_lim(it), u(pper)_lim(it)
+			R_Type l, u;		// l(ower), u(pper)
+			bool accepted;
+			R_Type value;
+		} piece;
+
+		std::vector<piece> pieces, next_pieces;
+		std::vector<int> pending;	// Indices of pending pieces.
+		std::vector<R_Type> interior;	// 5 values per pending piece.
+		const int evals_per_piece = 5;
+		int evaluations = 13;
+		bool converged = true;
+
+		pieces.push_back(piece{ lower_limit, upper_limit, y0[0], y0[12], false, R_Type(0) });
+		pending.push_back(0);
+		// The first interval's interior points were already evaluated in y0.
+		interior = { y0[2], y0[4], y0[6], y0[8], y0[10] };
+
+		auto interior_task = [&](int k) {
+			const piece & p = pieces[pending[k / evals_per_piece]];
+			Tf_in h = (p.u_lim - p.l_lim) / 2;
+			Tf_in m = (p.u_lim + p.l_lim) / 2;
+			interior[k] = func(m + lobatto_nodes[k % evals_per_piece] * h);
+		};
+
+		bool first_round = true;
+		while (!pending.empty())
+		{
+			if (!first_round) {
+				interior.resize(pending.size() * evals_per_piece);
+				parallel_for((int)interior.size(), num_threads, interior_task);
+				evaluations += (int)interior.size();
+			}
+			first_round = false;
+
+			next_pieces.clear();
+			int num_scheduled = 0;
+			int pending_idx = 0;
+			for (const piece & p : pieces) {
+				if (p.accepted) {
+					next_pieces.push_back(p);
+					continue;
+				}
+				const R_Type * f = interior.data() + evals_per_piece * pending_idx++;
+				Tf_in h = (p.u_lim - p.l_lim) / 2;
+				Tf_in m = (p.u_lim + p.l_lim) / 2;
+				Tf_in mll = m - alpha * h;
+				Tf_in ml = m - beta * h;
+				Tf_in mr = m + beta * h;
+				Tf_in mrr = m + alpha * h;
+				R_Type coarse = (h / 6.) * (p.l + p.u + 5.0 * (f[1] + f[3]));
+				R_Type fine = (h / 1470.) * (77 * (p.l + p.u) + 432 * (f[0] + f[4])
+					+ 625 * (f[1] + f[3]) + 672 * f[2]);
+				bool refine = is + (fine - coarse) != is;
+				if (refine && ((mll <= p.l_lim) || (mrr >= p.u_lim)
+					|| ((num_scheduled + 6) * evals_per_piece > max_evaluations - evaluations)))
+				{
+					refine = false;
+					converged = false;
+				}
+				if (refine)
+				{
+					next_pieces.push_back(piece{ p.l_lim, mll, p.l, f[0], false, R_Type(0) });
+					next_pieces.push_back(piece{ mll, ml, f[0], f[1], false, R_Type(0) });
+					next_pieces.push_back(piece{ ml, m, f[1], f[2], false, R_Type(0) });
+					next_pieces.push_back(piece{ m, mr, f[2], f[3], false, R_Type(0) });
+					next_pieces.push_back(piece{ mr, mrr, f[3], f[4], false, R_Type(0) });
+					next_pieces.push_back(piece{ mrr, p.u_lim, f[4], p.u, false, R_Type(0) });
+					num_scheduled += 6;
+				}
+				else
+				{
+					next_pieces.push_back(piece{ p.l_lim, p.u_lim, p.l, p.u, true, fine });
+				}
+			}
+			pieces.swap(next_pieces);
+			pending.clear();
+			for (int i = 0; i < (int)pieces.size(); i++) {
+				if (!pieces[i].accepted) { pending.push_back(i); }
+			}
+		}
+
+		R_Type result = 0;
+		for (const piece & p : pieces) { result += p.value; }
+		if (report != nullptr) {
+			report->evaluations = evaluations;
+			report->converged = converged;
+		}
+		return result;
+	}
+}
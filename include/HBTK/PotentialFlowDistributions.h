@@ -25,10 +25,13 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
+#include <cassert>
 #include <cmath>
 #include <tuple>
+#include <vector>
 
 #include "CartesianFiniteLine.h"
+#include "CartesianPointCloud.h"
 #include "Checks.h"
 #include "Constants.h"
 
@@ -41,6 +44,9 @@ namespace HBTK
 		template<typename Ty>
 		constexpr Ty unity_vel_pot(Ty x_mes, Ty y_mes, Ty x_dub, Ty y_dub);
 
+		template<typename Ty>
+		constexpr Ty unity_vel_pot(Ty x_mes, Ty y_mes, Ty x_dub, Ty y_dub, Ty angle);
+
 		template<typename Ty>
 		constexpr Ty unity_u_vel(Ty x_mes, Ty y_mes, Ty x_dub, Ty y_dub);
 
@@ -52,6 +58,15 @@ namespace HBTK
 
 		template<typename Ty>
 		constexpr Ty unity_v_vel(Ty x_mes, Ty y_mes, Ty x_dub, Ty y_dub, Ty angle);
+
+		// Velocity (u, v) and potential at every measurement point induced 
+		// by every doublet, computed together. The output vectors are resized.
+		void induced_vel_and_pot(
+			const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+			const std::vector<double> & x_dub, const std::vector<double> & y_dub,
+			const std::vector<double> & strengths, const std::vector<double> & angles,
+			std::vector<double> & u, std::vector<double> & v, std::vector<double> & potential,
+			int num_threads = 1);
 	}
 
 	namespace PointSource 
@@ -64,6 +79,26 @@ namespace HBTK
 
 		template<typename Ty>
 		constexpr Ty unity_v_vel(Ty x_mes, Ty y_mes, Ty x_sor, Ty y_sor);
+
+		// (u, v) induced at every measurement point by every source, by
+		// direct summation and by a fast multipole method. 
+		std::pair<std::vector<double>, std::vector<double>> induced_vel(
+			const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+			const std::vector<double> & x_sor, const std::vector<double> & y_sor,
+			const std::vector<double> & strengths);
+
+		std::pair<std::vector<double>, std::vector<double>> induced_vel_fmm(
+			const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+			const std::vector<double> & x_sor, const std::vector<double> & y_sor,
+			const std::vector<double> & strengths, double tolerance = 1e-8);
+
+		// Velocity (u, v) and potential, as for PointDoublet.
+		void induced_vel_and_pot(
+			const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+			const std::vector<double> & x_sor, const std::vector<double> & y_sor,
+			const std::vector<double> & strengths,
+			std::vector<double> & u, std::vector<double> & v, std::vector<double> & potential,
+			int num_threads = 1);
 	}
 
 	namespace PointVortex 
@@ -76,6 +111,26 @@ namespace HBTK
 
 		template<typename Ty>
 		constexpr Ty unity_v_vel(Ty x_mes, Ty y_mes, Ty x_vor, Ty y_vor);
+
+		// (u, v) induced at every measurement point by every vortex, by
+		// direct summation and by a fast multipole method. 
+		std::pair<std::vector<double>, std::vector<double>> induced_vel(
+			const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+			const std::vector<double> & x_vor, const std::vector<double> & y_vor,
+			const std::vector<double> & strengths);
+
+		std::pair<std::vector<double>, std::vector<double>> induced_vel_fmm(
+			const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+			const std::vector<double> & x_vor, const std::vector<double> & y_vor,
+			const std::vector<double> & strengths, double tolerance = 1e-8);
+
+		// Velocity (u, v) and potential, as for PointDoublet.
+		void induced_vel_and_pot(
+			const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+			const std::vector<double> & x_vor, const std::vector<double> & y_vor,
+			const std::vector<double> & strengths,
+			std::vector<double> & u, std::vector<double> & v, std::vector<double> & potential,
+			int num_threads = 1);
 	}
 
 	namespace ConstantVortexDistribution
@@ -99,35 +154,65 @@ namespace HBTK
 
 	namespace BiotSavart {
 		CartesianVector3D unity_vel(CartesianPoint3D & mes_point, CartesianFiniteLine3D & filament);
+
+		// Velocities induced at every measurement point by every filament.
+		// Filament j runs from filament_starts[j] to filament_ends[j] with 
+		// circulation strengths[j]. A core_radius > 0 applies a Scully core.
+		VectorField3D induced_vel(const PointCloud3D & mes_points,
+			const PointCloud3D & filament_starts, const PointCloud3D & filament_ends,
+			const std::vector<double> & strengths, double core_radius = 0,
+			int num_threads = 1);
+
+		// As induced_vel, but distant groups of filaments are approximated
+		// by a Barnes-Hut treecode. Smaller opening angles are more accurate.
+		VectorField3D induced_vel_treecode(const PointCloud3D & mes_points,
+			const PointCloud3D & filament_starts, const PointCloud3D & filament_ends,
+			const std::vector<double> & strengths, double core_radius = 0,
+			int num_threads = 1, double opening_angle = 0.5);
 	}
 
 	// DEFINITIONS
 		
 	namespace PointDoublet
 	{
+		// The doublet's axis is the y axis rotated anticlockwise by angle. 
+		// The velocity is the gradient of the potential.
 		template<typename Ty>
 		constexpr Ty unity_vel_pot(Ty x_mes, Ty y_mes, Ty x_dub, Ty y_dub) {
 			return -1 * (y_mes - y_dub) / (2 * Constants::pi<Ty>()*(pow(x_mes - x_dub, 2) + pow(y_mes - y_dub, 2)));
 		}
 
+		template<typename Ty>
+		constexpr Ty unity_vel_pot(Ty x_mes, Ty y_mes, Ty x_dub, Ty y_dub, Ty angle) {
+			const Ty dx = x_mes - x_dub, dy = y_mes - y_dub;
+			const Ty ax = -sin(angle), ay = cos(angle);
+			return -1 * (ax * dx + ay * dy) / (2 * Constants::pi<Ty>() * (dx * dx + dy * dy));
+		}
+
 		template<typename Ty>
 		constexpr Ty unity_u_vel(Ty x_mes, Ty y_mes, Ty x_dub, Ty y_dub) {
-			return (y_mes - y_dub)*(x_mes - x_dub) / (2 * Constants::pi<Ty>()*pow(pow(x_mes - x_dub, 2) + pow(y_mes - y_dub, 2), 2));
+			return 2 * (y_mes - y_dub)*(x_mes - x_dub) / (2 * Constants::pi<Ty>()*pow(pow(x_mes - x_dub, 2) + pow(y_mes - y_dub, 2), 2));
 		}
 
 		template<typename Ty>
 		constexpr Ty unity_u_vel(Ty x_mes, Ty y_mes, Ty x_dub, Ty y_dub, Ty angle) {
-			return cos(angle) * unity_u_vel(x_mes, y_mes, x_dub, y_dub) - sin(angle) * unity_v_vel(x_mes, y_mes, x_dub, y_dub);
+			const Ty dx = x_mes - x_dub, dy = y_mes - y_dub;
+			const Ty r_sq = dx * dx + dy * dy;
+			const Ty ax = -sin(angle), ay = cos(angle);
+			return (2 * (ax * dx + ay * dy) * dx - r_sq * ax) / (2 * Constants::pi<Ty>() * r_sq * r_sq);
 		}
 
 		template<typename Ty>
 		constexpr Ty unity_v_vel(Ty x_mes, Ty y_mes, Ty x_dub, Ty y_dub) {
-			return -1 * (pow(y_mes - y_dub, 2) - pow(x_mes - x_dub, 2)) / (2 * Constants::pi<Ty>() * pow(pow(x_mes - x_dub, 2) + pow(y_mes - y_dub, 2), 2));
+			return (pow(y_mes - y_dub, 2) - pow(x_mes - x_dub, 2)) / (2 * Constants::pi<Ty>() * pow(pow(x_mes - x_dub, 2) + pow(y_mes - y_dub, 2), 2));
 		}
 
 		template<typename Ty>
 		constexpr Ty unity_v_vel(Ty x_mes, Ty y_mes, Ty x_dub, Ty y_dub, Ty angle) {
-			return sin(angle) * unity_u_vel(x_mes, y_mes, x_dub, y_dub) + cos(angle) * unity_v_vel(x_mes, y_mes, x_dub, y_dub);
+			const Ty dx = x_mes - x_dub, dy = y_mes - y_dub;
+			const Ty r_sq = dx * dx + dy * dy;
+			const Ty ax = -sin(angle), ay = cos(angle);
+			return (2 * (ax * dx + ay * dy) * dy - r_sq * ay) / (2 * Constants::pi<Ty>() * r_sq * r_sq);
 		}
 
 	}
@@ -136,7 +221,7 @@ namespace HBTK
 	{
 		template<typename Ty>
 		constexpr Ty unity_vel_pot(Ty x_mes, Ty y_mes, Ty x_sor, Ty y_sor) {
-			return log(hypot(x_mes - x_sor, y_mes - y_sor, 2)) / (2 * Constants::pi<Ty>());
+			return log(hypot(x_mes - x_sor, y_mes - y_sor)) / (2 * Constants::pi<Ty>());
 		}
 
 		template<typename Ty>
@@ -175,17 +260,15 @@ namespace HBTK
 		constexpr Ty unity_vel_pot(Ty x_mes, Ty y_mes, Ty x_vor0, Ty y_vor0, Ty x_vor1, Ty y_vor1)
 		{
 			Ty length = hypot(x_vor1 - x_vor0, y_vor1 - y_vor0);
-			Ty cos_ang = (y_vor1 - y_vor0) / length;
-			Ty sin_ang = (x_vor1 - x_vor0) / length;
+			Ty cos_ang = (x_vor1 - x_vor0) / length;
+			Ty sin_ang = (y_vor1 - y_vor0) / length;
 			// xt and yt indicate that a coordinate has been transformed to a plane where 
-			// the vortex panel is now on yt = 0. xtm and ytm indicate the transformed pos
-			// of the mesurment point. xt1 yt1 the transformed end 1 of the panel. 
-			Ty xtm = (x_mes - x_vor0) * cos_ang - (y_mes - y_vor0) * sin_ang;
-			Ty ytm = (x_mes - x_vor0) * sin_ang + (y_mes - y_vor0) * cos_ang - y_vor0;
-			Ty xt1 = (x_vor1 - x_vor0) * cos_ang - (y_vor1 - y_vor0) * sin_ang;
-			Ty yt1 = 0.0;
-			Ty xt0 = x_vor0;
-			Ty yt0 = 0.0;
+			// the vortex panel runs from (xt0, 0) to (xt1, 0). xtm and ytm indicate the 
+			// transformed pos of the mesurment point.
+			Ty xtm = (x_mes - x_vor0) * cos_ang + (y_mes - y_vor0) * sin_ang;
+			Ty ytm = (y_mes - y_vor0) * cos_ang - (x_mes - x_vor0) * sin_ang;
+			Ty xt1 = length;
+			Ty xt0 = 0.0;
 			// Compute velocity potential as Katz2001 Eq 10.37
 			Ty term_1, term_2, term_21, term_22, term_23;
 			term_1 = -1. / (2 * HBTK::Constants::pi<Ty>());
@@ -202,17 +285,15 @@ namespace HBTK
 		constexpr std::pair<Ty, Ty> unity_vel(Ty x_mes, Ty y_mes, Ty x_vor0, Ty y_vor0, Ty x_vor1, Ty y_vor1)
 		{
 			Ty length = hypot(x_vor1 - x_vor0, y_vor1 - y_vor0);
-			Ty cos_ang = (y_vor1 - y_vor0) / length;
-			Ty sin_ang = (x_vor1 - x_vor0) / length;
+			Ty cos_ang = (x_vor1 - x_vor0) / length;
+			Ty sin_ang = (y_vor1 - y_vor0) / length;
 			// xt and yt indicate that a coordinate has been transformed to a plane where 
-			// the vortex panel is now on yt = 0. xtm and ytm indicate the transformed pos
-			// of the mesurment point. xt1 yt1 the transformed end 1 of the panel. 
-			Ty xtm = (x_mes - x_vor0) * cos_ang - (y_mes - y_vor0) * sin_ang;
-			Ty ytm = (x_mes - x_vor0) * sin_ang + (y_mes - y_vor0) * cos_ang - y_vor0;
-			Ty xt1 = (x_vor1 - x_vor0) * cos_ang - (y_vor1 - y_vor0) * sin_ang;
-			Ty yt1 = 0.0;
-			Ty xt0 = x_vor0;
-			Ty yt0 = 0.0;
+			// the vortex panel runs from (xt0, 0) to (xt1, 0). xtm and ytm indicate the 
+			// transformed pos of the mesurment point.
+			Ty xtm = (x_mes - x_vor0) * cos_ang + (y_mes - y_vor0) * sin_ang;
+			Ty ytm = (y_mes - y_vor0) * cos_ang - (x_mes - x_vor0) * sin_ang;
+			Ty xt1 = length;
+			Ty xt0 = 0.0;
 
 			// Local u velocity (Katz2001 10.39)
 			Ty term_u1, term_u2, term_u21, term_u22;
@@ -230,9 +311,8 @@ namespace HBTK
 			assert(HBTK::check_finite(vt));
 
 			// Rotate our velocity back into our original reference frame.
-			Ty v, u;
-			u = cos_ang * u + sin_ang * v;
-			v = -sin_ang * u + cos_ang * v;
+			Ty u = cos_ang * ut - sin_ang * vt;
+			Ty v = sin_ang * ut + cos_ang * vt;
 			return std::make_pair(u, v);
 		}
 
@@ -242,18 +322,17 @@ namespace HBTK
 		template<typename Ty>
 		constexpr Ty vel_pot(Ty x_mes, Ty y_mes, Ty x_vor0, Ty y_vor0, Ty x_vor1, Ty y_vor1, Ty gamma0, Ty gamma1)
 		{
+			// The strength is gamma0 + gamma1 * (distance along the panel).
 			Ty length = hypot(x_vor1 - x_vor0, y_vor1 - y_vor0);
-			Ty cos_ang = (y_vor1 - y_vor0) / length;
-			Ty sin_ang = (x_vor1 - x_vor0) / length;
+			Ty cos_ang = (x_vor1 - x_vor0) / length;
+			Ty sin_ang = (y_vor1 - y_vor0) / length;
 			// xt and yt indicate that a coordinate has been transformed to a plane where 
-			// the vortex panel is now on yt = 0. xtm and ytm indicate the transformed pos
-			// of the mesurment point. xt1 yt1 the transformed end 1 of the panel. 
-			Ty xtm = (x_mes - x_vor0) * cos_ang - (y_mes - y_vor0) * sin_ang;
-			Ty ytm = (x_mes - x_vor0) * sin_ang + (y_mes - y_vor0) * cos_ang - y_vor0;
-			Ty xt1 = (x_vor1 - x_vor0) * cos_ang - (y_vor1 - y_vor0) * sin_ang;
-			Ty yt1 = 0.0;
-			Ty xt0 = x_vor0;
-			Ty yt0 = 0.0;
+			// the vortex panel runs from (xt0, 0) to (xt1, 0). xtm and ytm indicate the 
+			// transformed pos of the mesurment point.
+			Ty xtm = (x_mes - x_vor0) * cos_ang + (y_mes - y_vor0) * sin_ang;
+			Ty ytm = (y_mes - y_vor0) * cos_ang - (x_mes - x_vor0) * sin_ang;
+			Ty xt1 = length;
+			Ty xt0 = 0.0;
 
 			// The part due to the constant part of the distribution.
 			Ty velocity_potential = HBTK::ConstantVortexDistribution::unity_vel_pot(
@@ -262,33 +341,34 @@ namespace HBTK
 			Ty term_1, term_2, term_21, term_22, term_23, term_24;
 			term_1 = - gamma1 / (2 * HBTK::Constants::pi<Ty>());
 			term_21 = (xtm - xt0) * ytm * log((pow(xtm - xt0, 2) + ytm * ytm) / (pow(xtm - xt1, 2) + ytm * ytm)) / 2.0;
-			term_22 = ytm * (xt1 - xt0);
+			term_22 = ytm * (xt0 - xt1) / 2.;
 			term_23 = (pow(xtm - xt0, 2) - xt0 * xt0 - ytm * ytm) * atan2(ytm, xtm - xt0) / 2.;
 			term_24 = (pow(xtm - xt0, 2) - xt1 * xt1 - ytm * ytm) * atan2(ytm, xtm - xt1) / 2.;
 			term_2 = term_21 + term_22 + term_23 - term_24;
 			velocity_potential += term_1 * term_2;
 			assert(HBTK::check_finite(velocity_potential));
-			return vel_pot;
+			return velocity_potential;
 		}
 
 		template<typename Ty>
 		constexpr std::pair<Ty, Ty> vel(Ty x_mes, Ty y_mes, Ty x_vor0, Ty y_vor0, Ty x_vor1, Ty y_vor1, Ty gamma0, Ty gamma1)
 		{
+			// The strength is gamma0 + gamma1 * (distance along the panel).
 			Ty length = hypot(x_vor1 - x_vor0, y_vor1 - y_vor0);
-			Ty cos_ang = (y_vor1 - y_vor0) / length;
-			Ty sin_ang = (x_vor1 - x_vor0) / length;
+			Ty cos_ang = (x_vor1 - x_vor0) / length;
+			Ty sin_ang = (y_vor1 - y_vor0) / length;
 			// xt and yt indicate that a coordinate has been transformed to a plane where 
-			// the vortex panel is now on yt = 0. xtm and ytm indicate the transformed pos
-			// of the mesurment point. xt1 yt1 the transformed end 1 of the panel. 
-			Ty xtm = (x_mes - x_vor0) * cos_ang - (y_mes - y_vor0) * sin_ang;
-			Ty ytm = (x_mes - x_vor0) * sin_ang + (y_mes - y_vor0) * cos_ang - y_vor0;
-			Ty xt1 = (x_vor1 - x_vor0) * cos_ang - (y_vor1 - y_vor0) * sin_ang;
-			Ty yt1 = 0.0;
-			Ty xt0 = x_vor0;
-			Ty yt0 = 0.0;
+			// the vortex panel runs from (xt0, 0) to (xt1, 0). xtm and ytm indicate the 
+			// transformed pos of the mesurment point.
+			Ty xtm = (x_mes - x_vor0) * cos_ang + (y_mes - y_vor0) * sin_ang;
+			Ty ytm = (y_mes - y_vor0) * cos_ang - (x_mes - x_vor0) * sin_ang;
+			Ty xt1 = length;
+			Ty xt0 = 0.0;
 
 			Ty u, v;
-			std::tie(u, v) = ConstantVortexDistribution::unity_vel(x_mes, y_mes, x_vor0, y_vor0, x_vor1, y_vor1) * gamma0;
+			std::tie(u, v) = ConstantVortexDistribution::unity_vel(x_mes, y_mes, x_vor0, y_vor0, x_vor1, y_vor1);
+			u *= gamma0;
+			v *= gamma0;
 
 			Ty term_common_1, term_common_2, term_common_21, term_common_22;
 			term_common_1 = log((pow(xtm - xt0, 2) + ytm * ytm) / (pow(xtm - xt1, 2) + ytm * ytm));
@@ -311,8 +391,8 @@ namespace HBTK
 			term_v2 = term_v21 + term_v22 + term_v23;
 			vt = term_v1 * term_v2;
 
-			u += cos_ang * ut + sin_ang * vt;
-			v += -sin_ang * ut + cos_ang * vt;
+			u += cos_ang * ut - sin_ang * vt;
+			v += sin_ang * ut + cos_ang * vt;
 			assert(HBTK::check_finite(u));
 			assert(HBTK::check_finite(v));
 			return std::make_pair(u, v);
@@ -0,0 +1,130 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+QuadratureCache.h
+
+A process-wide cache of Gaussian quadrature rules.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <tuple>
+
+#include "StaticQuadrature.h"
+
+namespace HBTK {
+	// Generating a Gaussian quadrature is expensive compared to using it. 
+	// QuadratureCache stores each rule the first time it is requested and
+	// hands out shared, immutable copies afterwards. Lookups from many threads
+	// only take a shared lock.
+	//
+	// \code
+	// auto quad = HBTK::QuadratureCache::get(HBTK::QuadratureCache::gauss_legendre, 8);
+	// double result = quad->integrate(my_function);
+	// \endcode
+	// Remapped rules are cached too, keyed by the singularity position:
+	// \code
+	// auto telles = HBTK::QuadratureCache::get_remapped(
+	//		HBTK::QuadratureCache::gauss_legendre, 8,
+	//		HBTK::QuadratureCache::telles_cubic, 0.5);
+	// \endcode
+	// Every distinct singularity position gives a new entry, so the number
+	// of remapped rules is capped (see set_remapped_limit). When the cap is
+	// reached, all remapped rules are evicted. Plain rules are never evicted.
+	class QuadratureCache {
+	public:
+		enum quadrature_family {
+			gauss_legendre,
+			gauss_laguerre,
+			gauss_hermite,
+			gauss_chebyshev1,
+			gauss_chebyshev2,
+			gauss_gegenbauer,			// alpha used.
+			gauss_generalised_laguerre,	// alpha used.
+			gauss_jacobi				// alpha and beta used.
+		};
+
+		enum remap_type {
+			no_remap,
+			telles_quadratic,	// Singularity at a bound.
+			telles_cubic,		// Singularity anywhere in the interval.
+			sato4,				// Singularity at a bound.
+			sato5,				// Singularity at a bound.
+			doblare				// Singularity strictly inside the interval.
+		};
+
+		// Get a rule, generating it if it isn't already cached. alpha and beta
+		// are ignored by families that don't use them.
+		static std::shared_ptr<const StaticQuadrature> get(quadrature_family family, 
+			int num_points, double alpha = 0, double beta = 0);
+		// Get a rule with a StaticQuadrature remap applied for a singularity 
+		// at singularity_position, generating it if it isn't already cached.
+		static std::shared_ptr<const StaticQuadrature> get_remapped(
+			quadrature_family family, int num_points, remap_type remap, 
+			double singularity_position, double alpha = 0, double beta = 0);
+
+		// Number of calls to get() that found / didn't find a cached rule.
+		static long long hits();
+		static long long misses();
+		// Number of rules currently cached.
+		static int size();
+		// Remove all rules and reset the statistics. Rules still held
+		// by callers remain valid.
+		static void clear();
+		// Number of remapped rules currently cached.
+		static int remapped_size();
+		// Set the maximum number of remapped rules cached. Defaults to 
+		// default_remapped_limit. Rules still held by callers remain valid
+		// when evicted.
+		static void set_remapped_limit(int max_remapped_rules);
+		static const int default_remapped_limit = 4096;
+
+	private:
+		static QuadratureCache& get_instance();
+		QuadratureCache();
+		~QuadratureCache();
+
+		// family, num_points, alpha, beta, remap, singularity_position
+		typedef std::tuple<int, int, double, double, int, double> key_type;
+		std::map<key_type, std::shared_ptr<const StaticQuadrature>> m_rules;
+		std::shared_timed_mutex m_mutex;
+		std::atomic<long long> m_hits, m_misses;
+		// Guarded by m_mutex.
+		int m_remapped_count, m_remapped_limit;
+
+		static key_type make_key(quadrature_family family, int num_points,
+			double alpha, double beta, remap_type remap, double singularity_position);
+		static std::shared_ptr<const StaticQuadrature> find(const key_type & key);
+		static std::shared_ptr<const StaticQuadrature> insert(const key_type & key,
+			std::shared_ptr<const StaticQuadrature> rule);
+		static StaticQuadrature generate(quadrature_family family,
+			int num_points, double alpha, double beta);
+		// Remove all remapped rules. Needs a unique lock on m_mutex.
+		void evict_remapped();
+
+	public:
+		QuadratureCache(QuadratureCache const&) = delete;
+		void operator=(QuadratureCache const&) = delete;
+	};
+}
@@ -0,0 +1,113 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+QuadratureSelector.h
+
+Pick a remap and point count for integrands with a nearby singularity.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <memory>
+#include <vector>
+
+#include "QuadratureCache.h"
+
+namespace HBTK {
+	// The result of QuadratureSelector::select.
+	struct QuadratureSelection {
+		QuadratureCache::remap_type remap = QuadratureCache::no_remap;
+		int num_points = 0;
+		// Local coordinate in [-1, 1] to centre the remap on.
+		double singularity_position = 0;
+		// Worst relative error seen by the calibration benchmark for this 
+		// choice between the calibrated positions and distances either side
+		// of the query.
+		double expected_error = 0;
+		// False if no candidate reached the tolerance, or if the distance is
+		// smaller than the smallest non-zero calibrated distance. The most 
+		// accurate candidate is returned, but the element should be 
+		// subdivided.
+		bool meets_tolerance = false;
+
+		// The selected Gauss-Legendre rule on [-1, 1], from the QuadratureCache.
+		std::shared_ptr<const StaticQuadrature> quadrature() const;
+	};
+
+	// Chooses the cheapest remapped Gauss-Legendre rule that integrates a
+	// near-singular element integrand to a given tolerance. The element is
+	// the interval [-1, 1] in local coordinates and the singular point is at 
+	// (singularity_position, distance), with distances measured in element 
+	// half-lengths. 
+	//
+	// The choice comes from a table that is built by a benchmark the first 
+	// time select is called. The benchmark integrates log(r/4), 1/r and 
+	// h/r^2 (log(r/4) only when the singularity lies on the element), with 
+	// r^2 = (x - s)^2 + h^2, using every candidate remap and point count, and
+	// records the worst relative error over each cell of a grid of positions
+	// |s| and distances h. The errors oscillate with s and h, so each cell is
+	// sampled at its corners and at points in between. A query uses the cell
+	// it lies in (the last cell beyond the largest distance) and the cheapest
+	// candidate that meets the tolerance there is chosen. This is 
+	// conservative in practice, but not guaranteed to be. None of the 
+	// calibration integrands change sign, so the tolerance is effectively 
+	// relative to the integral of the magnitude of the kernel.
+	//
+	// \code
+	// auto choice = HBTK::QuadratureSelector::select(0.3, 0.01, 1e-8);
+	// double result = choice.quadrature()->integrate(my_function);
+	// \endcode
+	class QuadratureSelector {
+	public:
+		static QuadratureSelection select(double singularity_position, 
+			double distance, double tolerance);
+
+		// The worst relative error of the calibration integrands for one 
+		// choice of remap and point count. Exposed so that the calibration
+		// can be inspected.
+		static double benchmark_error(QuadratureCache::remap_type remap,
+			int num_points, double singularity_position, double distance);
+
+		// Point counts, positions |s| and distances used by the calibration.
+		static const std::vector<int> & candidate_point_counts();
+		static const std::vector<double> & calibrated_positions();
+		static const std::vector<double> & calibrated_distances();
+
+	private:
+		static QuadratureSelector& get_instance();
+		QuadratureSelector();
+		~QuadratureSelector();
+
+		// The worst error over the calibration integrands, indexed by 
+		// (position cell, distance cell, remap, point count).
+		std::vector<double> m_errors;
+
+		void calibrate();
+		// As the public benchmark_error, for a remap of base_rule, a 
+		// Gauss-Legendre rule generated by the caller.
+		static double benchmark_error(QuadratureCache::remap_type remap,
+			const StaticQuadrature & base_rule, double singularity_position, double distance);
+		static int table_index(int position_cell, int distance_cell, int remap_idx, int count_idx);
+
+	public:
+		QuadratureSelector(QuadratureSelector const&) = delete;
+		void operator=(QuadratureSelector const&) = delete;
+	};
+}
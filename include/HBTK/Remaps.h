@@ -56,6 +56,30 @@ namespace HBTK {
 	template<typename Ty>
 	constexpr void exponential_remap(Ty & point, Ty & weight, Ty lower_limit);
 
+	template<int N, typename Ty>
+	constexpr Ty integer_power(Ty x);
+
+	template<typename Ty>
+	void linear_remap_batch(Ty * points, Ty * weights, int n_points,
+							Ty original_x0, Ty original_x1,
+							Ty new_x0, Ty new_x1);
+
+	template<typename Ty>
+	void telles_quadratic_remap_batch(Ty * points, Ty * weights, int n_points,
+									Ty singularity);
+
+	template<typename Ty>
+	void telles_cubic_remap_batch(Ty * points, Ty * weights, int n_points,
+								Ty singularity_pos);
+
+	template<int Torder, typename Ty>
+	void sato_remap_batch(Ty * points, Ty * weights, int n_points,
+						Ty singularity_pos);
+
+	template<typename Ty>
+	void doblare_remap_batch(Ty * points, Ty * weights, int n_points,
+							Ty singularity_pos);
+
 	// TODO:
 	// tanh_sinh
 	// Sigmoidal
@@ -257,5 +281,112 @@ namespace HBTK {
 		return void();
 	}
 
+	/// \param x the base.
+	///
+	/// \brief x to the power N, for small non-negative N, without calling pow.
+	///
+	/// The loop is unrolled by the compiler, so this vectorises where pow 
+	/// does not.
+	template<int N, typename Ty>
+	constexpr Ty integer_power(Ty x)
+	{
+		static_assert(N >= 0, "integer_power requires a non-negative power.");
+		Ty result = 1;
+		for (int i = 0; i < N; i++) { result *= x; }
+		return result;
+	}
+
+	// Batch remaps: the same as the remaps above, applied to every point and
+	// weight of a rule. Constants that depend on the singularity are computed
+	// once and the loops contain no calls to pow or cbrt, so the compiler can
+	// vectorise them. Use them like:
+	// \code
+	// std::vector<double> points, weights;
+	// HBTK::gauss_legendre<double>(16, points, weights);
+	// HBTK::telles_cubic_remap_batch(points.data(), weights.data(), 16, 0.3);
+	// \endcode
+
+	/// \brief Apply linear_remap to n_points points and weights.
+	template<typename Ty>
+	void linear_remap_batch(Ty * points, Ty * weights, int n_points,
+							Ty original_x0, Ty original_x1,
+							Ty new_x0, Ty new_x1)
+	{
+		const Ty Dx_ratio = (new_x1 - new_x0) / (original_x1 - original_x0);
+		for (int i = 0; i < n_points; i++) {
+			weights[i] = weights[i] * Dx_ratio;
+			points[i] = (points[i] - original_x0) * Dx_ratio + new_x0;
+		}
+		return;
+	}
+
+	/// \brief Apply telles_quadratic_remap to n_points points and weights.
+	template<typename Ty>
+	void telles_quadratic_remap_batch(Ty * points, Ty * weights, int n_points,
+									Ty singularity)
+	{
+		assert(std::abs(singularity) == 1);
+		const Ty c = singularity + sqrt(singularity * singularity - 1);
+		for (int i = 0; i < n_points; i++) {
+			const Ty p = points[i];
+			points[i] = (1 - p * p) * c / 2 + p;
+			weights[i] = (1 - p * c) * weights[i];
+		}
+		return;
+	}
+
+	/// \brief Apply telles_cubic_remap to n_points points and weights.
+	template<typename Ty>
+	void telles_cubic_remap_batch(Ty * points, Ty * weights, int n_points,
+								Ty singularity_pos)
+	{
+		const Ty sp_rm = cbrt((singularity_pos - 1)*(singularity_pos + 1)*(singularity_pos + 1))
+			+ cbrt((singularity_pos - 1)*(singularity_pos - 1)*(singularity_pos + 1))
+			+ singularity_pos;
+		const Ty inv_denominator = 1 / (3 * sp_rm * sp_rm + 1);
+		const Ty offset = sp_rm * (sp_rm * sp_rm + 3);
+		for (int i = 0; i < n_points; i++) {
+			const Ty d = points[i] - sp_rm;
+			points[i] = (d * d * d + offset) * inv_denominator;
+			weights[i] = 3 * d * d * inv_denominator * weights[i];
+		}
+		return;
+	}
+
+	/// \brief Apply sato_remap<Torder> to n_points points and weights.
+	template<int Torder, typename Ty>
+	void sato_remap_batch(Ty * points, Ty * weights, int n_points,
+						Ty singularity_pos)
+	{
+		static_assert(Torder > 1, "The order of a Sato remap must be greater than one.");
+		static_assert(Torder < 10, "A Sato remap of this order is pretty much guarenteed to have numerical problems.");
+		assert(std::abs(singularity_pos) == 1);
+		const Ty point_coeff = singularity_pos / integer_power<Torder - 1>((Ty)2);
+		const Ty weight_coeff = Torder * singularity_pos * singularity_pos 
+			/ integer_power<Torder - 1>((Ty)2);
+		for (int i = 0; i < n_points; i++) {
+			const Ty u = 1 - singularity_pos * points[i];
+			const Ty u_power = integer_power<Torder - 1>(u);
+			points[i] = singularity_pos - point_coeff * u_power * u;
+			weights[i] = weight_coeff * u_power * weights[i];
+		}
+		return;
+	}
+
+	/// \brief Apply doblare_remap to n_points points and weights.
+	template<typename Ty>
+	void doblare_remap_batch(Ty * points, Ty * weights, int n_points,
+							Ty singularity_pos)
+	{
+		assert(std::abs(singularity_pos) < 1.);
+		for (int i = 0; i < n_points; i++) {
+			const Ty p = points[i];
+			const Ty p2 = p * p;
+			points[i] = singularity_pos * (1 - p2 * p2) + p2 * p;
+			weights[i] = weights[i] * (-4 * p2 * p * singularity_pos + 3 * p2);
+		}
+		return;
+	}
+
 }
 
@@ -0,0 +1,135 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+StaticCubature.h
+
+Integration over quadrangle, triangle, hexahedron and tetrahedron elements
+using fixed multi-dimensional rules.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <vector>
+
+#include "Integrators.h"
+#include "StaticQuadrature.h"
+
+namespace HBTK {
+	// A fixed rule for integrating over a 1, 2 or 3 dimensional domain.
+	// Points are stored interleaved: coordinate d of point i is 
+	// points()[i * dimensions() + d].
+	//
+	// The factory functions below build rules on the local coordinates of 
+	// the elements in ElementGoemetry.h:
+	//	quadrangle	[-1, 1]^2
+	//	triangle	x, y >= 0, x + y <= 1
+	//	hexahedron	[-1, 1]^3
+	//	tetrahedron	x, y, z >= 0, x + y + z <= 1
+	//
+	// \code
+	// auto cube = HBTK::gauss_legendre_cubature(HBTK::StaticCubature::hexahedron, 4);
+	// auto f = [](const double * x) { return x[0] * x[0] * x[1] * x[1] * x[2] * x[2]; };
+	// double result = cube.integrate(f);	// 8 / 27
+	// \endcode
+	class StaticCubature
+	{
+	public:
+		enum element_type {
+			quadrangle,
+			triangle,
+			hexahedron,
+			tetrahedron
+		};
+
+		StaticCubature(int dimensions, const std::vector<double> & points, 
+			const std::vector<double> & weights);
+		~StaticCubature();
+
+		// Integrate a function with signature double(const double * coordinate).
+		template<typename TyFunc>
+		double integrate(TyFunc & my_function) const;
+		// Integrate many integrands with one call to my_function, which has
+		// signature void(const std::vector<double> & points, std::vector<double> & values).
+		// points is interleaved as points(). Integrand j at point i is written
+		// to values[j * num_points() + i]. See HBTK::static_integrate_batch.
+		template<typename TyFunc>
+		std::vector<double> integrate_batch(TyFunc & my_function, int num_integrands) const;
+
+		// Interleaved points of the cubature.
+		const std::vector<double> & points() const;
+		// Weights of the cubature.
+		const std::vector<double> & weights() const;
+		// Number of spatial dimensions.
+		int dimensions() const;
+		// Number of cubature points.
+		int num_points() const;
+
+	private:
+		int m_dimensions;
+		std::vector<double> m_points;
+		std::vector<double> m_weights;
+	};
+
+	// Tensor product of a 1D rule with itself in each dimension. The rule's
+	// own bounds are kept: a rule on [a, b] gives a cubature on [a, b]^dimensions.
+	StaticCubature tensor_product_cubature(const StaticQuadrature & rule, int dimensions);
+
+	// Gauss rule with num_points in each direction. Quadrangles and hexahedra
+	// use tensor products of gauss_legendre. Triangles and tetrahedra use
+	// collapsed coordinates with Gauss-Jacobi rules absorbing the Jacobian.
+	// Exact for polynomials of degree 2 * num_points - 1 in each case.
+	StaticCubature gauss_legendre_cubature(StaticCubature::element_type element, 
+		int num_points);
+
+	// Smolyak sparse grid on [-1, 1]^dimensions built from Gauss-Legendre 
+	// rules of 1, 2, 3, ... level + 1 points. Exact for polynomials of total
+	// degree 2 * level + 1. It uses far fewer points than the tensor product
+	// of its finest 1D rule, but for low degree in 2D and 3D a Gauss tensor
+	// product of equal total degree is smaller. Some weights are negative.
+	StaticCubature smolyak_cubature(int dimensions, int level);
+
+
+	template<typename TyFunc>
+	inline double StaticCubature::integrate(TyFunc & my_function) const
+	{
+		double accumulator = 0;
+		for (int i = 0; i < num_points(); i++) {
+			accumulator += my_function(m_points.data() + i * m_dimensions) * m_weights[i];
+		}
+		return accumulator;
+	}
+
+	template<typename TyFunc>
+	inline std::vector<double> StaticCubature::integrate_batch(TyFunc & my_function,
+		int num_integrands) const
+	{
+		assert(num_integrands > 0);
+		const int n_points = num_points();
+		std::vector<double> values(n_points * num_integrands);
+		my_function(m_points, values);
+		assert((int)values.size() == n_points * num_integrands);
+		std::vector<double> results(num_integrands);
+		for (int j = 0; j < num_integrands; j++) {
+			results[j] = pairwise_dot(values.data() + j * n_points, m_weights.data(), n_points);
+		}
+		return results;
+	}
+} // End namespace HBTK
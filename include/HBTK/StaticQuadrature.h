@@ -40,7 +40,10 @@ namespace HBTK {
 
 		// Integrate a function:
 		template<typename TyFunc>
-		auto integrate(TyFunc & my_function) -> decltype(my_function((double)(0.0)));
+		auto integrate(TyFunc & my_function) const -> decltype(my_function((double)(0.0)));
+		// Integrate many integrands at once. See HBTK::static_integrate_batch.
+		template<typename TyFunc>
+		std::vector<double> integrate_batch(TyFunc & my_function, int num_integrands) const;
 
 		// Get the points and weights from the quadrature.
 		std::pair<std::vector<double>, std::vector<double>> get_quadrature() const;
@@ -65,6 +68,8 @@ namespace HBTK {
 		void sato4_remap(double singularity_position);
 		// Apply Sato 5th order remap.
 		void sato5_remap(double singularity_position);
+		// Apply Doblare remap. Singularity must be inside the interval.
+		void doblare_remap(double singularity_position);
 
 	private:
 		double m_lower_bound, m_upper_bound;
@@ -75,10 +80,17 @@ namespace HBTK {
 	};
 
 	template<typename TyFunc>
-	inline auto StaticQuadrature::integrate(TyFunc & my_function)
+	inline auto StaticQuadrature::integrate(TyFunc & my_function) const
 		-> decltype(my_function((double)(0.0)))
 	{
 		return HBTK::static_integrate(my_function, m_points, m_weights, num_points());
 	}
+
+	template<typename TyFunc>
+	inline std::vector<double> StaticQuadrature::integrate_batch(TyFunc & my_function, 
+		int num_integrands) const
+	{
+		return HBTK::static_integrate_batch(my_function, m_points, m_weights, num_integrands);
+	}
 } // End namespace HBTK
 
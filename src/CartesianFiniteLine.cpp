@@ -32,87 +32,11 @@ SOFTWARE.
 #include "CartesianVector.h"
 #include "Checks.h"
 
-HBTK::CartesianFiniteLine3D::CartesianFiniteLine3D()
-	: m_start({0.0, 0.0, 0.0}),
-	m_end({1.0, 0.0, 0.0})
-{
-}
-
-HBTK::CartesianFiniteLine3D::CartesianFiniteLine3D(const CartesianPoint3D & start, const CartesianPoint3D & end)
-	: m_start(start),
-	m_end(end)
-{
-}
-
-HBTK::CartesianFiniteLine3D::CartesianFiniteLine3D(const CartesianPoint3D & start, const CartesianVector3D & direction)
-	: m_start(start),
-	m_end(start + direction)
-{
-}
-
-HBTK::CartesianFiniteLine3D::CartesianFiniteLine3D(const CartesianVector3D & direction, const CartesianPoint3D & end)
-	: m_start(end - direction),
-	m_end(end)
-{
-}
-
-HBTK::CartesianFiniteLine3D::~CartesianFiniteLine3D()
-{
-}
-
 HBTK::CartesianFiniteLine3D::operator HBTK::CartesianLine3D() const
 {
 	return CartesianLine3D(m_start, m_end - m_start);
 }
 
-HBTK::CartesianPoint3D HBTK::CartesianFiniteLine3D::operator()(double position) const
-{
-	CartesianVector3D vector = m_end - m_start;
-	CartesianPoint3D output = m_start + vector * position;
-	return output;
-}
-
-HBTK::CartesianPoint3D HBTK::CartesianFiniteLine3D::evaluate(double position) const
-{
-	return operator()(position);
-}
-
-HBTK::CartesianPoint3D & HBTK::CartesianFiniteLine3D::start()
-{
-	return m_start;
-}
-
-const HBTK::CartesianPoint3D & HBTK::CartesianFiniteLine3D::start() const
-{
-	return m_start;
-}
-
-HBTK::CartesianPoint3D & HBTK::CartesianFiniteLine3D::end()
-{
-	return m_end;
-}
-
-const HBTK::CartesianPoint3D & HBTK::CartesianFiniteLine3D::end() const
-{
-	return m_end;
-}
-
-
-HBTK::CartesianVector3D HBTK::CartesianFiniteLine3D::vector() const
-{
-	return CartesianVector3D(m_end - m_start);
-}
-
-HBTK::CartesianPoint3D HBTK::CartesianFiniteLine3D::midpoint() const
-{
-	return start() + (end() - start()) * 0.5;
-}
-
-double HBTK::CartesianFiniteLine3D::magnitude() const
-{
-	return vector().magnitude();
-}
-
 double HBTK::CartesianFiniteLine3D::distance(const CartesianPoint3D & other) const
 {
 	double denominator = vector().magnitude();
@@ -216,105 +140,7 @@ double HBTK::CartesianFiniteLine3D::intersection(const CartesianFiniteLine3D & o
 	return m_coeff;
 }
 
-bool HBTK::CartesianFiniteLine3D::operator==(const CartesianFiniteLine3D & other) const
-{
-	return (other.start() == m_start) && (other.end() == m_end);
-}
-
-bool HBTK::CartesianFiniteLine3D::operator!=(const CartesianFiniteLine3D & other) const
-{
-	return !operator==(other);
-}
-
-
-HBTK::CartesianFiniteLine2D::CartesianFiniteLine2D()
-	: m_start({ 0.0, 0.0 }),
-	m_end({ 1.0, 0.0 })
-{
-}
-
-HBTK::CartesianFiniteLine2D::CartesianFiniteLine2D(const CartesianPoint2D & start, const CartesianPoint2D & end)
-	: m_start(start),
-	m_end(end)
-{
-}
-
-HBTK::CartesianFiniteLine2D::CartesianFiniteLine2D(const CartesianPoint2D & start, const CartesianVector2D & direction)
-	: m_start(start),
-	m_end(start + direction)
-{
-}
-
-HBTK::CartesianFiniteLine2D::CartesianFiniteLine2D(const CartesianVector2D & direction, const CartesianPoint2D & end)
-	: m_start(end - direction),
-	m_end(end)
-{
-}
-
-HBTK::CartesianFiniteLine2D::~CartesianFiniteLine2D()
-{
-}
-
 HBTK::CartesianFiniteLine2D::operator HBTK::CartesianLine2D() const
 {
 	return CartesianLine2D(m_start, m_end - m_start);
 }
-
-HBTK::CartesianPoint2D HBTK::CartesianFiniteLine2D::operator()(double position) const
-{
-	CartesianVector2D vector = m_end - m_start;
-	CartesianPoint2D output = m_start + vector * position;
-	return output;
-}
-
-HBTK::CartesianPoint2D HBTK::CartesianFiniteLine2D::evaluate(double position) const
-{
-	return operator()(position);
-}
-
-HBTK::CartesianPoint2D & HBTK::CartesianFiniteLine2D::start()
-{
-	return m_start;
-}
-
-const HBTK::CartesianPoint2D & HBTK::CartesianFiniteLine2D::start() const
-{
-	return m_start;
-}
-
-HBTK::CartesianPoint2D & HBTK::CartesianFiniteLine2D::end()
-{
-	return m_end;
-}
-
-const HBTK::CartesianPoint2D & HBTK::CartesianFiniteLine2D::end() const
-{
-	return m_end;
-}
-
-
-HBTK::CartesianVector2D HBTK::CartesianFiniteLine2D::vector() const
-{
-	return CartesianVector2D(m_end - m_start);
-}
-
-HBTK::CartesianPoint2D HBTK::CartesianFiniteLine2D::midpoint() const
-{
-	return start() + (end() - start()) * 0.5;
-}
-
-
-double HBTK::CartesianFiniteLine2D::magnitude() const
-{
-	return vector().magnitude();
-}
-
-bool HBTK::CartesianFiniteLine2D::operator==(const CartesianFiniteLine2D & other) const
-{
-	return (other.start() == m_start) && (other.end() == m_end);
-}
-
-bool HBTK::CartesianFiniteLine2D::operator!=(const CartesianFiniteLine2D & other) const
-{
-	return !operator==(other);
-}
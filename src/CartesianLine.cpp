@@ -29,57 +29,6 @@ SOFTWARE.
 
 #include "Checks.h"
 
-HBTK::CartesianLine3D::CartesianLine3D()
-{
-}
-
-HBTK::CartesianLine3D::CartesianLine3D(const CartesianPoint3D & start, const CartesianPoint3D & end)
-	: m_origin(start),
-	m_direction(end - start)
-{
-}
-
-HBTK::CartesianLine3D::CartesianLine3D(const CartesianPoint3D & start, const CartesianVector3D & direction)
-	: m_origin(start),
-	m_direction(direction)
-{
-}
-
-HBTK::CartesianLine3D::~CartesianLine3D()
-{
-}
-
-HBTK::CartesianPoint3D HBTK::CartesianLine3D::operator()(double position) const
-{
-	CartesianPoint3D output = m_origin + m_direction * position;
-	return output;
-}
-
-HBTK::CartesianPoint3D HBTK::CartesianLine3D::evaluate(double position) const
-{
-	return operator()(position);
-}
-
-HBTK::CartesianPoint3D & HBTK::CartesianLine3D::origin()
-{
-	return m_origin;
-}
-
-const HBTK::CartesianPoint3D & HBTK::CartesianLine3D::origin() const
-{
-	return m_origin;
-}
-
-HBTK::CartesianVector3D & HBTK::CartesianLine3D::direction()
-{
-	return m_direction;
-}
-
-const HBTK::CartesianVector3D & HBTK::CartesianLine3D::direction() const
-{
-	return m_direction;
-}
-
 double HBTK::CartesianLine3D::distance(const CartesianPoint3D & other) const
 {
 	double denominator = m_direction.magnitude();
@@ -166,77 +115,3 @@ double HBTK::CartesianLine3D::intersection(const CartesianLine3D & other) const
 	}
 	return m_coeff;
 }
-
-bool HBTK::CartesianLine3D::operator==(const CartesianLine3D & other) const
-{
-	return (other.origin() == m_origin) && (other.direction() == m_direction);
-}
-
-bool HBTK::CartesianLine3D::operator!=(const CartesianLine3D & other) const
-{
-	return !operator==(other);
-}
-
-HBTK::CartesianLine2D::CartesianLine2D()
-	: m_origin({ 0.0, 0.0}),
-	m_direction({ 1.0 })
-{
-}
-
-HBTK::CartesianLine2D::CartesianLine2D(const CartesianPoint2D & start, const CartesianPoint2D & end)
-	: m_origin(start),
-	m_direction(end - start)
-{
-}
-
-HBTK::CartesianLine2D::CartesianLine2D(const CartesianPoint2D & start, const CartesianVector2D & direction)
-	: m_origin(start),
-	m_direction(direction)
-{
-}
-
-HBTK::CartesianLine2D::~CartesianLine2D()
-{
-}
-
-HBTK::CartesianPoint2D HBTK::CartesianLine2D::operator()(double position) const
-{
-	CartesianPoint2D output = m_origin + m_direction * position;
-	return output;
-}
-
-HBTK::CartesianPoint2D HBTK::CartesianLine2D::evaluate(double position) const
-{
-	return operator()(position);
-}
-
-HBTK::CartesianPoint2D & HBTK::CartesianLine2D::origin()
-{
-	return m_origin;
-}
-
-const HBTK::CartesianPoint2D & HBTK::CartesianLine2D::origin() const
-{
-	return m_origin;
-}
-
-HBTK::CartesianVector2D & HBTK::CartesianLine2D::direction()
-{
-	return m_direction;
-}
-
-const HBTK::CartesianVector2D & HBTK::CartesianLine2D::direction() const
-{
-	return m_direction;
-}
-
-
-bool HBTK::CartesianLine2D::operator==(const CartesianLine2D & other) const
-{
-	return (other.origin() == m_origin) && (other.direction() == m_direction);
-}
-
-bool HBTK::CartesianLine2D::operator!=(const CartesianLine2D & other) const
-{
-	return !operator==(other);
-}
@@ -0,0 +1,525 @@
+#include "CartesianPointCloud.h"
+/*////////////////////////////////////////////////////////////////////////////
+CartesianPointCloud.cpp
+
+Structure-of-arrays collections of points and vectors in Cartesian space.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+namespace {
+	typedef std::array<std::array<double, 3>, 3> matrix3;
+
+	// Rodrigues' rotation formula as a matrix.
+	matrix3 rotation_matrix(const HBTK::CartesianVector3D & axis, double angle)
+	{
+		HBTK::CartesianVector3D k = axis;
+		k.normalise();
+		const double c = cos(angle), s = sin(angle), t = 1 - c;
+		const double x = k.x(), y = k.y(), z = k.z();
+		matrix3 r;
+		r[0] = { c + t * x * x, t * x * y - s * z, t * x * z + s * y };
+		r[1] = { t * x * y + s * z, c + t * y * y, t * y * z - s * x };
+		r[2] = { t * x * z - s * y, t * y * z + s * x, c + t * z * z };
+		return r;
+	}
+
+	void rotate_arrays(double * x, double * y, double * z, int n, const matrix3 & r)
+	{
+		for (int i = 0; i < n; i++) {
+			const double xi = x[i], yi = y[i], zi = z[i];
+			x[i] = r[0][0] * xi + r[0][1] * yi + r[0][2] * zi;
+			y[i] = r[1][0] * xi + r[1][1] * yi + r[1][2] * zi;
+			z[i] = r[2][0] * xi + r[2][1] * yi + r[2][2] * zi;
+		}
+	}
+
+	void add_constant(std::vector<double> & values, double constant)
+	{
+		double * v = values.data();
+		const int n = (int)values.size();
+		for (int i = 0; i < n; i++) { v[i] += constant; }
+	}
+
+	// out = a - b or a + b element-wise.
+	template<bool Subtract>
+	void combine(const std::vector<double> & a, const std::vector<double> & b, 
+		std::vector<double> & out)
+	{
+		assert(a.size() == b.size());
+		out.resize(a.size());
+		const double * pa = a.data();
+		const double * pb = b.data();
+		double * po = out.data();
+		const int n = (int)a.size();
+		for (int i = 0; i < n; i++) { po[i] = Subtract ? pa[i] - pb[i] : pa[i] + pb[i]; }
+	}
+}
+
+HBTK::PointCloud3D::PointCloud3D()
+{
+}
+
+HBTK::PointCloud3D::PointCloud3D(int num_points)
+	: m_x(num_points, 0.),
+	m_y(num_points, 0.),
+	m_z(num_points, 0.)
+{
+	assert(num_points >= 0);
+}
+
+HBTK::PointCloud3D::PointCloud3D(const std::vector<CartesianPoint3D>& points)
+	: PointCloud3D((int)points.size())
+{
+	for (int i = 0; i < size(); i++) { set(i, points[i]); }
+}
+
+HBTK::PointCloud3D::~PointCloud3D()
+{
+}
+
+int HBTK::PointCloud3D::size() const
+{
+	return (int)m_x.size();
+}
+
+void HBTK::PointCloud3D::resize(int num_points)
+{
+	assert(num_points >= 0);
+	m_x.resize(num_points, 0.);
+	m_y.resize(num_points, 0.);
+	m_z.resize(num_points, 0.);
+}
+
+void HBTK::PointCloud3D::reserve(int num_points)
+{
+	m_x.reserve(num_points);
+	m_y.reserve(num_points);
+	m_z.reserve(num_points);
+}
+
+void HBTK::PointCloud3D::push_back(const CartesianPoint3D & point)
+{
+	m_x.push_back(point.x());
+	m_y.push_back(point.y());
+	m_z.push_back(point.z());
+}
+
+HBTK::CartesianPoint3D HBTK::PointCloud3D::operator[](int index) const
+{
+	assert(index >= 0 && index < size());
+	return CartesianPoint3D({ m_x[index], m_y[index], m_z[index] });
+}
+
+void HBTK::PointCloud3D::set(int index, const CartesianPoint3D & point)
+{
+	assert(index >= 0 && index < size());
+	m_x[index] = point.x();
+	m_y[index] = point.y();
+	m_z[index] = point.z();
+}
+
+std::vector<HBTK::CartesianPoint3D> HBTK::PointCloud3D::as_points() const
+{
+	std::vector<CartesianPoint3D> points;
+	points.reserve(size());
+	for (int i = 0; i < size(); i++) { points.push_back((*this)[i]); }
+	return points;
+}
+
+std::vector<double>& HBTK::PointCloud3D::x()
+{
+	return m_x;
+}
+
+const std::vector<double>& HBTK::PointCloud3D::x() const
+{
+	return m_x;
+}
+
+std::vector<double>& HBTK::PointCloud3D::y()
+{
+	return m_y;
+}
+
+const std::vector<double>& HBTK::PointCloud3D::y() const
+{
+	return m_y;
+}
+
+std::vector<double>& HBTK::PointCloud3D::z()
+{
+	return m_z;
+}
+
+const std::vector<double>& HBTK::PointCloud3D::z() const
+{
+	return m_z;
+}
+
+void HBTK::PointCloud3D::translate(const CartesianVector3D & delta)
+{
+	add_constant(m_x, delta.x());
+	add_constant(m_y, delta.y());
+	add_constant(m_z, delta.z());
+}
+
+void HBTK::PointCloud3D::rotate(const CartesianVector3D & axis, double angle, 
+	const CartesianPoint3D & centre)
+{
+	translate(CartesianPoint3D::origin() - centre);
+	rotate_arrays(m_x.data(), m_y.data(), m_z.data(), size(), rotation_matrix(axis, angle));
+	translate(centre - CartesianPoint3D::origin());
+}
+
+std::vector<double> HBTK::PointCloud3D::distance(const CartesianPoint3D & point) const
+{
+	std::vector<double> result(size());
+	const double px = point.x(), py = point.y(), pz = point.z();
+	const double * x = m_x.data();
+	const double * y = m_y.data();
+	const double * z = m_z.data();
+	double * r = result.data();
+	const int n = size();
+	for (int i = 0; i < n; i++) {
+		const double dx = x[i] - px, dy = y[i] - py, dz = z[i] - pz;
+		r[i] = sqrt(dx * dx + dy * dy + dz * dz);
+	}
+	return result;
+}
+
+HBTK::VectorField3D HBTK::PointCloud3D::operator-(const CartesianPoint3D & point) const
+{
+	VectorField3D result;
+	result.x() = m_x;
+	result.y() = m_y;
+	result.z() = m_z;
+	add_constant(result.x(), -point.x());
+	add_constant(result.y(), -point.y());
+	add_constant(result.z(), -point.z());
+	return result;
+}
+
+HBTK::VectorField3D HBTK::PointCloud3D::operator-(const PointCloud3D & other) const
+{
+	assert(size() == other.size());
+	VectorField3D result;
+	combine<true>(m_x, other.m_x, result.x());
+	combine<true>(m_y, other.m_y, result.y());
+	combine<true>(m_z, other.m_z, result.z());
+	return result;
+}
+
+std::pair<HBTK::CartesianPoint3D, HBTK::CartesianPoint3D> HBTK::PointCloud3D::bounding_box() const
+{
+	assert(size() > 0);
+	auto xs = std::minmax_element(m_x.begin(), m_x.end());
+	auto ys = std::minmax_element(m_y.begin(), m_y.end());
+	auto zs = std::minmax_element(m_z.begin(), m_z.end());
+	return std::make_pair(
+		CartesianPoint3D({ *xs.first, *ys.first, *zs.first }),
+		CartesianPoint3D({ *xs.second, *ys.second, *zs.second }));
+}
+
+bool HBTK::PointCloud3D::operator==(const PointCloud3D & other) const
+{
+	return m_x == other.m_x && m_y == other.m_y && m_z == other.m_z;
+}
+
+bool HBTK::PointCloud3D::operator!=(const PointCloud3D & other) const
+{
+	return !(*this == other);
+}
+
+HBTK::VectorField3D::VectorField3D()
+{
+}
+
+HBTK::VectorField3D::VectorField3D(int num_vectors)
+	: m_x(num_vectors, 0.),
+	m_y(num_vectors, 0.),
+	m_z(num_vectors, 0.)
+{
+	assert(num_vectors >= 0);
+}
+
+HBTK::VectorField3D::VectorField3D(const std::vector<CartesianVector3D>& vectors)
+	: VectorField3D((int)vectors.size())
+{
+	for (int i = 0; i < size(); i++) { set(i, vectors[i]); }
+}
+
+HBTK::VectorField3D::~VectorField3D()
+{
+}
+
+int HBTK::VectorField3D::size() const
+{
+	return (int)m_x.size();
+}
+
+void HBTK::VectorField3D::resize(int num_vectors)
+{
+	assert(num_vectors >= 0);
+	m_x.resize(num_vectors, 0.);
+	m_y.resize(num_vectors, 0.);
+	m_z.resize(num_vectors, 0.);
+}
+
+void HBTK::VectorField3D::reserve(int num_vectors)
+{
+	m_x.reserve(num_vectors);
+	m_y.reserve(num_vectors);
+	m_z.reserve(num_vectors);
+}
+
+void HBTK::VectorField3D::push_back(const CartesianVector3D & vector)
+{
+	m_x.push_back(vector.x());
+	m_y.push_back(vector.y());
+	m_z.push_back(vector.z());
+}
+
+HBTK::CartesianVector3D HBTK::VectorField3D::operator[](int index) const
+{
+	assert(index >= 0 && index < size());
+	return CartesianVector3D({ m_x[index], m_y[index], m_z[index] });
+}
+
+void HBTK::VectorField3D::set(int index, const CartesianVector3D & vector)
+{
+	assert(index >= 0 && index < size());
+	m_x[index] = vector.x();
+	m_y[index] = vector.y();
+	m_z[index] = vector.z();
+}
+
+std::vector<HBTK::CartesianVector3D> HBTK::VectorField3D::as_vectors() const
+{
+	std::vector<CartesianVector3D> vectors;
+	vectors.reserve(size());
+	for (int i = 0; i < size(); i++) { vectors.push_back((*this)[i]); }
+	return vectors;
+}
+
+std::vector<double>& HBTK::VectorField3D::x()
+{
+	return m_x;
+}
+
+const std::vector<double>& HBTK::VectorField3D::x() const
+{
+	return m_x;
+}
+
+std::vector<double>& HBTK::VectorField3D::y()
+{
+	return m_y;
+}
+
+const std::vector<double>& HBTK::VectorField3D::y() const
+{
+	return m_y;
+}
+
+std::vector<double>& HBTK::VectorField3D::z()
+{
+	return m_z;
+}
+
+const std::vector<double>& HBTK::VectorField3D::z() const
+{
+	return m_z;
+}
+
+HBTK::VectorField3D HBTK::VectorField3D::operator+(const VectorField3D & other) const
+{
+	VectorField3D result;
+	combine<false>(m_x, other.m_x, result.m_x);
+	combine<false>(m_y, other.m_y, result.m_y);
+	combine<false>(m_z, other.m_z, result.m_z);
+	return result;
+}
+
+HBTK::VectorField3D & HBTK::VectorField3D::operator+=(const VectorField3D & other)
+{
+	combine<false>(m_x, other.m_x, m_x);
+	combine<false>(m_y, other.m_y, m_y);
+	combine<false>(m_z, other.m_z, m_z);
+	return *this;
+}
+
+HBTK::VectorField3D HBTK::VectorField3D::operator-(const VectorField3D & other) const
+{
+	VectorField3D result;
+	combine<true>(m_x, other.m_x, result.m_x);
+	combine<true>(m_y, other.m_y, result.m_y);
+	combine<true>(m_z, other.m_z, result.m_z);
+	return result;
+}
+
+HBTK::VectorField3D & HBTK::VectorField3D::operator-=(const VectorField3D & other)
+{
+	combine<true>(m_x, other.m_x, m_x);
+	combine<true>(m_y, other.m_y, m_y);
+	combine<true>(m_z, other.m_z, m_z);
+	return *this;
+}
+
+HBTK::VectorField3D HBTK::VectorField3D::operator*(double multiplier) const
+{
+	VectorField3D result(*this);
+	result *= multiplier;
+	return result;
+}
+
+HBTK::VectorField3D & HBTK::VectorField3D::operator*=(double multiplier)
+{
+	double * x = m_x.data();
+	double * y = m_y.data();
+	double * z = m_z.data();
+	const int n = size();
+	for (int i = 0; i < n; i++) {
+		x[i] *= multiplier;
+		y[i] *= multiplier;
+		z[i] *= multiplier;
+	}
+	return *this;
+}
+
+HBTK::VectorField3D & HBTK::VectorField3D::scale(const std::vector<double>& factors)
+{
+	assert((int)factors.size() == size());
+	double * x = m_x.data();
+	double * y = m_y.data();
+	double * z = m_z.data();
+	const double * f = factors.data();
+	const int n = size();
+	for (int i = 0; i < n; i++) {
+		x[i] *= f[i];
+		y[i] *= f[i];
+		z[i] *= f[i];
+	}
+	return *this;
+}
+
+std::vector<double> HBTK::VectorField3D::magnitude() const
+{
+	std::vector<double> result = dot(*this);
+	double * r = result.data();
+	const int n = size();
+	for (int i = 0; i < n; i++) { r[i] = sqrt(r[i]); }
+	return result;
+}
+
+void HBTK::VectorField3D::normalise()
+{
+	std::vector<double> factors = magnitude();
+	double * f = factors.data();
+	const int n = size();
+	for (int i = 0; i < n; i++) { f[i] = 1 / f[i]; }
+	scale(factors);
+}
+
+std::vector<double> HBTK::VectorField3D::dot(const VectorField3D & other) const
+{
+	assert(size() == other.size());
+	std::vector<double> result(size());
+	const double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	const double * bx = other.m_x.data(), * by = other.m_y.data(), * bz = other.m_z.data();
+	double * r = result.data();
+	const int n = size();
+	for (int i = 0; i < n; i++) { r[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i]; }
+	return result;
+}
+
+std::vector<double> HBTK::VectorField3D::dot(const CartesianVector3D & other) const
+{
+	std::vector<double> result(size());
+	const double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	const double bx = other.x(), by = other.y(), bz = other.z();
+	double * r = result.data();
+	const int n = size();
+	for (int i = 0; i < n; i++) { r[i] = ax[i] * bx + ay[i] * by + az[i] * bz; }
+	return result;
+}
+
+HBTK::VectorField3D HBTK::VectorField3D::cross(const VectorField3D & other) const
+{
+	assert(size() == other.size());
+	VectorField3D result(size());
+	const double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	const double * bx = other.m_x.data(), * by = other.m_y.data(), * bz = other.m_z.data();
+	double * rx = result.m_x.data(), * ry = result.m_y.data(), * rz = result.m_z.data();
+	const int n = size();
+	for (int i = 0; i < n; i++) {
+		rx[i] = ay[i] * bz[i] - az[i] * by[i];
+		ry[i] = az[i] * bx[i] - ax[i] * bz[i];
+		rz[i] = ax[i] * by[i] - ay[i] * bx[i];
+	}
+	return result;
+}
+
+HBTK::VectorField3D HBTK::VectorField3D::cross(const CartesianVector3D & other) const
+{
+	VectorField3D result(size());
+	const double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	const double bx = other.x(), by = other.y(), bz = other.z();
+	double * rx = result.m_x.data(), * ry = result.m_y.data(), * rz = result.m_z.data();
+	const int n = size();
+	for (int i = 0; i < n; i++) {
+		rx[i] = ay[i] * bz - az[i] * by;
+		ry[i] = az[i] * bx - ax[i] * bz;
+		rz[i] = ax[i] * by - ay[i] * bx;
+	}
+	return result;
+}
+
+void HBTK::VectorField3D::rotate(const CartesianVector3D & axis, double angle)
+{
+	rotate_arrays(m_x.data(), m_y.data(), m_z.data(), size(), rotation_matrix(axis, angle));
+}
+
+HBTK::CartesianVector3D HBTK::VectorField3D::sum() const
+{
+	double sx = 0, sy = 0, sz = 0;
+	for (int i = 0; i < size(); i++) {
+		sx += m_x[i];
+		sy += m_y[i];
+		sz += m_z[i];
+	}
+	return CartesianVector3D({ sx, sy, sz });
+}
+
+bool HBTK::VectorField3D::operator==(const VectorField3D & other) const
+{
+	return m_x == other.m_x && m_y == other.m_y && m_z == other.m_z;
+}
+
+bool HBTK::VectorField3D::operator!=(const VectorField3D & other) const
+{
+	return !(*this == other);
+}
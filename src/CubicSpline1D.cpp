@@ -25,10 +25,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
 
-void HBTK::CubicSpline1D::compute_second_derivatives()
+void HBTK::CubicSpline1D::compute_second_derivatives() const
 {
 	// Based on Numerical Recipes in C "spline" routine.
 	assert(m_point_locations.size() > 1);
@@ -37,8 +42,8 @@ void HBTK::CubicSpline1D::compute_second_derivatives()
 		assert(m_point_locations[i] < m_point_locations[i + 1]);
 	}
 	// Alius variable names for convenience:
-	std::vector<double> & x = m_point_locations;
-	std::vector<double> & y = m_point_values;
+	const std::vector<double> & x = m_point_locations;
+	const std::vector<double> & y = m_point_values;
 	std::vector<double> & yd2 = m_second_derivatives;
 
 	const int n = (int)m_point_locations.size();
@@ -72,20 +77,147 @@ void HBTK::CubicSpline1D::compute_second_derivatives()
 	for (int i = n - 2; i >= 0; i--) {
 		yd2[i] = yd2[i] * yd2[i + 1] + u[i];
 	}
-	m_derivatives_computed = true;
 	return;
 }
 
-void HBTK::CubicSpline1D::check_computed_blocking()
+void HBTK::CubicSpline1D::check_computed_blocking() const
 {
-	bool checking_mutex = true;
-	while (checking_mutex) {
-		if (m_derivatives_computed) break;
-		if (m_deriv_compute_mutex.try_lock()) {
-			compute_second_derivatives();
-			m_deriv_compute_mutex.unlock();
+	if (m_derivative_state.load(std::memory_order_acquire) == computed) { return; }
+	int expected = not_computed;
+	if (m_derivative_state.compare_exchange_strong(expected, computing,
+		std::memory_order_acquire)) {
+		compute_second_derivatives();
+		m_derivative_state.store(computed, std::memory_order_release);
+	}
+	else {
+		settled_derivative_state();
+	}
+	return;
+}
+
+int HBTK::CubicSpline1D::settled_derivative_state() const
+{
+	int state = m_derivative_state.load(std::memory_order_acquire);
+	while (state == computing) {
+		std::this_thread::yield();
+		state = m_derivative_state.load(std::memory_order_acquire);
+	}
+	return state;
+}
+
+void HBTK::CubicSpline1D::compute_second_derivatives_many(
+	CubicSpline1D * splines, int count)
+{
+	// As compute_second_derivatives, but with the index of the spline
+	// innermost. Element i of spline s is at [i * count + s].
+	assert(count > 0);
+	const int n = (int)splines[0].m_point_locations.size();
+	assert(n > 1);
+	std::vector<double> x(n * count), y(n * count), yd2(n * count), u(n * count);
+	for (int s = 0; s < count; s++) {
+		assert(splines[s].m_natural_bc_x0 && splines[s].m_natural_bc_xn);
+		assert((int)splines[s].m_point_locations.size() == n);
+		assert((int)splines[s].m_point_values.size() == n);
+		for (int i = 0; i < n; i++) {
+			x[i * count + s] = splines[s].m_point_locations[i];
+			y[i * count + s] = splines[s].m_point_values[i];
+		}
+	}
+	for (int s = 0; s < count; s++) { yd2[s] = u[s] = 0.0; }
+	for (int i = 1; i < n - 1; i++) {
+		const double * xm = &x[(i - 1) * count], * xi = &x[i * count], * xp = &x[(i + 1) * count];
+		const double * ym = &y[(i - 1) * count], * yi = &y[i * count], * yp = &y[(i + 1) * count];
+		const double * yd2m = &yd2[(i - 1) * count], * um = &u[(i - 1) * count];
+		double * yd2i = &yd2[i * count], * ui = &u[i * count];
+		for (int s = 0; s < count; s++) {
+			double sig = (xi[s] - xm[s]) / (xp[s] - xm[s]);
+			double p = sig * yd2m[s] + 2.0;
+			yd2i[s] = (sig - 1.0) / p;
+			ui[s] = (yp[s] - yi[s]) / (xp[s] - xi[s])
+				- (yi[s] - ym[s]) / (xi[s] - xm[s]);
+			ui[s] = (6.0 * ui[s] / (xp[s] - xm[s]) - sig * um[s]) / p;
+		}
+	}
+	for (int s = 0; s < count; s++) { yd2[(n - 1) * count + s] = 0.0; }
+	for (int i = n - 2; i >= 0; i--) {
+		double * yd2i = &yd2[i * count];
+		const double * yd2p = &yd2[(i + 1) * count], * ui = &u[i * count];
+		for (int s = 0; s < count; s++) {
+			yd2i[s] = yd2i[s] * yd2p[s] + ui[s];
 		}
 	}
+	for (int s = 0; s < count; s++) {
+		std::vector<double> & out = splines[s].m_second_derivatives;
+		out.resize(n);
+		for (int i = 0; i < n; i++) { out[i] = yd2[i * count + s]; }
+		splines[s].m_derivative_state.store(computed, std::memory_order_release);
+	}
+	return;
+}
+
+void HBTK::CubicSpline1D::compute_second_derivatives_threaded(
+	std::vector<CubicSpline1D>& splines, int num_threads)
+{
+	assert(num_threads > 0);
+	// Blocks small enough that the interleaved working arrays of 
+	// a few points stay in cache.
+	const int block_size = 64;
+	const int num_splines = (int)splines.size();
+	const int num_blocks = (num_splines + block_size - 1) / block_size;
+	auto solve_blocks = [&](int first_block, int end_block) {
+		for (int b = first_block; b < end_block; b++) {
+			int first = b * block_size;
+			int count = std::min(block_size, num_splines - first);
+			compute_second_derivatives_many(splines.data() + first, count);
+		}
+	};
+	num_threads = std::min(num_threads, num_blocks);
+	if (num_threads <= 1) {
+		solve_blocks(0, num_blocks);
+		return;
+	}
+	std::vector<std::thread> threads;
+	for (int t = 0; t < num_threads; t++) {
+		threads.emplace_back(solve_blocks, 
+			(int)((long long)num_blocks * t / num_threads), 
+			(int)((long long)num_blocks * (t + 1) / num_threads));
+	}
+	for (auto & thread : threads) { thread.join(); }
+	return;
+}
+
+int HBTK::CubicSpline1D::find_interval(double location, int guess) const
+{
+	const int last = (int)m_point_locations.size() - 2;
+	const double * x = m_point_locations.data();
+	// Try the guess and the interval following it. Sorted input will
+	// nearly always land in one of these.
+	if (guess >= 0 && guess <= last) {
+		if (guess == 0 || x[guess] <= location) {
+			if (guess == last || x[guess + 1] > location) { return guess; }
+			if (guess + 1 == last || x[guess + 2] > location) { return guess + 1; }
+		}
+	}
+	// Bracketing of k in m_point_location
+	int klo = 0;
+	int khi = last + 1;
+	while (khi - klo > 1) {		// khi and klo must indicate adjacent indices.
+		int k = (khi + klo) / 2;	// Compute midpoint
+		if (x[k] > location) { khi = k; }
+		else { klo = k; }
+	}
+	return klo;
+}
+
+void HBTK::CubicSpline1D::find_intervals(const std::vector<double>& locations,
+	std::vector<int>& intervals) const
+{
+	intervals.resize(locations.size());
+	int guess = 0;
+	for (int i = 0; i < (int)locations.size(); i++) {
+		guess = find_interval(locations[i], guess);
+		intervals[i] = guess;
+	}
 	return;
 }
 
@@ -96,7 +228,9 @@ HBTK::CubicSpline1D::CubicSpline1D()
 	m_point_values({}),
 	m_derivative_x0(NAN),
 	m_derivative_xn(NAN),
-	m_derivatives_computed(false)
+	m_derivative_state(not_computed),
+	m_compiled(false),
+	m_uniform_inverse_spacing(0)
 {
 }
 
@@ -108,7 +242,9 @@ HBTK::CubicSpline1D::CubicSpline1D(std::vector<double> point_locations,
 	m_point_values(point_values),
 	m_derivative_x0(derivative_x0),
 	m_derivative_xn(derivative_xn),
-	m_derivatives_computed(false)
+	m_derivative_state(not_computed),
+	m_compiled(false),
+	m_uniform_inverse_spacing(0)
 {
 }
 
@@ -118,7 +254,9 @@ HBTK::CubicSpline1D::CubicSpline1D(std::vector<double> point_locations, std::vec
 	m_point_locations(point_locations),
 	m_point_values(point_values),
 	m_derivative_x0(derivative_x0),
-	m_derivatives_computed(false)
+	m_derivative_state(not_computed),
+	m_compiled(false),
+	m_uniform_inverse_spacing(0)
 {
 }
 
@@ -127,44 +265,76 @@ HBTK::CubicSpline1D::CubicSpline1D(std::vector<double> point_locations, std::vec
 	m_natural_bc_xn(true),
 	m_point_locations(point_locations),
 	m_point_values(point_values),
-	m_derivatives_computed(false)
+	m_derivative_state(not_computed),
+	m_compiled(false),
+	m_uniform_inverse_spacing(0)
 {
 }
 
 HBTK::CubicSpline1D::CubicSpline1D(const CubicSpline1D & other)
-	: m_natural_bc_x0(other.m_natural_bc_x0),
-	m_natural_bc_xn(other.m_natural_bc_xn),
-	m_point_locations(other.m_point_locations),
+	: m_point_locations(other.m_point_locations),
 	m_point_values(other.m_point_values),
 	m_derivative_x0(other.m_derivative_x0),
 	m_derivative_xn(other.m_derivative_xn),
-	m_derivatives_computed(other.m_derivatives_computed)
+	m_natural_bc_x0(other.m_natural_bc_x0),
+	m_natural_bc_xn(other.m_natural_bc_xn),
+	m_derivative_state(not_computed),
+	m_compiled(false),
+	m_uniform_inverse_spacing(0)
+{
+	// Wait for any lazy setup of other to finish before copying its result.
+	const int state = other.settled_derivative_state();
+	m_second_derivatives = other.m_second_derivatives;
+	m_derivative_state.store(state);
+	if (other.m_compiled) { compile(); }
+}
+
+HBTK::CubicSpline1D::CubicSpline1D(CubicSpline1D && other)
+	: m_derivative_x0(other.m_derivative_x0),
+	m_derivative_xn(other.m_derivative_xn),
+	m_natural_bc_x0(other.m_natural_bc_x0),
+	m_natural_bc_xn(other.m_natural_bc_xn),
+	m_derivative_state(not_computed),
+	m_compiled(other.m_compiled),
+	m_uniform_inverse_spacing(other.m_uniform_inverse_spacing)
 {
+	// Lazy setup of other may still be reading the points and writing the
+	// derivatives on another thread: wait for it before taking them.
+	const int state = other.settled_derivative_state();
+	m_point_locations = std::move(other.m_point_locations);
+	m_point_values = std::move(other.m_point_values);
+	m_second_derivatives = std::move(other.m_second_derivatives);
+	// A moved vector keeps its buffer, so the coefficient table stays aligned.
+	m_coefficients = std::move(other.m_coefficients);
+	m_derivative_state.store(state);
+	other.m_derivative_state.store(not_computed);
+	other.m_compiled = false;
 }
 
 HBTK::CubicSpline1D::~CubicSpline1D()
 {
 }
 
-double HBTK::CubicSpline1D::operator()(double location)
+double HBTK::CubicSpline1D::operator()(double location) const
 {
 	return evaluate(location);
 }
 
-double HBTK::CubicSpline1D::evaluate(double location)
+double HBTK::CubicSpline1D::evaluate(double location) const
 {
+	if (m_compiled) {
+		int klo = compiled_interval(location, 0);
+		const double * c = compiled_coefficients() + 4 * klo;
+		double t = location - m_point_locations[klo];
+		return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+	}
 	check_computed_blocking();
-	int klo, khi, k;
+	int klo, khi;
 	double h, b, a, y;
 
-	// Bracketing of k in m_point_location
-	klo = 0;
-	khi = (int) m_point_locations.size() -1;
-	while (khi - klo > 1) {		// khi and klo must indicate adjacent indices.
-		k = (khi + klo) / 2;	// Compute midpoint
-		if (m_point_locations[k] > location) { khi = k; }
-		else { klo = k; }
-	}
+	// Bracketing of location in m_point_location
+	klo = find_interval(location, 0);
+	khi = klo + 1;
 	// And compute our position on the spline.
 	h = m_point_locations[khi] - m_point_locations[klo];
 	a = (m_point_locations[khi] - location) / h;
@@ -176,21 +346,22 @@ double HBTK::CubicSpline1D::evaluate(double location)
 	return y;
 }
 
-double HBTK::CubicSpline1D::derivative(double location)
+double HBTK::CubicSpline1D::derivative(double location) const
 {
+	if (m_compiled) {
+		int klo = compiled_interval(location, 0);
+		const double * c = compiled_coefficients() + 4 * klo;
+		double t = location - m_point_locations[klo];
+		return c[1] + t * (2. * c[2] + t * 3. * c[3]);
+	}
 	// Differentiated from above.
 	check_computed_blocking();
-	int klo, khi, k;
+	int klo, khi;
 	double h, a, b, da, db, y;
 
-	// Bracketing of k in m_point_location
-	klo = 0;
-	khi = (int)m_point_locations.size() - 1;
-	while (khi - klo > 1) {
-		k = (khi + klo) / 2;	// Compute midpoint
-		if (m_point_locations[k] > location) { khi = k; }
-		else { klo = k; }
-	}
+	// Bracketing of location in m_point_location
+	klo = find_interval(location, 0);
+	khi = klo + 1;
 	// And compute our position on the spline.
 	h = m_point_locations[khi] - m_point_locations[klo];
 	da = -1. / h;
@@ -204,21 +375,22 @@ double HBTK::CubicSpline1D::derivative(double location)
 	return y;
 }
 
-double HBTK::CubicSpline1D::derivative2(double location)
+double HBTK::CubicSpline1D::derivative2(double location) const
 {
+	if (m_compiled) {
+		int klo = compiled_interval(location, 0);
+		const double * c = compiled_coefficients() + 4 * klo;
+		double t = location - m_point_locations[klo];
+		return 2. * c[2] + 6. * t * c[3];
+	}
 	// Differentiated from above.
 	check_computed_blocking();
-	int klo, khi, k;
+	int klo, khi;
 	double h, a, b, da, db, y;
 
-	// Bracketing of k in m_point_location
-	klo = 0;
-	khi = (int)m_point_locations.size() - 1;
-	while (khi - klo > 1) {
-		k = (khi + klo) / 2;	// Compute midpoint
-		if (m_point_locations[k] > location) { khi = k; }
-		else { klo = k; }
-	}
+	// Bracketing of location in m_point_location
+	klo = find_interval(location, 0);
+	khi = klo + 1;
 	// And compute our position on the spline.
 	h = m_point_locations[khi] - m_point_locations[klo];
 	da = -1. / h;
@@ -231,21 +403,20 @@ double HBTK::CubicSpline1D::derivative2(double location)
 	return y;
 }
 
-double HBTK::CubicSpline1D::derivative3(double location)
+double HBTK::CubicSpline1D::derivative3(double location) const
 {
+	if (m_compiled) {
+		int klo = compiled_interval(location, 0);
+		return 6. * compiled_coefficients()[4 * klo + 3];
+	}
 	// Differentiated from above.
 	check_computed_blocking();
-	int klo, khi, k;
+	int klo, khi;
 	double h, da, db, y;
 
-	// Bracketing of k in m_point_location
-	klo = 0;
-	khi = (int)m_point_locations.size() - 1;
-	while (khi - klo > 1) {
-		k = (khi + klo) / 2;	// Compute midpoint
-		if (m_point_locations[k] > location) { khi = k; }
-		else { klo = k; }
-	}
+	// Bracketing of location in m_point_location
+	klo = find_interval(location, 0);
+	khi = klo + 1;
 	// And compute our position on the spline.
 	h = m_point_locations[khi] - m_point_locations[klo];
 	da = -1. / h;
@@ -256,7 +427,7 @@ double HBTK::CubicSpline1D::derivative3(double location)
 	return y;
 }
 
-double HBTK::CubicSpline1D::derivative(double location, int n)
+double HBTK::CubicSpline1D::derivative(double location, int n) const
 {
 	assert(n >= 0);
 	double val;
@@ -280,22 +451,203 @@ double HBTK::CubicSpline1D::derivative(double location, int n)
 	return val;
 }
 
-double HBTK::CubicSpline1D::lower_input_bound()
+std::vector<double> HBTK::CubicSpline1D::evaluate(const std::vector<double>& locations) const
+{
+	const int n = (int)locations.size();
+	if (m_compiled) {
+		std::vector<double> values(n);
+		const double * coeffs = compiled_coefficients();
+		const double * x = m_point_locations.data();
+		int klo = 0;
+		for (int i = 0; i < n; i++) {
+			klo = compiled_interval(locations[i], klo);
+			const double * c = coeffs + 4 * klo;
+			const double t = locations[i] - x[klo];
+			values[i] = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+		}
+		return values;
+	}
+	check_computed_blocking();
+	std::vector<int> intervals;
+	find_intervals(locations, intervals);
+	const double * x = m_point_locations.data();
+	const double * y = m_point_values.data();
+	const double * yd2 = m_second_derivatives.data();
+	const int * idx = intervals.data();
+	std::vector<double> values(n);
+	double * v = values.data();
+	// Bracketing is done up front so that this loop has no branches
+	// and can be vectorised by the compiler.
+	for (int i = 0; i < n; i++) {
+		const int klo = idx[i];
+		const double h = x[klo + 1] - x[klo];
+		const double a = (x[klo + 1] - locations[i]) / h;
+		const double b = (locations[i] - x[klo]) / h;
+		v[i] = a * y[klo] + b * y[klo + 1]
+			+ ((a * a * a - a) * yd2[klo]
+				+ (b * b * b - b) * yd2[klo + 1])
+			* (h * h) / 6.0;
+	}
+	return values;
+}
+
+void HBTK::CubicSpline1D::evaluate(const std::vector<double>& locations,
+	std::vector<double>& values, std::vector<double>& derivatives,
+	std::vector<double>& derivatives2, std::vector<double>& derivatives3) const
+{
+	const int n = (int)locations.size();
+	values.resize(n);
+	derivatives.resize(n);
+	derivatives2.resize(n);
+	derivatives3.resize(n);
+	if (m_compiled) {
+		const double * coeffs = compiled_coefficients();
+		const double * x = m_point_locations.data();
+		int klo = 0;
+		for (int i = 0; i < n; i++) {
+			klo = compiled_interval(locations[i], klo);
+			const double * c = coeffs + 4 * klo;
+			const double t = locations[i] - x[klo];
+			values[i] = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+			derivatives[i] = c[1] + t * (2. * c[2] + t * 3. * c[3]);
+			derivatives2[i] = 2. * c[2] + 6. * t * c[3];
+			derivatives3[i] = 6. * c[3];
+		}
+		return;
+	}
+	check_computed_blocking();
+	std::vector<int> intervals;
+	find_intervals(locations, intervals);
+	const double * x = m_point_locations.data();
+	const double * y = m_point_values.data();
+	const double * yd2 = m_second_derivatives.data();
+	const int * idx = intervals.data();
+	double * v = values.data();
+	double * d1 = derivatives.data();
+	double * d2 = derivatives2.data();
+	double * d3 = derivatives3.data();
+	// Same expressions as the scalar evaluation functions.
+	for (int i = 0; i < n; i++) {
+		const int klo = idx[i];
+		const double h = x[klo + 1] - x[klo];
+		const double da = -1. / h;
+		const double db = 1. / h;
+		const double a = (x[klo + 1] - locations[i]) / h;
+		const double b = (locations[i] - x[klo]) / h;
+		v[i] = a * y[klo] + b * y[klo + 1]
+			+ ((a * a * a - a) * yd2[klo]
+				+ (b * b * b - b) * yd2[klo + 1])
+			* (h * h) / 6.0;
+		d1[i] = da * y[klo] + db * y[klo + 1]
+			+ (da * (3. * a * a - 1.) * yd2[klo]
+				+ db * (3. * b * b - 1.) * yd2[klo + 1])
+			* (h * h) / 6.0;
+		d2[i] = (da * da * a * yd2[klo]
+			+ db * db * b * yd2[klo + 1])
+			* (h * h);
+		d3[i] = (da * da * da * yd2[klo]
+			+ db * db * db * yd2[klo + 1])
+			* (h * h);
+	}
+	return;
+}
+
+void HBTK::CubicSpline1D::compile()
+{
+	const std::vector<double> & x = m_point_locations;
+	const int n = (int)m_point_locations.size();
+	if (n < 2) {
+		throw std::domain_error(
+			"HBTK::CubicSpline1D::compile: a spline needs at least 2 points "
+			"to compile, but has " + std::to_string(n) + ". " __FILE__
+			+ " : " + std::to_string(__LINE__)
+		);
+	}
+	m_compiled = false;
+	// 8 doubles of padding allows alignment to a 64 byte cache line.
+	m_coefficients.resize(4 * (n - 1) + 8);
+	compute_coefficients(const_cast<double*>(compiled_coefficients()));
+	// Check for a uniform grid.
+	double spacing = (x.back() - x[0]) / (n - 1);
+	bool uniform = true;
+	for (int i = 1; i < n; i++) {
+		if (std::abs(x[i] - (x[0] + i * spacing)) > 1e-12 * std::abs(x.back() - x[0])) {
+			uniform = false;
+			break;
+		}
+	}
+	m_uniform_inverse_spacing = uniform ? 1. / spacing : 0.;
+	m_compiled = true;
+	return;
+}
+
+void HBTK::CubicSpline1D::compute_coefficients(double * c) const
+{
+	check_computed_blocking();
+	const std::vector<double> & x = m_point_locations;
+	const std::vector<double> & y = m_point_values;
+	const std::vector<double> & yd2 = m_second_derivatives;
+	const int n = (int)m_point_locations.size();
+	for (int i = 0; i < n - 1; i++) {
+		double h = x[i + 1] - x[i];
+		c[4 * i] = y[i];
+		c[4 * i + 1] = (y[i + 1] - y[i]) / h - h * (2. * yd2[i] + yd2[i + 1]) / 6.;
+		c[4 * i + 2] = yd2[i] / 2.;
+		c[4 * i + 3] = (yd2[i + 1] - yd2[i]) / (6. * h);
+	}
+	return;
+}
+
+std::vector<double> HBTK::CubicSpline1D::polynomial_coefficients() const
+{
+	std::vector<double> coefficients(4 * (m_point_locations.size() - 1));
+	compute_coefficients(coefficients.data());
+	return coefficients;
+}
+
+bool HBTK::CubicSpline1D::is_compiled() const
+{
+	return m_compiled;
+}
+
+const double * HBTK::CubicSpline1D::compiled_coefficients() const
+{
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(m_coefficients.data());
+	std::uintptr_t aligned = (address + 63) & ~(std::uintptr_t)63;
+	return m_coefficients.data() + (aligned - address) / sizeof(double);
+}
+
+int HBTK::CubicSpline1D::compiled_interval(double location, int guess) const
+{
+	if (m_uniform_inverse_spacing != 0.) {
+		const double last = (double)m_point_locations.size() - 2;
+		double k = (location - m_point_locations[0]) * m_uniform_inverse_spacing;
+		k = k >= 0. ? k : 0.;	// Also catches NaN.
+		k = k <= last ? k : last;
+		return (int)k;
+	}
+	return find_interval(location, guess);
+}
+
+double HBTK::CubicSpline1D::lower_input_bound() const
 {
 	return m_point_locations[0];
 }
 
-double HBTK::CubicSpline1D::upper_input_bound()
+double HBTK::CubicSpline1D::upper_input_bound() const
 {
 	return m_point_locations.back();
 }
 
-HBTK::CubicSpline1D & HBTK::CubicSpline1D::operator=(CubicSpline1D & spline)
+const std::vector<double> & HBTK::CubicSpline1D::point_locations() const
+{
+	return m_point_locations;
+}
+
+HBTK::CubicSpline1D & HBTK::CubicSpline1D::operator=(const CubicSpline1D & spline)
 {
 	if (this != &spline) {
-		std::lock(m_deriv_compute_mutex, spline.m_deriv_compute_mutex);
-		std::lock_guard<std::mutex> lhs_lk(m_deriv_compute_mutex, std::adopt_lock);
-		std::lock_guard<std::mutex> rhs_lk(spline.m_deriv_compute_mutex, std::adopt_lock);
+		m_derivative_state.store(spline.settled_derivative_state());
 		m_point_locations = spline.m_point_locations;
 		m_point_values = spline.m_point_values;
 		m_second_derivatives = spline.m_second_derivatives;
@@ -303,7 +655,56 @@ HBTK::CubicSpline1D & HBTK::CubicSpline1D::operator=(CubicSpline1D & spline)
 		m_derivative_xn = spline.m_derivative_xn;
 		m_natural_bc_x0 = spline.m_natural_bc_x0;
 		m_natural_bc_xn = spline.m_natural_bc_xn;
-		m_derivatives_computed = spline.m_derivatives_computed;
+		m_compiled = false;
+		m_uniform_inverse_spacing = 0;
+		if (spline.m_compiled) { compile(); }
 	}
 	return *this;
 }
+
+HBTK::CubicSpline1D & HBTK::CubicSpline1D::operator=(CubicSpline1D && spline)
+{
+	if (this != &spline) {
+		m_derivative_state.store(spline.settled_derivative_state());
+		m_point_locations = std::move(spline.m_point_locations);
+		m_point_values = std::move(spline.m_point_values);
+		m_second_derivatives = std::move(spline.m_second_derivatives);
+		m_derivative_x0 = spline.m_derivative_x0;
+		m_derivative_xn = spline.m_derivative_xn;
+		m_natural_bc_x0 = spline.m_natural_bc_x0;
+		m_natural_bc_xn = spline.m_natural_bc_xn;
+		m_coefficients = std::move(spline.m_coefficients);
+		m_compiled = spline.m_compiled;
+		m_uniform_inverse_spacing = spline.m_uniform_inverse_spacing;
+		spline.m_derivative_state.store(not_computed);
+		spline.m_compiled = false;
+	}
+	return *this;
+}
+
+std::vector<HBTK::CubicSpline1D> HBTK::CubicSpline1D::construct_many(
+	const std::vector<std::vector<double>>& point_locations, 
+	const std::vector<std::vector<double>>& point_values, int num_threads)
+{
+	assert(point_locations.size() == point_values.size());
+	std::vector<CubicSpline1D> splines;
+	splines.reserve(point_values.size());
+	for (int i = 0; i < (int)point_values.size(); i++) {
+		splines.emplace_back(point_locations[i], point_values[i]);
+	}
+	compute_second_derivatives_threaded(splines, num_threads);
+	return splines;
+}
+
+std::vector<HBTK::CubicSpline1D> HBTK::CubicSpline1D::construct_many(
+	const std::vector<double>& point_locations,
+	const std::vector<std::vector<double>>& point_values, int num_threads)
+{
+	std::vector<CubicSpline1D> splines;
+	splines.reserve(point_values.size());
+	for (int i = 0; i < (int)point_values.size(); i++) {
+		splines.emplace_back(point_locations, point_values[i]);
+	}
+	compute_second_derivatives_threaded(splines, num_threads);
+	return splines;
+}
@@ -0,0 +1,382 @@
+#include "DenseLinearSolvers.h"
+/*////////////////////////////////////////////////////////////////////////////
+DenseLinearSolvers.cpp
+
+Direct and iterative solution of dense linear systems, such as those made
+from panel influence matrices.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "ParallelFor.h"
+
+namespace {
+	// Columns factorised together as a panel. The trailing update is a 
+	// matrix product with this inner dimension.
+	const int lu_block_size = 64;
+	// Columns of the trailing matrix per tile. A block size by tile width
+	// block of U fits in L2 cache.
+	const int lu_tile_width = 256;
+	// Rows of the trailing matrix per tile.
+	const int lu_tile_height = 32;
+	// Register block of the trailing update.
+	const int micro_rows = 8;
+	const int micro_cols = 4;
+	// Rows per parallel task of a matrix-vector product.
+	const int matvec_rows_per_task = 64;
+
+	// Unblocked factorisation of columns [k0, k1), swapping whole rows.
+	void factorise_panel(HBTK::DenseMatrix & a, std::vector<int> & pivots, int k0, int k1)
+	{
+		const int n = a.rows();
+		for (int j = k0; j < k1; j++) {
+			int pivot = j;
+			double pivot_magnitude = std::abs(a(j, j));
+			for (int i = j + 1; i < n; i++) {
+				if (std::abs(a(i, j)) > pivot_magnitude) {
+					pivot = i;
+					pivot_magnitude = std::abs(a(i, j));
+				}
+			}
+			if (pivot_magnitude == 0) {
+				throw std::runtime_error(
+					"HBTK::LUFactorisation::LUFactorisation: matrix is singular "
+					"(zero pivot in column " + std::to_string(j) + "). " 
+					__FILE__ ":" + std::to_string(__LINE__));
+			}
+			pivots[j] = pivot;
+			if (pivot != j) { std::swap_ranges(a.row(j), a.row(j) + n, a.row(pivot)); }
+
+			const double * __restrict u = a.row(j);
+			const double inverse = 1. / u[j];
+			for (int i = j + 1; i < n; i++) {
+				double * __restrict row = a.row(i);
+				const double l = row[j] * inverse;
+				row[j] = l;
+				for (int c = j + 1; c < k1; c++) { row[c] -= l * u[c]; }
+			}
+		}
+	}
+
+	// U12 = L11^-1 A12 for the rows [k0, k1) right of the panel.
+	void solve_block_row(HBTK::DenseMatrix & a, int k0, int k1, int num_threads)
+	{
+		const int n = a.rows();
+		const int n_tiles = (n - k1 + lu_tile_width - 1) / lu_tile_width;
+		auto task = [&](int tile) {
+			const int c0 = k1 + tile * lu_tile_width;
+			const int c1 = std::min(c0 + lu_tile_width, n);
+			for (int i = k0 + 1; i < k1; i++) {
+				double * __restrict row = a.row(i);
+				for (int p = k0; p < i; p++) {
+					const double l = row[p];
+					const double * __restrict u = a.row(p);
+					for (int c = c0; c < c1; c++) { row[c] -= l * u[c]; }
+				}
+			}
+		};
+		HBTK::parallel_for(n_tiles, num_threads, task);
+	}
+
+	// A22 -= L21 U12 for the matrix below and right of the panel.
+	void update_trailing_matrix(HBTK::DenseMatrix & a, int k0, int k1, int num_threads)
+	{
+		const int n = a.rows();
+		const int n_tile_rows = (n - k1 + lu_tile_height - 1) / lu_tile_height;
+		const int n_tile_cols = (n - k1 + lu_tile_width - 1) / lu_tile_width;
+		// row[c0, c1) -= row[k0, k1) U12.
+		auto update_row = [&](double * __restrict row, int c0, int c1) {
+			for (int p = k0; p < k1; p++) {
+				const double l = row[p];
+				const double * __restrict u = a.row(p);
+				for (int c = c0; c < c1; c++) { row[c] -= l * u[c]; }
+			}
+		};
+		// Consecutive tasks share a tile column so that U12 stays in cache.
+		auto task = [&](int tile) {
+			const int c0 = k1 + (tile / n_tile_rows) * lu_tile_width;
+			const int c1 = std::min(c0 + lu_tile_width, n);
+			const int r0 = k1 + (tile % n_tile_rows) * lu_tile_height;
+			const int r1 = std::min(r0 + lu_tile_height, n);
+			// Copy U12 into strips micro_cols wide, so that the register 
+			// block reads it contiguously.
+			const int n_strips = (c1 - c0) / micro_cols;
+			const int kb = k1 - k0;
+			std::vector<double> packed((size_t)n_strips * kb * micro_cols);
+			for (int p = k0; p < k1; p++) {
+				const double * u = a.row(p) + c0;
+				for (int s = 0; s < n_strips; s++) {
+					for (int q = 0; q < micro_cols; q++) {
+						packed[((size_t)s * kb + p - k0) * micro_cols + q] = u[s * micro_cols + q];
+					}
+				}
+			}
+			const int c_packed = c0 + n_strips * micro_cols;
+			int i = r0;
+			// Blocks of rows by columns are accumulated in registers over 
+			// the whole panel before being written back.
+			for (; i + micro_rows <= r1; i += micro_rows) {
+				double * rows[micro_rows];
+				for (int r = 0; r < micro_rows; r++) { rows[r] = a.row(i + r); }
+				for (int s = 0; s < n_strips; s++) {
+					const double * __restrict u = packed.data() + (size_t)s * kb * micro_cols;
+					double sum[micro_rows][micro_cols] = {};
+					for (int p = 0; p < kb; p++, u += micro_cols) {
+						for (int r = 0; r < micro_rows; r++) {
+							const double l = rows[r][k0 + p];
+							for (int q = 0; q < micro_cols; q++) { sum[r][q] += l * u[q]; }
+						}
+					}
+					for (int r = 0; r < micro_rows; r++) {
+						double * __restrict c = rows[r] + c0 + s * micro_cols;
+						for (int q = 0; q < micro_cols; q++) { c[q] -= sum[r][q]; }
+					}
+				}
+				for (int r = 0; r < micro_rows; r++) { update_row(rows[r], c_packed, c1); }
+			}
+			for (; i < r1; i++) { update_row(a.row(i), c0, c1); }
+		};
+		HBTK::parallel_for(n_tile_rows * n_tile_cols, num_threads, task);
+	}
+
+	double dot(const std::vector<double> & a, const std::vector<double> & b)
+	{
+		double sum = 0;
+		for (size_t i = 0; i < a.size(); i++) { sum += a[i] * b[i]; }
+		return sum;
+	}
+
+	double norm(const std::vector<double> & a)
+	{
+		return std::sqrt(dot(a, a));
+	}
+}
+
+HBTK::LUFactorisation::LUFactorisation()
+{
+}
+
+HBTK::LUFactorisation::LUFactorisation(const DenseMatrix & matrix, int num_threads)
+	: m_lu(matrix)
+{
+	factorise(num_threads);
+}
+
+HBTK::LUFactorisation::LUFactorisation(DenseMatrix && matrix, int num_threads)
+	: m_lu(std::move(matrix))
+{
+	factorise(num_threads);
+}
+
+int HBTK::LUFactorisation::size() const noexcept
+{
+	return m_lu.rows();
+}
+
+std::vector<double> HBTK::LUFactorisation::solve(const std::vector<double> & rhs) const
+{
+	std::vector<double> result(rhs);
+	solve_in_place(result);
+	return result;
+}
+
+void HBTK::LUFactorisation::solve_in_place(std::vector<double> & rhs) const
+{
+	const int n = size();
+	assert((int)rhs.size() == n);
+	for (int i = 0; i < n; i++) { std::swap(rhs[i], rhs[m_pivots[i]]); }
+	// L y = P b, then U x = y. Both use contiguous rows of the factors.
+	for (int i = 1; i < n; i++) {
+		const double * row = m_lu.row(i);
+		double sum = 0;
+		for (int j = 0; j < i; j++) { sum += row[j] * rhs[j]; }
+		rhs[i] -= sum;
+	}
+	for (int i = n - 1; i >= 0; i--) {
+		const double * row = m_lu.row(i);
+		double sum = 0;
+		for (int j = i + 1; j < n; j++) { sum += row[j] * rhs[j]; }
+		rhs[i] = (rhs[i] - sum) / row[i];
+	}
+}
+
+const HBTK::DenseMatrix & HBTK::LUFactorisation::factors() const noexcept
+{
+	return m_lu;
+}
+
+const std::vector<int>& HBTK::LUFactorisation::pivots() const noexcept
+{
+	return m_pivots;
+}
+
+void HBTK::LUFactorisation::factorise(int num_threads)
+{
+	assert(num_threads > 0);
+	if (m_lu.rows() != m_lu.cols()) {
+		throw std::runtime_error(
+			"HBTK::LUFactorisation::LUFactorisation: matrix is not square. " 
+			__FILE__ ":" + std::to_string(__LINE__));
+	}
+	const int n = m_lu.rows();
+	m_pivots.resize(n);
+	// Right looking: factorise a panel of columns, then apply it to 
+	// the rest of the matrix as a tiled matrix product.
+	for (int k0 = 0; k0 < n; k0 += lu_block_size) {
+		const int k1 = std::min(k0 + lu_block_size, n);
+		factorise_panel(m_lu, m_pivots, k0, k1);
+		if (k1 < n) {
+			solve_block_row(m_lu, k0, k1, num_threads);
+			update_trailing_matrix(m_lu, k0, k1, num_threads);
+		}
+	}
+}
+
+std::vector<double> HBTK::gmres(const LinearOperator & matrix, 
+	const std::vector<double> & rhs, const std::vector<double> & initial_guess,
+	double tolerance, int restart, int max_iterations,
+	const LinearOperator & preconditioner, IterativeSolveReport * report)
+{
+	assert(matrix);
+	assert(initial_guess.empty() || initial_guess.size() == rhs.size());
+	assert(tolerance >= 0);
+	assert(restart > 0);
+	assert(max_iterations >= 0);
+	const size_t n = rhs.size();
+	std::vector<double> x(initial_guess.empty() ? std::vector<double>(n, 0.) : initial_guess);
+	IterativeSolveReport result;
+
+	const double rhs_norm = norm(rhs);
+	if (rhs_norm == 0) {
+		std::fill(x.begin(), x.end(), 0.);
+		result.converged = true;
+		if (report) { *report = result; }
+		return x;
+	}
+
+	// Arnoldi basis, Hessenberg matrix (column major), Givens rotations 
+	// and the rotated residual vector.
+	std::vector<std::vector<double>> basis(restart + 1, std::vector<double>(n));
+	std::vector<double> hessenberg((size_t)(restart + 1) * restart);
+	std::vector<double> cosines(restart), sines(restart), g(restart + 1);
+	std::vector<double> work(n), preconditioned(n);
+	auto h = [&](int row, int col)->double& { return hessenberg[(size_t)col * (restart + 1) + row]; };
+
+	while (true) {
+		matrix(x, work);
+		for (size_t i = 0; i < n; i++) { work[i] = rhs[i] - work[i]; }
+		const double beta = norm(work);
+		result.residual = beta / rhs_norm;
+		if (result.residual <= tolerance || result.iterations >= max_iterations) { break; }
+
+		for (size_t i = 0; i < n; i++) { basis[0][i] = work[i] / beta; }
+		std::fill(g.begin(), g.end(), 0.);
+		g[0] = beta;
+		int k = 0;
+		while (k < restart && result.iterations < max_iterations) {
+			if (preconditioner) {
+				preconditioner(basis[k], preconditioned);
+				matrix(preconditioned, work);
+			}
+			else {
+				matrix(basis[k], work);
+			}
+			result.iterations++;
+			// Modified Gram-Schmidt.
+			for (int j = 0; j <= k; j++) {
+				const double hjk = dot(work, basis[j]);
+				h(j, k) = hjk;
+				for (size_t i = 0; i < n; i++) { work[i] -= hjk * basis[j][i]; }
+			}
+			const double next_norm = norm(work);
+			h(k + 1, k) = next_norm;
+			if (next_norm > 0) {
+				for (size_t i = 0; i < n; i++) { basis[k + 1][i] = work[i] / next_norm; }
+			}
+			for (int j = 0; j < k; j++) {
+				const double a = h(j, k), b = h(j + 1, k);
+				h(j, k) = cosines[j] * a + sines[j] * b;
+				h(j + 1, k) = -sines[j] * a + cosines[j] * b;
+			}
+			const double radius = std::hypot(h(k, k), h(k + 1, k));
+			cosines[k] = h(k, k) / radius;
+			sines[k] = h(k + 1, k) / radius;
+			h(k, k) = radius;
+			h(k + 1, k) = 0;
+			g[k + 1] = -sines[k] * g[k];
+			g[k] = cosines[k] * g[k];
+			k++;
+			if (std::abs(g[k]) <= tolerance * rhs_norm || next_norm == 0) { break; }
+		}
+
+		// Minimise the residual over the subspace, then update x.
+		std::vector<double> y(g.begin(), g.begin() + k);
+		for (int i = k - 1; i >= 0; i--) {
+			for (int j = i + 1; j < k; j++) { y[i] -= h(i, j) * y[j]; }
+			y[i] /= h(i, i);
+		}
+		std::fill(work.begin(), work.end(), 0.);
+		for (int j = 0; j < k; j++) {
+			for (size_t i = 0; i < n; i++) { work[i] += y[j] * basis[j][i]; }
+		}
+		if (preconditioner) {
+			preconditioner(work, preconditioned);
+			work.swap(preconditioned);
+		}
+		for (size_t i = 0; i < n; i++) { x[i] += work[i]; }
+	}
+	result.converged = result.residual <= tolerance;
+	if (report) { *report = result; }
+	return x;
+}
+
+std::vector<double> HBTK::gmres(const DenseMatrix & matrix, 
+	const std::vector<double> & rhs, const std::vector<double> & initial_guess,
+	double tolerance, int restart, int max_iterations,
+	int num_threads, IterativeSolveReport * report)
+{
+	assert(matrix.rows() == matrix.cols());
+	assert((int)rhs.size() == matrix.rows());
+	assert(num_threads > 0);
+	LinearOperator product = [&](const std::vector<double> & x, std::vector<double> & result) {
+		const int n_rows = matrix.rows();
+		auto task = [&](int task_index) {
+			const int r0 = task_index * matvec_rows_per_task;
+			const int r1 = std::min(r0 + matvec_rows_per_task, n_rows);
+			for (int i = r0; i < r1; i++) {
+				const double * row = matrix.row(i);
+				double sum = 0;
+				for (int j = 0; j < matrix.cols(); j++) { sum += row[j] * x[j]; }
+				result[i] = sum;
+			}
+		};
+		const int n_tasks = (n_rows + matvec_rows_per_task - 1) / matvec_rows_per_task;
+		HBTK::parallel_for(n_tasks, num_threads, task);
+	};
+	return gmres(product, rhs, initial_guess, tolerance, restart, max_iterations, 
+		LinearOperator(), report);
+}
@@ -0,0 +1,70 @@
+#include "DenseMatrix.h"
+/*////////////////////////////////////////////////////////////////////////////
+DenseMatrix.cpp
+
+A dense, row major matrix of doubles.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+HBTK::DenseMatrix::DenseMatrix()
+	: m_rows(0),
+	m_cols(0)
+{
+}
+
+HBTK::DenseMatrix::DenseMatrix(int rows, int cols, double value)
+	: m_rows(rows),
+	m_cols(cols),
+	m_data((size_t)rows * cols, value)
+{
+	assert(rows >= 0);
+	assert(cols >= 0);
+}
+
+void HBTK::DenseMatrix::resize(int rows, int cols, double value)
+{
+	assert(rows >= 0);
+	assert(cols >= 0);
+	m_rows = rows;
+	m_cols = cols;
+	m_data.assign((size_t)rows * cols, value);
+}
+
+std::vector<double> HBTK::DenseMatrix::operator*(const std::vector<double> & vector) const
+{
+	assert((int)vector.size() == m_cols);
+	std::vector<double> result(m_rows);
+	for (int i = 0; i < m_rows; i++) {
+		const double * r = row(i);
+		double sum = 0;
+		for (int j = 0; j < m_cols; j++) { sum += r[j] * vector[j]; }
+		result[i] = sum;
+	}
+	return result;
+}
+
+HBTK::DenseMatrix HBTK::DenseMatrix::identity(int size)
+{
+	DenseMatrix result(size, size);
+	for (int i = 0; i < size; i++) { result(i, i) = 1; }
+	return result;
+}
@@ -0,0 +1,196 @@
+#include "GaussKronrod.h"
+/*////////////////////////////////////////////////////////////////////////////
+GaussKronrod.cpp
+
+Globally adaptive Gauss-Kronrod integration with extrapolation.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+namespace {
+	// Tables computed to 120 digits from the Stieltjes polynomials. They 
+	// agree with QUADPACK's qk15, qk21 and qk61.
+	const double gk15_nodes[8] = {
+		0.991455371120812639207, 0.949107912342758524526, 0.86486442335976907279,
+		0.741531185599394439864, 0.586087235467691130294, 0.405845151377397166907,
+		0.207784955007898467601, 0.0 };
+	const double gk15_kronrod_weights[8] = {
+		0.0229353220105292249637, 0.0630920926299785532907, 0.10479001032225018384,
+		0.140653259715525918745, 0.169004726639267902827, 0.190350578064785409913,
+		0.204432940075298892414, 0.209482141084727828013 };
+	const double gk15_gauss_weights[8] = {
+		0.0, 0.129484966168869693271, 0.0,
+		0.279705391489276667901, 0.0, 0.38183005050511894495,
+		0.0, 0.417959183673469387755 };
+	const double gk21_nodes[11] = {
+		0.995657163025808080736, 0.973906528517171720078, 0.930157491355708226001,
+		0.865063366688984510732, 0.780817726586416897064, 0.679409568299024406234,
+		0.562757134668604683339, 0.433395394129247190799, 0.294392862701460198131,
+		0.148874338981631210885, 0.0 };
+	const double gk21_kronrod_weights[11] = {
+		0.0116946388673718742781, 0.0325581623079647274788, 0.0547558965743519960314,
+		0.075039674810919952767, 0.0931254545836976055351, 0.109387158802297641899,
+		0.123491976262065851078, 0.134709217311473325928, 0.142775938577060080797,
+		0.147739104901338491375, 0.149445554002916905665 };
+	const double gk21_gauss_weights[11] = {
+		0.0, 0.0666713443086881375936, 0.0,
+		0.149451349150580593146, 0.0, 0.219086362515982043996,
+		0.0, 0.269266719309996355091, 0.0,
+		0.295524224714752870174, 0.0 };
+	const double gk61_nodes[31] = {
+		0.999484410050490637571, 0.996893484074649540272, 0.991630996870404594859,
+		0.98366812327974720997, 0.973116322501126268375, 0.960021864968307512217,
+		0.944374444748559979416, 0.926200047429274325879, 0.905573307699907798547,
+		0.882560535792052681543, 0.857205233546061098959, 0.829565762382768397443,
+		0.799727835821839083014, 0.767777432104826194918, 0.733790062453226804726,
+		0.697850494793315796932, 0.66006106412662696137, 0.62052618298924286114,
+		0.579345235826361691756, 0.536624148142019899264, 0.492480467861778574994,
+		0.447033769538089176781, 0.400401254830394392535, 0.352704725530878113471,
+		0.304073202273625077373, 0.25463692616788984644, 0.204525116682309891439,
+		0.153869913608583546964, 0.102806937966737030147, 0.051471842555317695833,
+		0.0 };
+	const double gk61_kronrod_weights[31] = {
+		0.00138901369867700762455, 0.00389046112709988405127, 0.00663070391593129217332,
+		0.00927327965951776342844, 0.0118230152534963417422, 0.0143697295070458048125,
+		0.0169208891890532726276, 0.0194141411939423811734, 0.0218280358216091922972,
+		0.0241911620780806013657, 0.0265099548823331016106, 0.028754048765041292844,
+		0.0309072575623877624729, 0.0329814470574837260318, 0.0349793380280600241375,
+		0.0368823646518212292239, 0.0386789456247275929503, 0.040374538951535959112,
+		0.0419698102151642461471, 0.0434525397013560693168, 0.0448148001331626631924,
+		0.0460592382710069881163, 0.0471855465692991539453, 0.0481858617570871291408,
+		0.0490554345550297788875, 0.0497956834270742063578, 0.0504059214027823468409,
+		0.0508817958987496064923, 0.0512215478492587721707, 0.0514261285374590259339,
+		0.0514947294294515675583 };
+	const double gk61_gauss_weights[31] = {
+		0.0, 0.00796819249616660561547, 0.0,
+		0.0184664683110909591423, 0.0, 0.0287847078833233693497,
+		0.0, 0.0387991925696270495968, 0.0,
+		0.0484026728305940529029, 0.0, 0.0574931562176190664817,
+		0.0, 0.0659742298821804951281, 0.0,
+		0.0737559747377052062682, 0.0, 0.0807558952294202153547,
+		0.0, 0.0868997872010829798024, 0.0,
+		0.0921225222377861287176, 0.0, 0.0963687371746442596395,
+		0.0, 0.0995934205867952670628, 0.0,
+		0.101762389748405504596, 0.0, 0.102852652893558840341,
+		0.0 };
+}
+
+/// \param rule a Gauss-Kronrod rule.
+///
+/// \brief Get the nodes and weights of a Gauss-Kronrod rule.
+///
+/// The returned pointers are to static tables and are always valid.
+HBTK::GaussKronrodTable HBTK::gauss_kronrod_table(gauss_kronrod_rule rule)
+{
+	switch (rule) {
+	case gauss_kronrod_7_15:
+		return GaussKronrodTable{ 8, gk15_nodes, gk15_kronrod_weights, gk15_gauss_weights };
+	case gauss_kronrod_10_21:
+		return GaussKronrodTable{ 11, gk21_nodes, gk21_kronrod_weights, gk21_gauss_weights };
+	case gauss_kronrod_30_61:
+		return GaussKronrodTable{ 31, gk61_nodes, gk61_kronrod_weights, gk61_gauss_weights };
+	default:
+		assert(false);
+		return GaussKronrodTable{ 11, gk21_nodes, gk21_kronrod_weights, gk21_gauss_weights };
+	}
+}
+
+HBTK::WynnEpsilon::WynnEpsilon(int max_terms)
+	: m_max_terms(max_terms),
+	m_result(0),
+	m_error(std::numeric_limits<double>::infinity())
+{
+	assert(max_terms > 2);
+}
+
+/// \param term the next term of the sequence.
+///
+/// \brief Add a term and update the estimate of the limit.
+void HBTK::WynnEpsilon::add(double term)
+{
+	m_terms.push_back(term);
+	if ((int)m_terms.size() > m_max_terms) { m_terms.erase(m_terms.begin()); }
+	const int n = (int)m_terms.size();
+
+	// Build the table column by column. before is column j-2, previous 
+	// is column j-1. The even columns estimate the limit.
+	std::vector<double> before(n + 1, 0.0), previous(m_terms), current;
+	double estimate = m_terms.back();
+	for (int j = 1; j < n; j++) {
+		current.resize(n - j);
+		bool stable = true;
+		for (int k = 0; k < n - j; k++) {
+			double difference = previous[k + 1] - previous[k];
+			if (std::abs(difference) <= DBL_EPSILON * std::abs(previous[k + 1])) {
+				// Column j-1 has converged. Going further would divide by ~0.
+				stable = false;
+				break;
+			}
+			current[k] = before[k + 1] + 1 / difference;
+		}
+		if (!stable) { break; }
+		if (j % 2 == 0) { estimate = current.back(); }
+		before.swap(previous);
+		previous.swap(current);
+	}
+
+	if (m_last_results.size() == 3) {
+		m_error = std::abs(estimate - m_last_results[0]) + std::abs(estimate - m_last_results[1])
+			+ std::abs(estimate - m_last_results[2]);
+		m_error = std::max(m_error, 5 * DBL_EPSILON * std::abs(estimate));
+	}
+	else {
+		m_error = std::numeric_limits<double>::infinity();
+	}
+	m_last_results.push_back(estimate);
+	if (m_last_results.size() > 3) { m_last_results.erase(m_last_results.begin()); }
+	m_result = estimate;
+	return;
+}
+
+double HBTK::WynnEpsilon::result() const
+{
+	return m_result;
+}
+
+double HBTK::WynnEpsilon::error_estimate() const
+{
+	return m_error;
+}
+
+int HBTK::WynnEpsilon::size() const
+{
+	return (int)m_terms.size();
+}
+
+void HBTK::WynnEpsilon::clear()
+{
+	m_terms.clear();
+	m_last_results.clear();
+	m_result = 0;
+	m_error = std::numeric_limits<double>::infinity();
+}
@@ -24,13 +24,156 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
+#include <cassert>
+#include <cmath>
 #include <tuple>
 
+/// \param n_points number of gauss points desired
+///
+/// \brief generate a gauss legendre quadrature on [-1, 1]
+///
+/// For more than 100 points, gauss_legendre_asymptotic is used.
 HBTK::StaticQuadrature HBTK::gauss_legendre(int n_points)
 {
 	std::vector<double> points, weights;
 	points.resize(n_points);
 	weights.resize(n_points);
-	gauss_legendre<double>(n_points, points, weights);
+	if (n_points > 100) {
+		gauss_legendre_asymptotic(n_points, points, weights);
+	}
+	else {
+		gauss_legendre<double>(n_points, points, weights);
+	}
 	return StaticQuadrature(points, weights, -1, 1);
 }
+
+/// \param n_points number of gauss points desired
+/// \param points Gauss points written here. Resized to n_points.
+/// \param weights Weights of points written here. Resized to n_points.
+///
+/// \brief generate gauss legendre quadrature in O(n) time.
+///
+/// Uses the asymptotic expansions of I. Bogaert, "Iteration-free 
+/// computation of Gauss-Legendre quadrature nodes and weights", SIAM
+/// J. Sci. Comput. 36(3), 2014. Each node is computed independently
+/// in constant time, so large quadratures (thousands of points or more)
+/// are cheap and retain full double precision. The expansions need the
+/// zeros of the Bessel function J0 and J1 squared at them. These are
+/// tabulated for the 20 and 21 points nearest each end, where their own
+/// expansions aren't accurate.
+/// For fewer than 101 points, the expansions are not accurate and
+/// gauss_legendre<double> is used instead.
+///
+/// Points are ordered as for gauss_legendre<double>, descending from 1. 
+void HBTK::gauss_legendre_asymptotic(int n_points, std::vector<double>& points, 
+	std::vector<double>& weights)
+{
+	assert(n_points > 0);
+	points.resize(n_points);
+	weights.resize(n_points);
+	if (n_points <= 100) {
+		gauss_legendre<double>(n_points, points, weights);
+		return;
+	}
+	const double pi = HBTK::Constants::pi();
+	const int n = n_points;
+	// The first zeros of J0, and J1 squared at them, where the
+	// expansions below are not accurate enough.
+	static const double j0_zeros[20] = {
+			2.40482555769577276862163187933, 5.52007811028631064959660411281,
+			8.65372791291101221695419871266, 11.7915344390142816137430449119,
+			14.9309177084877859477625939974, 18.0710639679109225431478829756,
+			21.2116366298792589590783933505, 24.3524715307493027370579447632,
+			27.4934791320402547958772882346, 30.6346064684319751175495789269,
+			33.7758202135735686842385463467, 36.9170983536640439797694930633,
+			40.0584257646282392947993073740, 43.1997917131767303575240727287,
+			46.3411883716618140186857888791, 49.4826098973978171736027615332,
+			52.6240518411149960292512853804, 55.7655107550199793116834927735,
+			58.9069839260809421328344066346, 62.0484691902271698828525002646 };
+	static const double j1_squared_at_zeros[21] = {
+			0.269514123941916926183, 0.115780138582203695809, 0.0736863511364082151444,
+			0.0540375731981162820333, 0.0426614290172430912586, 0.0352421034909961013573,
+			0.0300210701030546726625, 0.0261473914953080885855, 0.0231591218246913922594,
+			0.0207838291222678576181, 0.0188504506693176678157, 0.0172461575696650083074,
+			0.0158935181059235978006, 0.014737626096472189594, 0.0137384651453871179104,
+			0.0128661817376151328776, 0.0120980515486267975395, 0.0114164712244916085084,
+			0.0108075927911802040098, 0.0102603729262807628063, 0.00976589713979105053942 };
+
+	// The kth zero of J0. McMahon's expansion is accurate for k > 20.
+	auto bessel_j0_zero = [=](int k)->double {
+		if (k <= 20) { return j0_zeros[k - 1]; }
+		double z = pi * (k - 0.25);
+		double r = 1.0 / z;
+		double r2 = r * r;
+		z = z + r * (0.125 + r2 * (-0.807291666666666666666666666667e-1 + r2 * (0.246175130208333333333333333333
+			+ r2 * (-1.82443876720610119047619047619 + r2 * (25.3364147973439050099206349206 
+			+ r2 * (-567.644412135183381139802038240 + r2 * (18690.4765282320653831636345064 
+			+ r2 * (-8.49353580299148769921876983660e5 + r2 * 5.09225462402226769498681286758e7))))))));
+		return z;
+	};
+	// J1 squared at the kth zero of J0. The expansion is accurate for k > 21.
+	auto bessel_j1_squared = [](int k)->double {
+		if (k <= 21) { return j1_squared_at_zeros[k - 1]; }
+		double x = 1.0 / (k - 0.25);
+		double x2 = x * x;
+		return x * (0.202642367284675542887091596703 + x2 * x2 * (-0.303380429711290253026202643516e-3 
+			+ x2 * (0.198924364245969295201137972743e-3 + x2 * (-0.228969902772111653038747229723e-3 
+			+ x2 * (0.433710719130746277915572905025e-3 + x2 * (-0.123632349727175414724737657367e-2 
+			+ x2 * (0.496101423268883102872271417616e-2 + x2 * (-0.266837393702323757700998557826e-1 
+			+ x2 * .185395398206345628711318848386))))))));
+	};
+
+	for (int k = 1; k <= (n + 1) / 2; k++) {
+		const double w = 1.0 / (n + 0.5);
+		const double nu = bessel_j0_zero(k);
+		double theta = w * nu;
+		const double x = theta * theta;
+		const double b = bessel_j1_squared(k);
+
+		// Chebyshev interpolants for the node...
+		double sf1 = (((((-1.29052996274280508473467968379e-12 * x + 2.40724685864330121825976175184e-10) * x 
+			- 3.13148654635992041468855740012e-8) * x + 0.275573168962061235623801563453e-5) * x 
+			- 0.148809523713909147898955880165e-3) * x + 0.416666666665193394525296923981e-2) * x 
+			- 0.416666666666662959639712457549e-1;
+		double sf2 = (((((+2.20639421781871003734786884322e-9 * x - 7.53036771373769326811030753538e-8) * x 
+			+ 0.161969259453836261731700382098e-5) * x - 0.253300326008232025914059965302e-4) * x 
+			+ 0.282116886057560434805998583817e-3) * x - 0.209022248387852902722635654229e-2) * x 
+			+ 0.815972221772932265640401128517e-2;
+		double sf3 = (((((-2.97058225375526229899781956673e-8 * x + 5.55845330223796209655886325712e-7) * x 
+			- 0.567797841356833081642185432056e-5) * x + 0.418498100329504574443885193835e-4) * x 
+			- 0.251395293283965914823026348764e-3) * x + 0.128654198542845137196151147483e-2) * x 
+			- 0.416012165620204364833694266818e-2;
+		// ... and the weight.
+		double wsf1 = ((((((((-2.20902861044616638398573427475e-14 * x + 2.30365726860377376873232578871e-12) * x 
+			- 1.75257700735423807659851042318e-10) * x + 1.03756066927916795821098009353e-8) * x 
+			- 4.63968647553221331251529631098e-7) * x + 0.149644593625028648361395938176e-4) * x 
+			- 0.326278659594412170300449074873e-3) * x + 0.436507936507598105249726413120e-2) * x 
+			- 0.305555555555553028279487898503e-1) * x + 0.833333333333333302184063103900e-1;
+		double wsf2 = (((((((+3.63117412152654783455929483029e-12 * x + 7.67643545069893130779501844323e-11) * x 
+			- 7.12912857233642220650643150625e-9) * x + 2.11483880685947151466370130277e-7) * x 
+			- 0.381817918680045468483009307090e-5) * x + 0.465969530694968391417927388162e-4) * x 
+			- 0.407297185611335764191683161117e-3) * x + 0.268959435694729660779984493795e-2) * x 
+			- 0.111111111111214923138249347172e-1;
+		double wsf3 = (((((((+2.01826791256703301806643264922e-9 * x - 4.38647122520206649251063212545e-8) * x 
+			+ 5.08898347288671653137451093208e-7) * x - 0.397933316519135275712977531366e-5) * x 
+			+ 0.200559326396458326778521795392e-4) * x - 0.422888059282921161626339411388e-4) * x 
+			- 0.105646050254076140548678457002e-3) * x - 0.947969308958577323145923317955e-4) * x 
+			+ 0.656966489926484797412985260842e-2;
+
+		const double nu_o_sin = nu / sin(theta);
+		const double b_nu_o_sin = b * nu_o_sin;
+		const double w_inv_sinc = w * w * nu_o_sin;
+		const double wis2 = w_inv_sinc * w_inv_sinc;
+		theta = w * (nu + theta * w_inv_sinc * (sf1 + wis2 * (sf2 + wis2 * sf3)));
+		double denominator = b_nu_o_sin + b_nu_o_sin * wis2 * (wsf1 + wis2 * (wsf2 + wis2 * wsf3));
+		const double z = cos(theta);
+		const double weight = (2.0 * w) / denominator;
+		points[k - 1] = z;
+		points[n - k] = -z;
+		weights[k - 1] = weight;
+		weights[n - k] = weight;
+	}
+	// Odd n has a point at exactly 0.
+	if (n % 2 == 1) { points[n / 2] = 0.0; }
+	return;
+}
@@ -0,0 +1,541 @@
+#include "GmshMeshArrays.h"
+/*////////////////////////////////////////////////////////////////////////////
+GmshMeshArrays.cpp
+
+Fast reading of a whole Gmsh .msh (version 2) file into flat arrays.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include "GmshInfo.h"
+#include "MemoryMappedFile.h"
+
+namespace {
+	// Powers of ten that are exact as doubles.
+	const double exact_powers_of_ten[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	inline bool is_space(char c)
+	{
+		return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+	}
+
+	inline bool is_digit(char c)
+	{
+		return c >= '0' && c <= '9';
+	}
+
+	// Numbers are parsed in the style of C++17's std::from_chars: no locale,
+	// no allocation, no null terminator needed, and the end of the number is
+	// returned. A return value of first means there was no valid number.
+	const char * parse_int(const char * first, const char * last, int & value)
+	{
+		const char * p = first;
+		const bool negative = p != last && *p == '-';
+		if (p != last && (*p == '-' || *p == '+')) { p++; }
+		const char * digits = p;
+		long long result = 0;
+		for (; p != last && is_digit(*p) && p - digits < 11; p++) {
+			result = result * 10 + (*p - '0');
+		}
+		if (p == digits || (p != last && is_digit(*p))) { return first; }
+		if (result > (long long)INT_MAX + (negative ? 1 : 0)) { return first; }
+		value = (int)(negative ? -result : result);
+		return p;
+	}
+
+	// Decimal numbers of up to 16 significant digits and small exponents, 
+	// which covers what Gmsh writes, are converted with a single correctly 
+	// rounded multiplication or division (Clinger's fast path), so the 
+	// result is exact. Anything else falls back to strtod.
+	const char * parse_double(const char * first, const char * last, double & value)
+	{
+		const char * p = first;
+		const bool negative = p != last && *p == '-';
+		if (p != last && (*p == '-' || *p == '+')) { p++; }
+		uint64_t mantissa = 0;
+		int significant_digits = 0, exponent = 0;
+		bool any_digits = false, fast = true;
+		for (; p != last && is_digit(*p); p++) {
+			any_digits = true;
+			if (significant_digits < 19) {
+				mantissa = mantissa * 10 + (*p - '0');
+				significant_digits += mantissa != 0 ? 1 : 0;
+			}
+			else {
+				fast = false;
+			}
+		}
+		if (p != last && *p == '.') {
+			for (p++; p != last && is_digit(*p); p++) {
+				any_digits = true;
+				if (significant_digits < 19) {
+					mantissa = mantissa * 10 + (*p - '0');
+					significant_digits += mantissa != 0 ? 1 : 0;
+					exponent--;
+				}
+				else {
+					fast = false;
+				}
+			}
+		}
+		if (!any_digits) { return first; }
+		if (p != last && (*p == 'e' || *p == 'E')) {
+			int exponent_value;
+			const char * exponent_end = parse_int(p + 1, last, exponent_value);
+			if (exponent_end == p + 1) { return first; }
+			p = exponent_end;
+			if (exponent_value > 10000 || exponent_value < -10000) {
+				fast = false;
+			}
+			else {
+				exponent += exponent_value;
+			}
+		}
+
+		if (fast && mantissa == 0) {
+			value = 0;
+		}
+		else if (fast && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+			const double m = (double)mantissa;
+			value = exponent < 0 ? m / exact_powers_of_ten[-exponent] : m * exact_powers_of_ten[exponent];
+		}
+		else {
+			// strtod needs a null terminated copy. The sign is applied below.
+			std::string number(first, p);
+			value = std::abs(strtod(number.c_str(), nullptr));
+		}
+		value = negative ? -value : value;
+		return p;
+	}
+
+	template<typename Ty>
+	inline void reverse_bytes(Ty & value)
+	{
+		char bytes[sizeof(Ty)];
+		memcpy(bytes, &value, sizeof(Ty));
+		std::reverse(bytes, bytes + sizeof(Ty));
+		memcpy(&value, bytes, sizeof(Ty));
+	}
+
+	// Reads a .msh file section by section, collecting nodes and elements
+	// into blocks. Binary data is copied straight from the input with 
+	// memcpy, which is safe for the unaligned records of the format.
+	class MshScanner {
+	public:
+		MshScanner(const char * begin, const char * end, 
+			const HBTK::Gmsh::MeshBlockFunctions & functions, int block_size)
+			: m_begin(begin), m_pos(begin), m_end(end), m_functions(functions),
+			m_block_size(block_size), m_binary(false), m_swap_bytes(false),
+			m_section_offset(0), m_section_size(0)
+		{
+			m_block.node_tags.reserve(block_size);
+			m_block.node_x.reserve(block_size);
+			m_block.node_y.reserve(block_size);
+			m_block.node_z.reserve(block_size);
+			m_block.element_tags.reserve(block_size);
+			m_block.element_types.reserve(block_size);
+			m_block.element_node_offsets.reserve(block_size + 1);
+			m_block.element_group_offsets.reserve(block_size + 1);
+			m_block.element_node_offsets.push_back(0);
+			m_block.element_group_offsets.push_back(0);
+		}
+
+		void scan()
+		{
+			skip_space();
+			while (m_pos != m_end) {
+				const std::string section = read_word();
+				if (section == "$MeshFormat") { mesh_format(); }
+				else if (section == "$PhysicalNames") { physical_names(); }
+				else if (section == "$Nodes") { nodes(); }
+				else if (section == "$Elements") { elements(); }
+				else if (section[0] == '$') { skip_section(section.substr(1)); }
+				else { fail("expected a section header but found \"" + section + "\""); }
+				skip_space();
+			}
+		}
+
+	private:
+		const char * m_begin, * m_pos, * m_end;
+		const HBTK::Gmsh::MeshBlockFunctions & m_functions;
+		const int m_block_size;
+		bool m_binary, m_swap_bytes;
+		// Position of the block being filled within its section.
+		int m_section_offset, m_section_size;
+		// The block being filled.
+		HBTK::Gmsh::GmshMeshArrays m_block;
+
+		void flush_nodes()
+		{
+			auto & block = m_block;
+			if (block.node_tags.empty()) { return; }
+			if (m_functions.nodes) {
+				m_functions.nodes(HBTK::Gmsh::NodeBlock{ block.number_of_nodes(),
+					m_section_offset, m_section_size, block.node_tags.data(),
+					block.node_x.data(), block.node_y.data(), block.node_z.data() });
+			}
+			m_section_offset += block.number_of_nodes();
+			block.node_tags.clear();
+			block.node_x.clear();
+			block.node_y.clear();
+			block.node_z.clear();
+		}
+
+		void flush_elements()
+		{
+			auto & block = m_block;
+			if (block.element_tags.empty()) { return; }
+			if (m_functions.elements) {
+				m_functions.elements(HBTK::Gmsh::ElementBlock{ block.number_of_elements(),
+					m_section_offset, m_section_size,
+					block.element_tags.data(), block.element_types.data(),
+					block.element_node_offsets.data(), block.element_node_tags.data(),
+					block.element_group_offsets.data(), block.element_group_tags.data() });
+			}
+			m_section_offset += block.number_of_elements();
+			block.element_tags.clear();
+			block.element_types.clear();
+			block.element_node_offsets.resize(1);
+			block.element_node_tags.clear();
+			block.element_group_offsets.resize(1);
+			block.element_group_tags.clear();
+		}
+
+		void fail(const std::string & message) const
+		{
+			throw std::runtime_error("HBTK::Gmsh::parse_mesh_arrays: " + message 
+				+ " (byte " + std::to_string(m_pos - m_begin) + "). " 
+				__FILE__ ":" + std::to_string(__LINE__));
+		}
+
+		void skip_space()
+		{
+			while (m_pos != m_end && is_space(*m_pos)) { m_pos++; }
+		}
+
+		// Binary data starts straight after the newline ending the line
+		// before, and may itself start with bytes that look like spaces.
+		void skip_line_end()
+		{
+			while (m_pos != m_end && *m_pos != '\n') {
+				if (!is_space(*m_pos)) { fail("unexpected text before binary data"); }
+				m_pos++;
+			}
+			if (m_pos == m_end) { fail("unexpected end of file"); }
+			m_pos++;
+		}
+
+		std::string read_word()
+		{
+			skip_space();
+			const char * start = m_pos;
+			while (m_pos != m_end && !is_space(*m_pos)) { m_pos++; }
+			return std::string(start, m_pos);
+		}
+
+		int read_int()
+		{
+			skip_space();
+			int value;
+			const char * next = parse_int(m_pos, m_end, value);
+			if (next == m_pos) { fail("expected an integer"); }
+			m_pos = next;
+			return value;
+		}
+
+		double read_double()
+		{
+			skip_space();
+			double value;
+			const char * next = parse_double(m_pos, m_end, value);
+			if (next == m_pos) { fail("expected a number"); }
+			m_pos = next;
+			return value;
+		}
+
+		void require_bytes(size_t count)
+		{
+			if ((size_t)(m_end - m_pos) < count) { fail("unexpected end of binary data"); }
+		}
+
+		template<typename Ty>
+		Ty read_binary()
+		{
+			Ty value;
+			memcpy(&value, m_pos, sizeof(Ty));
+			m_pos += sizeof(Ty);
+			if (m_swap_bytes) { reverse_bytes(value); }
+			return value;
+		}
+
+		void read_binary_ints(int * destination, int count)
+		{
+			memcpy(destination, m_pos, sizeof(int) * count);
+			m_pos += sizeof(int) * count;
+			if (m_swap_bytes) {
+				for (int i = 0; i < count; i++) { reverse_bytes(destination[i]); }
+			}
+		}
+
+		void expect_end(const std::string & section)
+		{
+			if (read_word() != "$End" + section) { fail("expected $End" + section); }
+		}
+
+		void skip_section(const std::string & section)
+		{
+			const std::string end_marker = "$End" + section;
+			const char * found = std::search(m_pos, m_end, end_marker.begin(), end_marker.end());
+			if (found == m_end) { fail("no " + end_marker); }
+			m_pos = found + end_marker.size();
+		}
+
+		void mesh_format()
+		{
+			const double version = read_double();
+			if (version < 2 || version >= 3) {
+				fail("only version 2 .msh files are supported, not " + std::to_string(version));
+			}
+			m_binary = read_int() == 1;
+			const int data_size = read_int();
+			if (m_binary) {
+				if (data_size != (int)sizeof(double)) { fail("unsupported data size"); }
+				skip_line_end();
+				require_bytes(sizeof(int));
+				const int one = read_binary<int>();
+				if (one != 1) {
+					int swapped = one;
+					reverse_bytes(swapped);
+					if (swapped != 1) { fail("bad endianness check integer"); }
+					m_swap_bytes = true;
+				}
+			}
+			expect_end("MeshFormat");
+		}
+
+		void physical_names()
+		{
+			const int count = read_int();
+			for (int i = 0; i < count; i++) {
+				const int dimensions = read_int();
+				const int tag = read_int();
+				skip_space();
+				if (m_pos == m_end || *m_pos != '"') { fail("expected a quoted physical name"); }
+				const char * name_end = std::find(m_pos + 1, m_end, '"');
+				if (name_end == m_end) { fail("unterminated physical name"); }
+				if (m_functions.physical_name) {
+					m_functions.physical_name(tag, dimensions, std::string(m_pos + 1, name_end));
+				}
+				m_pos = name_end + 1;
+			}
+			expect_end("PhysicalNames");
+		}
+
+		void nodes()
+		{
+			const int count = read_int();
+			if (count < 0) { fail("negative node count"); }
+			m_section_offset = 0;
+			m_section_size = count;
+			auto & block = m_block;
+			if (m_binary) {
+				skip_line_end();
+				require_bytes((size_t)count * (sizeof(int) + 3 * sizeof(double)));
+			}
+			for (int i = 0; i < count; i++) {
+				if (m_binary) {
+					block.node_tags.push_back(read_binary<int>());
+					block.node_x.push_back(read_binary<double>());
+					block.node_y.push_back(read_binary<double>());
+					block.node_z.push_back(read_binary<double>());
+				}
+				else {
+					block.node_tags.push_back(read_int());
+					block.node_x.push_back(read_double());
+					block.node_y.push_back(read_double());
+					block.node_z.push_back(read_double());
+				}
+				if (block.number_of_nodes() == m_block_size) { flush_nodes(); }
+			}
+			flush_nodes();
+			expect_end("Nodes");
+		}
+
+		void elements()
+		{
+			const int count = read_int();
+			if (count < 0) { fail("negative element count"); }
+			m_section_offset = 0;
+			m_section_size = count;
+			auto & block = m_block;
+			if (m_binary) {
+				skip_line_end();
+				// Runs of elements of the same type and number of tags.
+				int read = 0;
+				while (read < count) {
+					require_bytes(3 * sizeof(int));
+					const int type = read_binary<int>();
+					const int run_count = read_binary<int>();
+					const int n_tags = read_binary<int>();
+					const int n_nodes = HBTK::Gmsh::element_node_count(type);
+					if (n_nodes < 0) { fail("unknown element type " + std::to_string(type)); }
+					if (run_count < 1 || run_count > count - read || n_tags < 0) { 
+						fail("bad element block header"); 
+					}
+					require_bytes((size_t)run_count * (1 + n_tags + n_nodes) * sizeof(int));
+					for (int i = 0; i < run_count; i++) {
+						block.element_tags.push_back(read_binary<int>());
+						block.element_types.push_back(type);
+						const size_t group_end = block.element_group_tags.size();
+						const size_t node_end = block.element_node_tags.size();
+						block.element_group_tags.resize(group_end + n_tags);
+						block.element_node_tags.resize(node_end + n_nodes);
+						read_binary_ints(block.element_group_tags.data() + group_end, n_tags);
+						read_binary_ints(block.element_node_tags.data() + node_end, n_nodes);
+						block.element_group_offsets.push_back((int)(group_end + n_tags));
+						block.element_node_offsets.push_back((int)(node_end + n_nodes));
+						if (block.number_of_elements() == m_block_size) { flush_elements(); }
+					}
+					read += run_count;
+				}
+			}
+			else {
+				for (int i = 0; i < count; i++) {
+					block.element_tags.push_back(read_int());
+					const int type = read_int();
+					block.element_types.push_back(type);
+					const int n_tags = read_int();
+					const int n_nodes = HBTK::Gmsh::element_node_count(type);
+					if (n_nodes < 0) { fail("unknown element type " + std::to_string(type)); }
+					for (int j = 0; j < n_tags; j++) { block.element_group_tags.push_back(read_int()); }
+					for (int j = 0; j < n_nodes; j++) { block.element_node_tags.push_back(read_int()); }
+					block.element_group_offsets.push_back((int)block.element_group_tags.size());
+					block.element_node_offsets.push_back((int)block.element_node_tags.size());
+					if (block.number_of_elements() == m_block_size) { flush_elements(); }
+				}
+			}
+			flush_elements();
+			expect_end("Elements");
+		}
+	};
+}
+
+int HBTK::Gmsh::GmshMeshArrays::number_of_nodes() const noexcept
+{
+	return (int)node_tags.size();
+}
+
+int HBTK::Gmsh::GmshMeshArrays::number_of_elements() const noexcept
+{
+	return (int)element_tags.size();
+}
+
+/// \param file_path the path of the .msh file.
+///
+/// \brief Read an ASCII or binary version 2 .msh file into flat arrays.
+///
+/// The file is memory mapped rather than read through a stream. ASCII 
+/// numbers are parsed in place, and binary records are copied straight 
+/// into the arrays.
+HBTK::Gmsh::GmshMeshArrays HBTK::Gmsh::read_mesh_arrays(const std::string & file_path)
+{
+	MemoryMappedFile file(file_path);
+	return parse_mesh_arrays(file.data(), file.data() + file.size());
+}
+
+/// \param begin the first character of the contents of a .msh file.
+/// \param end one past the last character.
+///
+/// \brief Parse the contents of a version 2 .msh file into flat arrays.
+HBTK::Gmsh::GmshMeshArrays HBTK::Gmsh::parse_mesh_arrays(const char * begin, const char * end)
+{
+	GmshMeshArrays mesh;
+	mesh.element_node_offsets.push_back(0);
+	mesh.element_group_offsets.push_back(0);
+	MeshBlockFunctions functions;
+	functions.physical_name = [&](int tag, int dimensions, const std::string & name) {
+		mesh.group_tags.push_back(tag);
+		mesh.group_dimensions.push_back(dimensions);
+		mesh.group_names.push_back(name);
+	};
+	functions.nodes = [&](const NodeBlock & block) {
+		if (block.section_offset == 0) {
+			mesh.node_tags.reserve(mesh.node_tags.size() + block.section_size);
+			mesh.node_x.reserve(mesh.node_x.size() + block.section_size);
+			mesh.node_y.reserve(mesh.node_y.size() + block.section_size);
+			mesh.node_z.reserve(mesh.node_z.size() + block.section_size);
+		}
+		mesh.node_tags.insert(mesh.node_tags.end(), block.tags, block.tags + block.size);
+		mesh.node_x.insert(mesh.node_x.end(), block.x, block.x + block.size);
+		mesh.node_y.insert(mesh.node_y.end(), block.y, block.y + block.size);
+		mesh.node_z.insert(mesh.node_z.end(), block.z, block.z + block.size);
+	};
+	functions.elements = [&](const ElementBlock & block) {
+		const int node_base = (int)mesh.element_node_tags.size();
+		const int group_base = (int)mesh.element_group_tags.size();
+		if (block.section_offset == 0) {
+			mesh.element_tags.reserve(mesh.element_tags.size() + block.section_size);
+			mesh.element_types.reserve(mesh.element_types.size() + block.section_size);
+			mesh.element_node_offsets.reserve(mesh.element_node_offsets.size() + block.section_size);
+			mesh.element_group_offsets.reserve(mesh.element_group_offsets.size() + block.section_size);
+		}
+		mesh.element_tags.insert(mesh.element_tags.end(), block.tags, block.tags + block.size);
+		mesh.element_types.insert(mesh.element_types.end(), block.types, block.types + block.size);
+		for (int i = 1; i <= block.size; i++) {
+			mesh.element_node_offsets.push_back(node_base + block.node_offsets[i]);
+			mesh.element_group_offsets.push_back(group_base + block.group_offsets[i]);
+		}
+		mesh.element_node_tags.insert(mesh.element_node_tags.end(), 
+			block.node_tags, block.node_tags + block.node_offsets[block.size]);
+		mesh.element_group_tags.insert(mesh.element_group_tags.end(),
+			block.group_tags, block.group_tags + block.group_offsets[block.size]);
+	};
+	scan_mesh_blocks(begin, end, functions);
+	return mesh;
+}
+
+/// \param begin the first character of the contents of a .msh file.
+/// \param end one past the last character.
+/// \param functions the functions to pass the file's contents to.
+/// \param block_size the maximum number of nodes or elements in a block.
+///
+/// \brief Parse the contents of a version 2 .msh file, passing the nodes 
+/// and elements on in blocks.
+///
+/// Blocks are passed on in file order. A block never spans two sections.
+void HBTK::Gmsh::scan_mesh_blocks(const char * begin, const char * end, 
+	const MeshBlockFunctions & functions, int block_size)
+{
+	assert(begin <= end);
+	assert(block_size > 0);
+	MshScanner scanner(begin, end, functions, block_size);
+	scanner.scan();
+}
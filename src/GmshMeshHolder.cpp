@@ -153,13 +153,29 @@ bool HBTK::Gmsh::GmshMeshHolder::element_tag_exists(int element_tag)
 /// \brief Add an element to the container.
 void HBTK::Gmsh::GmshMeshHolder::add_element(int element_tag, int element_id, 
 	std::vector<int> node_tags, std::vector<int> group_tags)
+{
+	add_element(element_tag, element_id, node_tags.data(), (int)node_tags.size(),
+		group_tags.data(), (int)group_tags.size());
+	return;
+}
+
+/// \param element_tag an integer that uniquely identifies an element.
+/// \param element_id an integer that describes the element type / topology.
+/// \param node_tags the node_tags that define the shape of the element.
+/// \param num_node_tags the length of node_tags.
+/// \param group_tags the group_tags of the groups the element is in.
+/// \param num_group_tags the length of group_tags.
+///
+/// \brief Add an element to the container from arrays of tags.
+void HBTK::Gmsh::GmshMeshHolder::add_element(int element_tag, int element_id,
+	const int * node_tags, int num_node_tags, 
+	const int * group_tags, int num_group_tags)
 {
 	assert(!element_tag_exists(element_tag));
-	for(auto group_tag: group_tags) add_element_to_group(group_tag, element_tag);
-	struct element ele;
+	for (int i = 0; i < num_group_tags; i++) add_element_to_group(group_tags[i], element_tag);
+	struct element & ele = m_elements[element_tag];
 	ele.element_id = element_id;
-	ele.node_tags = node_tags;
-	m_elements[element_tag] = ele;
+	ele.node_tags.assign(node_tags, node_tags + num_node_tags);
 	return;
 }
 
@@ -320,14 +336,22 @@ std::vector<int> HBTK::Gmsh::GmshMeshHolder::check_element_nodes_exist()
 HBTK::Gmsh::GmshParser HBTK::Gmsh::GmshMeshHolder::get_parser()
 {
 	GmshParser parser;
-	parser.add_node_function(
-		[&](int tag, double x, double y, double z)->bool {
-		add_node(tag, CartesianPoint3D({ x, y, z }));
-		return true; });
-	parser.add_elem_function(
-		[&](int tag, int id, std::vector<int> phy_grp, std::vector<int> nodes)->bool {
-		add_element(tag, id, nodes, phy_grp);
-		return true; });
+	parser.add_node_block_function(
+		[&](const NodeBlock & block) {
+		if (block.section_offset == 0) { m_nodes.reserve(m_nodes.size() + block.section_size); }
+		for (int i = 0; i < block.size; i++) {
+			add_node(block.tags[i], CartesianPoint3D({ block.x[i], block.y[i], block.z[i] }));
+		} });
+	parser.add_elem_block_function(
+		[&](const ElementBlock & block) {
+		if (block.section_offset == 0) { m_elements.reserve(m_elements.size() + block.section_size); }
+		for (int i = 0; i < block.size; i++) {
+			const int * nodes = block.node_tags + block.node_offsets[i];
+			const int * groups = block.group_tags + block.group_offsets[i];
+			add_element(block.tags[i], block.types[i], 
+				nodes, block.node_offsets[i + 1] - block.node_offsets[i],
+				groups, block.group_offsets[i + 1] - block.group_offsets[i]);
+		} });
 	parser.add_phys_name_function(
 		[&](int group_tag, int group_dimensions, std::string group_name)->bool {
 			add_group(group_tag, group_name, group_dimensions);
@@ -0,0 +1,154 @@
+#include "MemoryMappedFile.h"
+/*////////////////////////////////////////////////////////////////////////////
+MemoryMappedFile.cpp
+
+Read only access to the whole of a file through the virtual memory system.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+HBTK::MemoryMappedFile::MemoryMappedFile()
+	: m_data(nullptr),
+	m_size(0)
+#ifdef _WIN32
+	, m_file_handle(nullptr),
+	m_mapping_handle(nullptr)
+#endif
+{
+}
+
+HBTK::MemoryMappedFile::MemoryMappedFile(const std::string & file_path)
+	: MemoryMappedFile()
+{
+	const std::string error_start = "HBTK::MemoryMappedFile::MemoryMappedFile: ";
+#ifdef _WIN32
+	HANDLE file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		throw std::runtime_error(error_start + "could not open " + file_path + ". "
+			__FILE__ ":" + std::to_string(__LINE__));
+	}
+	m_file_handle = file;
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size)) {
+		release();
+		throw std::runtime_error(error_start + "could not get the size of " + file_path + ". "
+			__FILE__ ":" + std::to_string(__LINE__));
+	}
+	m_size = (size_t)file_size.QuadPart;
+	if (m_size == 0) { return; }
+	m_mapping_handle = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (m_mapping_handle != nullptr) {
+		m_data = static_cast<const char *>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+	}
+#else
+	const int file = open(file_path.c_str(), O_RDONLY);
+	if (file < 0) {
+		throw std::runtime_error(error_start + "could not open " + file_path + ". "
+			__FILE__ ":" + std::to_string(__LINE__));
+	}
+	struct stat file_status;
+	if (fstat(file, &file_status) != 0) {
+		close(file);
+		throw std::runtime_error(error_start + "could not get the size of " + file_path + ". "
+			__FILE__ ":" + std::to_string(__LINE__));
+	}
+	m_size = (size_t)file_status.st_size;
+	if (m_size == 0) {
+		close(file);
+		return;
+	}
+	void * mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+	// The mapping keeps the file open.
+	close(file);
+	if (mapping != MAP_FAILED) {
+		m_data = static_cast<const char *>(mapping);
+		madvise(mapping, m_size, MADV_SEQUENTIAL);
+	}
+#endif
+	if (m_data == nullptr) {
+		release();
+		throw std::runtime_error(error_start + "could not map " + file_path + ". "
+			__FILE__ ":" + std::to_string(__LINE__));
+	}
+}
+
+HBTK::MemoryMappedFile::~MemoryMappedFile()
+{
+	release();
+}
+
+HBTK::MemoryMappedFile::MemoryMappedFile(MemoryMappedFile && other) noexcept
+	: MemoryMappedFile()
+{
+	*this = std::move(other);
+}
+
+HBTK::MemoryMappedFile & HBTK::MemoryMappedFile::operator=(MemoryMappedFile && other) noexcept
+{
+	if (this != &other) {
+		release();
+		std::swap(m_data, other.m_data);
+		std::swap(m_size, other.m_size);
+#ifdef _WIN32
+		std::swap(m_file_handle, other.m_file_handle);
+		std::swap(m_mapping_handle, other.m_mapping_handle);
+#endif
+	}
+	return *this;
+}
+
+const char * HBTK::MemoryMappedFile::data() const noexcept
+{
+	return m_data;
+}
+
+size_t HBTK::MemoryMappedFile::size() const noexcept
+{
+	return m_size;
+}
+
+void HBTK::MemoryMappedFile::release() noexcept
+{
+#ifdef _WIN32
+	if (m_data != nullptr) { UnmapViewOfFile(m_data); }
+	if (m_mapping_handle != nullptr) { CloseHandle(m_mapping_handle); }
+	if (m_file_handle != nullptr) { CloseHandle(m_file_handle); }
+	m_mapping_handle = nullptr;
+	m_file_handle = nullptr;
+#else
+	if (m_data != nullptr) { munmap(const_cast<char *>(m_data), m_size); }
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
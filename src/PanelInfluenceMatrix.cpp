@@ -0,0 +1,340 @@
+#include "PanelInfluenceMatrix.h"
+/*////////////////////////////////////////////////////////////////////////////
+PanelInfluenceMatrix.cpp
+
+Assemble the influence matrices of many 2D vortex panels at once.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "Constants.h"
+#include "ParallelFor.h"
+
+namespace {
+	// Panels per chunk of a matrix row. The intermediate arrays for a chunk
+	// fit in L1 cache.
+	const int panel_chunk_size = 256;
+	// Rows per parallel task.
+	const int rows_per_task = 8;
+
+	// The velocity induced at one point by a chunk of panels, per unit 
+	// strength. Constant panels give one column per panel, linear panels 
+	// two: per unit strength at the panel's start and at its end.
+	//
+	// Each panel has its own frame with the panel from (0, 0) to (L, 0). 
+	// For a point (xt, yt) in this frame, with r0 and r1 its distances from 
+	// the panel's ends (Katz & Plotkin 2001, sec. 10.2 and 10.3):
+	//   dtheta = atan2(L yt, xt (xt - L) + yt^2), the angle the panel subtends,
+	//   lg = log(r1^2 / r0^2),
+	//   constant strength: ut = dtheta / 2 pi,  vt = lg / 4 pi,
+	//   unit gradient:     ut = (2 xt dtheta + yt lg) / 4 pi,
+	//                      vt = (xt lg / 2 + L - yt dtheta) / 2 pi.
+	// The loops either side of the atan2 and log calls are branch free, so 
+	// that the compiler can vectorise them.
+	template<bool Linear>
+	void panel_chunk_vel(const HBTK::PanelGeometry2D & panels, int begin, int n,
+		double x, double y, double * u, double * v)
+	{
+		const double * x0 = panels.x0().data() + begin;
+		const double * y0 = panels.y0().data() + begin;
+		const double * length = panels.length().data() + begin;
+		const double * c = panels.cos_angle().data() + begin;
+		const double * s = panels.sin_angle().data() + begin;
+		double xt[panel_chunk_size], yt[panel_chunk_size];
+		double angle_y[panel_chunk_size], angle_x[panel_chunk_size], ratio[panel_chunk_size];
+		for (int j = 0; j < n; j++) {
+			const double dx = x - x0[j], dy = y - y0[j];
+			const double xl = dx * c[j] + dy * s[j];
+			const double yl_raw = dy * c[j] - dx * s[j];
+			// Points on the panel's line are moved to its positive side, so 
+			// that the self influence of a panel at its midpoint is well 
+			// defined.
+			const double tol = 1e-12 * length[j];
+			const double yl = yl_raw * yl_raw > tol * tol ? yl_raw : 0.;
+			const double r0_sq = xl * xl + yl * yl;
+			const double r1_sq = (xl - length[j]) * (xl - length[j]) + yl * yl;
+			xt[j] = xl;
+			yt[j] = yl;
+			angle_y[j] = length[j] * yl;
+			angle_x[j] = xl * (xl - length[j]) + yl * yl;
+			ratio[j] = r1_sq / r0_sq;
+		}
+		for (int j = 0; j < n; j++) {
+			angle_y[j] = atan2(angle_y[j], angle_x[j]);
+			ratio[j] = log(ratio[j]);
+		}
+		const double * dtheta = angle_y;
+		const double * lg = ratio;
+		const double inv_2pi = 1 / (2 * HBTK::Constants::pi());
+		for (int j = 0; j < n; j++) {
+			const double ut = inv_2pi * dtheta[j];
+			const double vt = 0.5 * inv_2pi * lg[j];
+			if (!Linear) {
+				u[j] = ut * c[j] - vt * s[j];
+				v[j] = ut * s[j] + vt * c[j];
+			}
+			else {
+				const double inv_length = 1 / length[j];
+				const double ug = 0.5 * inv_2pi * (2 * xt[j] * dtheta[j] + yt[j] * lg[j]) * inv_length;
+				const double vg = inv_2pi * (0.5 * xt[j] * lg[j] + length[j] - yt[j] * dtheta[j]) * inv_length;
+				u[2 * j] = (ut - ug) * c[j] - (vt - vg) * s[j];
+				v[2 * j] = (ut - ug) * s[j] + (vt - vg) * c[j];
+				u[2 * j + 1] = ug * c[j] - vg * s[j];
+				v[2 * j + 1] = ug * s[j] + vg * c[j];
+			}
+		}
+	}
+
+	// Fill rows of the u and v influence matrices, or of a directional 
+	// influence matrix if v_matrix is null.
+	template<bool Linear>
+	void assemble(const HBTK::PanelGeometry2D & panels,
+		const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+		const std::vector<double> * x_dir, const std::vector<double> * y_dir,
+		HBTK::DenseMatrix & u_matrix, HBTK::DenseMatrix * v_matrix, int num_threads)
+	{
+		assert(x_mes.size() == y_mes.size());
+		assert(num_threads > 0);
+		const int n_rows = (int)x_mes.size();
+		const int n_panels = panels.size();
+		const int columns_per_panel = Linear ? 2 : 1;
+		auto task = [&](int task_index) {
+			double u[2 * panel_chunk_size], v[2 * panel_chunk_size];
+			const int row_end = std::min(n_rows, (task_index + 1) * rows_per_task);
+			for (int i = task_index * rows_per_task; i < row_end; i++) {
+				double * u_row = u_matrix.row(i);
+				double * v_row = v_matrix ? v_matrix->row(i) : nullptr;
+				for (int begin = 0; begin < n_panels; begin += panel_chunk_size) {
+					const int n = std::min(panel_chunk_size, n_panels - begin);
+					const int n_cols = n * columns_per_panel;
+					double * u_out = u_row + begin * columns_per_panel;
+					panel_chunk_vel<Linear>(panels, begin, n, x_mes[i], y_mes[i], u, v);
+					if (v_row) {
+						std::copy(u, u + n_cols, u_out);
+						std::copy(v, v + n_cols, v_row + begin * columns_per_panel);
+					}
+					else {
+						const double dx = (*x_dir)[i], dy = (*y_dir)[i];
+						for (int j = 0; j < n_cols; j++) { u_out[j] = u[j] * dx + v[j] * dy; }
+					}
+				}
+			}
+		};
+		const int n_tasks = (n_rows + rows_per_task - 1) / rows_per_task;
+		HBTK::parallel_for(n_tasks, num_threads, task);
+	}
+}
+
+HBTK::PanelGeometry2D::PanelGeometry2D()
+{
+}
+
+HBTK::PanelGeometry2D::PanelGeometry2D(const std::vector<double> & x0, const std::vector<double> & y0,
+	const std::vector<double> & x1, const std::vector<double> & y1)
+	: m_x0(x0),
+	m_y0(y0),
+	m_x1(x1),
+	m_y1(y1),
+	m_length(x0.size()),
+	m_cos(x0.size()),
+	m_sin(x0.size())
+{
+	assert(x0.size() == y0.size());
+	assert(x0.size() == x1.size());
+	assert(x0.size() == y1.size());
+	for (size_t i = 0; i < x0.size(); i++) {
+		m_length[i] = hypot(x1[i] - x0[i], y1[i] - y0[i]);
+		assert(m_length[i] > 0);
+		m_cos[i] = (x1[i] - x0[i]) / m_length[i];
+		m_sin[i] = (y1[i] - y0[i]) / m_length[i];
+	}
+}
+
+HBTK::PanelGeometry2D HBTK::PanelGeometry2D::from_polyline(const std::vector<double> & x_nodes,
+	const std::vector<double> & y_nodes)
+{
+	assert(x_nodes.size() == y_nodes.size());
+	assert(x_nodes.size() > 1);
+	return PanelGeometry2D(std::vector<double>(x_nodes.begin(), x_nodes.end() - 1),
+		std::vector<double>(y_nodes.begin(), y_nodes.end() - 1),
+		std::vector<double>(x_nodes.begin() + 1, x_nodes.end()),
+		std::vector<double>(y_nodes.begin() + 1, y_nodes.end()));
+}
+
+int HBTK::PanelGeometry2D::size() const
+{
+	return (int)m_x0.size();
+}
+
+const std::vector<double> & HBTK::PanelGeometry2D::x0() const
+{
+	return m_x0;
+}
+
+const std::vector<double> & HBTK::PanelGeometry2D::y0() const
+{
+	return m_y0;
+}
+
+const std::vector<double> & HBTK::PanelGeometry2D::x1() const
+{
+	return m_x1;
+}
+
+const std::vector<double> & HBTK::PanelGeometry2D::y1() const
+{
+	return m_y1;
+}
+
+const std::vector<double> & HBTK::PanelGeometry2D::length() const
+{
+	return m_length;
+}
+
+const std::vector<double> & HBTK::PanelGeometry2D::cos_angle() const
+{
+	return m_cos;
+}
+
+const std::vector<double> & HBTK::PanelGeometry2D::sin_angle() const
+{
+	return m_sin;
+}
+
+std::vector<double> HBTK::PanelGeometry2D::x_midpoint() const
+{
+	std::vector<double> result(size());
+	for (int i = 0; i < size(); i++) { result[i] = 0.5 * (m_x0[i] + m_x1[i]); }
+	return result;
+}
+
+std::vector<double> HBTK::PanelGeometry2D::y_midpoint() const
+{
+	std::vector<double> result(size());
+	for (int i = 0; i < size(); i++) { result[i] = 0.5 * (m_y0[i] + m_y1[i]); }
+	return result;
+}
+
+std::vector<double> HBTK::PanelGeometry2D::x_normal() const
+{
+	std::vector<double> result(size());
+	for (int i = 0; i < size(); i++) { result[i] = -m_sin[i]; }
+	return result;
+}
+
+std::vector<double> HBTK::PanelGeometry2D::y_normal() const
+{
+	return m_cos;
+}
+
+/// \param panels the panels.
+/// \param x_mes x coordinates of the measurement points.
+/// \param y_mes y coordinates of the measurement points.
+/// \param u_influence set to the u velocity influence matrix.
+/// \param v_influence set to the v velocity influence matrix.
+/// \param num_threads the maximum number of threads to use.
+///
+/// \brief Velocity influence matrices of constant strength vortex panels.
+///
+/// Element (i, j) is the velocity at point i due to panel j with unit 
+/// strength. A point on a panel gets the velocity on the panel's normal 
+/// side. Points at the ends of a panel are singular.
+void HBTK::ConstantVortexDistribution::influence_matrices(const PanelGeometry2D & panels,
+	const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+	DenseMatrix & u_influence, DenseMatrix & v_influence, int num_threads)
+{
+	u_influence.resize((int)x_mes.size(), panels.size());
+	v_influence.resize((int)x_mes.size(), panels.size());
+	assemble<false>(panels, x_mes, y_mes, nullptr, nullptr, u_influence, &v_influence, num_threads);
+}
+
+/// \param panels the panels.
+/// \param x_mes x coordinates of the measurement points.
+/// \param y_mes y coordinates of the measurement points.
+/// \param x_dir x component of the direction of interest at each point.
+/// \param y_dir y component of the direction of interest at each point.
+/// \param num_threads the maximum number of threads to use.
+///
+/// \brief Influence matrix for the velocity in a given direction, such as
+/// the normal velocity at collocation points.
+///
+/// Element (i, j) is the velocity at point i in direction i due to panel j 
+/// with unit strength.
+HBTK::DenseMatrix HBTK::ConstantVortexDistribution::directional_influence_matrix(
+	const PanelGeometry2D & panels,
+	const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+	const std::vector<double> & x_dir, const std::vector<double> & y_dir, int num_threads)
+{
+	assert(x_dir.size() == x_mes.size());
+	assert(y_dir.size() == x_mes.size());
+	DenseMatrix result((int)x_mes.size(), panels.size());
+	assemble<false>(panels, x_mes, y_mes, &x_dir, &y_dir, result, nullptr, num_threads);
+	return result;
+}
+
+/// \param panels the panels.
+/// \param x_mes x coordinates of the measurement points.
+/// \param y_mes y coordinates of the measurement points.
+/// \param u_influence set to the u velocity influence matrix.
+/// \param v_influence set to the v velocity influence matrix.
+/// \param num_threads the maximum number of threads to use.
+///
+/// \brief Velocity influence matrices of linearly varying strength vortex 
+/// panels.
+///
+/// Element (i, 2j) is the velocity at point i due to panel j with unit 
+/// strength at its start falling linearly to zero at its end. Element 
+/// (i, 2j+1) is for zero strength at the start rising to one at the end.
+void HBTK::LinearVortexDistribution::influence_matrices(const PanelGeometry2D & panels,
+	const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+	DenseMatrix & u_influence, DenseMatrix & v_influence, int num_threads)
+{
+	u_influence.resize((int)x_mes.size(), 2 * panels.size());
+	v_influence.resize((int)x_mes.size(), 2 * panels.size());
+	assemble<true>(panels, x_mes, y_mes, nullptr, nullptr, u_influence, &v_influence, num_threads);
+}
+
+/// \param panels the panels.
+/// \param x_mes x coordinates of the measurement points.
+/// \param y_mes y coordinates of the measurement points.
+/// \param x_dir x component of the direction of interest at each point.
+/// \param y_dir y component of the direction of interest at each point.
+/// \param num_threads the maximum number of threads to use.
+///
+/// \brief Influence matrix for the velocity in a given direction due to 
+/// linearly varying strength vortex panels.
+///
+/// Columns are ordered as in influence_matrices.
+HBTK::DenseMatrix HBTK::LinearVortexDistribution::directional_influence_matrix(
+	const PanelGeometry2D & panels,
+	const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+	const std::vector<double> & x_dir, const std::vector<double> & y_dir, int num_threads)
+{
+	assert(x_dir.size() == x_mes.size());
+	assert(y_dir.size() == x_mes.size());
+	DenseMatrix result((int)x_mes.size(), 2 * panels.size());
+	assemble<true>(panels, x_mes, y_mes, &x_dir, &y_dir, result, nullptr, num_threads);
+	return result;
+}
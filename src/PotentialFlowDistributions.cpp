@@ -25,10 +25,554 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <cmath>
+#include <complex>
 
 #include "CartesianVector.h"
 #include "Constants.h"
+#include "ParallelFor.h"
+
+namespace {
+	// Points per task in BiotSavart::induced_vel. The inputs and outputs 
+	// for a tile fit in L1 cache.
+	const int biot_savart_tile_size = 256;
+
+	// Add the velocity induced by one filament at n points. The points and
+	// velocities must not overlap. __restrict (supported by GCC, Clang and 
+	// MSVC) tells the compiler so, and the loop vectorises.
+	void add_filament_vel(const double * __restrict px, const double * __restrict py, 
+		const double * __restrict pz, double * __restrict u, double * __restrict v, 
+		double * __restrict w, int n,
+		double ax, double ay, double az, double bx, double by, double bz,
+		double strength, double core_radius)
+	{
+		const double r0x = bx - ax, r0y = by - ay, r0z = bz - az;
+		const double r0_sq = r0x * r0x + r0y * r0y + r0z * r0z;
+		// |r1 x r2|^2 = h^2 |r0|^2 for a point distance h from the filament's line.
+		const double core_term = core_radius * core_radius * r0_sq;
+		const double singular_limit = 1e-24 * r0_sq * r0_sq;
+		const double end_limit = 1e-24 * r0_sq;
+		const double coeff = strength / (4 * HBTK::Constants::pi());
+		for (int i = 0; i < n; i++) {
+			const double r1x = px[i] - ax, r1y = py[i] - ay, r1z = pz[i] - az;
+			const double r2x = px[i] - bx, r2y = py[i] - by, r2z = pz[i] - bz;
+			const double cx = r1y * r2z - r1z * r2y;
+			const double cy = r1z * r2x - r1x * r2z;
+			const double cz = r1x * r2y - r1y * r2x;
+			const double denominator = cx * cx + cy * cy + cz * cz + core_term;
+			const double r1l = sqrt(r1x * r1x + r1y * r1y + r1z * r1z);
+			const double r2l = sqrt(r2x * r2x + r2y * r2y + r2z * r2z);
+			const double r0r1 = r0x * r1x + r0y * r1y + r0z * r1z;
+			const double r0r2 = r0x * r2x + r0y * r2y + r0z * r2z;
+			// Points on the line of a singular filament or at the end of any 
+			// filament get no velocity. 
+			const double lengths = r1l * r2l;
+			const double safe_lengths = lengths > end_limit ? lengths : HUGE_VAL;
+			const double safe_denominator = denominator > singular_limit ? denominator : HUGE_VAL;
+			// One division: r0.r1 / |r1| - r0.r2 / |r2| over a common denominator.
+			const double k = coeff * (r0r1 * r2l - r0r2 * r1l) / (safe_lengths * safe_denominator);
+			u[i] += k * cx;
+			v[i] += k * cy;
+			w[i] += k * cz;
+		}
+	}
+
+	// Points per task in the induced_vel_and_pot functions of the point 
+	// singularities.
+	const int point_tile_size = 256;
+
+	// Add the velocity and potential of one source or vortex at n points, 
+	// in units of strength / 2 pi and strength / 4 pi. The potential needs 
+	// a call to log or atan2 per point, so it is taken in a second loop to
+	// let the velocity loop vectorise. It is skipped if potential is null.
+	void add_source_vel_and_pot(const double * __restrict px, const double * __restrict py,
+		double * __restrict u, double * __restrict v, double * __restrict potential, int n,
+		double xs, double ys, double strength)
+	{
+		for (int i = 0; i < n; i++) {
+			const double dx = px[i] - xs, dy = py[i] - ys;
+			const double r_sq = dx * dx + dy * dy;
+			const double k = strength / (r_sq > 0 ? r_sq : HUGE_VAL);
+			u[i] += k * dx;
+			v[i] += k * dy;
+		}
+		if (potential == nullptr) { return; }
+		for (int i = 0; i < n; i++) {
+			const double dx = px[i] - xs, dy = py[i] - ys;
+			const double r_sq = dx * dx + dy * dy;
+			potential[i] += strength * log(r_sq > 0 ? r_sq : 1.);
+		}
+	}
+
+	// As add_source_vel_and_pot, with the potential in units of 
+	// -strength / 2 pi.
+	void add_vortex_vel_and_pot(const double * __restrict px, const double * __restrict py,
+		double * __restrict u, double * __restrict v, double * __restrict potential, int n,
+		double xv, double yv, double strength)
+	{
+		for (int i = 0; i < n; i++) {
+			const double dx = px[i] - xv, dy = py[i] - yv;
+			const double r_sq = dx * dx + dy * dy;
+			const double k = strength / (r_sq > 0 ? r_sq : HUGE_VAL);
+			u[i] += k * dy;
+			v[i] -= k * dx;
+		}
+		if (potential == nullptr) { return; }
+		for (int i = 0; i < n; i++) { potential[i] += strength * atan2(py[i] - yv, px[i] - xv); }
+	}
+
+	// As add_source_vel_and_pot for a doublet with axis (ax, ay), with
+	// everything in units of strength / 2 pi. There is no transcendental
+	// function, so it is all one loop.
+	void add_doublet_vel_and_pot(const double * __restrict px, const double * __restrict py,
+		double * __restrict u, double * __restrict v, double * __restrict potential, int n,
+		double xd, double yd, double ax, double ay, double strength)
+	{
+		for (int i = 0; i < n; i++) {
+			const double dx = px[i] - xd, dy = py[i] - yd;
+			const double r_sq = dx * dx + dy * dy;
+			// Two divisions rather than 1 / r_sq, which GCC won't vectorise.
+			const double safe_r_sq = r_sq > 0 ? r_sq : HUGE_VAL;
+			const double k = strength / safe_r_sq;
+			const double a_dot_r = ax * dx + ay * dy;
+			const double m = 2 * a_dot_r / safe_r_sq;
+			u[i] += k * (m * dx - ax);
+			v[i] += k * (m * dy - ay);
+			potential[i] -= k * a_dot_r;
+		}
+	}
+
+	// Apply add(j, x, y, u, v, potential, n) for every singularity j to 
+	// tiles of measurement points, then scale the sums. If potential is null
+	// add is given a null potential, and only the velocity is computed.
+	template<typename Tf>
+	void tiled_vel_and_pot(const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+		int n_singularities, Tf & add, double vel_coeff, double pot_coeff,
+		std::vector<double> & u, std::vector<double> & v, std::vector<double> * potential,
+		int num_threads)
+	{
+		assert(x_mes.size() == y_mes.size());
+		assert(num_threads > 0);
+		const int n_points = (int)x_mes.size();
+		u.resize(n_points);
+		v.resize(n_points);
+		if (potential) { potential->resize(n_points); }
+		auto tile_task = [&](int tile) {
+			const int begin = tile * point_tile_size;
+			const int n = std::min(point_tile_size, n_points - begin);
+			double tx[point_tile_size], ty[point_tile_size];
+			double tu[point_tile_size] = {}, tv[point_tile_size] = {}, tp[point_tile_size] = {};
+			std::copy(x_mes.begin() + begin, x_mes.begin() + begin + n, tx);
+			std::copy(y_mes.begin() + begin, y_mes.begin() + begin + n, ty);
+			double * pot = potential ? tp : nullptr;
+			for (int j = 0; j < n_singularities; j++) { add(j, tx, ty, tu, tv, pot, n); }
+			for (int i = 0; i < n; i++) {
+				u[begin + i] = vel_coeff * tu[i];
+				v[begin + i] = vel_coeff * tv[i];
+			}
+			if (potential) {
+				for (int i = 0; i < n; i++) { (*potential)[begin + i] = pot_coeff * tp[i]; }
+			}
+		};
+		const int n_tiles = (n_points + point_tile_size - 1) / point_tile_size;
+		HBTK::parallel_for(n_tiles, num_threads, tile_task);
+	}
+
+	// Velocity, and potential if not null, of many sources.
+	void source_vel_and_pot(const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+		const std::vector<double> & x_sor, const std::vector<double> & y_sor,
+		const std::vector<double> & strengths,
+		std::vector<double> & u, std::vector<double> & v, std::vector<double> * potential,
+		int num_threads)
+	{
+		assert(x_sor.size() == y_sor.size());
+		assert(x_sor.size() == strengths.size());
+		auto add = [&](int j, const double * px, const double * py, 
+			double * tu, double * tv, double * tp, int n) {
+			add_source_vel_and_pot(px, py, tu, tv, tp, n, x_sor[j], y_sor[j], strengths[j]);
+		};
+		const double coeff = 1 / (2 * HBTK::Constants::pi());
+		tiled_vel_and_pot(x_mes, y_mes, (int)x_sor.size(), add, coeff, coeff / 2, u, v, potential, num_threads);
+	}
+
+	// Velocity, and potential if not null, of many vortices.
+	void vortex_vel_and_pot(const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+		const std::vector<double> & x_vor, const std::vector<double> & y_vor,
+		const std::vector<double> & strengths,
+		std::vector<double> & u, std::vector<double> & v, std::vector<double> * potential,
+		int num_threads)
+	{
+		assert(x_vor.size() == y_vor.size());
+		assert(x_vor.size() == strengths.size());
+		auto add = [&](int j, const double * px, const double * py, 
+			double * tu, double * tv, double * tp, int n) {
+			add_vortex_vel_and_pot(px, py, tu, tv, tp, n, x_vor[j], y_vor[j], strengths[j]);
+		};
+		const double coeff = 1 / (2 * HBTK::Constants::pi());
+		tiled_vel_and_pot(x_mes, y_mes, (int)x_vor.size(), add, coeff, -coeff, u, v, potential, num_threads);
+	}
+
+	// Terms of a second order expansion of the Biot-Savart kernel for a 
+	// cluster of filaments about a centre c. For each filament let 
+	// alpha = strength * (end - start) / 4 pi, d = midpoint - c and 
+	// D = d d^T + (end - start) (end - start)^T / 12, which is the mean of 
+	// (y - c)(y - c)^T along the filament. The terms are sums over the 
+	// filaments of:
+	//   A = alpha, M = alpha d^T, S = alpha trace(D), T = alpha D, 
+	//   N = (alpha x d) d^T.
+	// T is stored as the upper triangle (xx, xy, xz, yy, yz, zz) of D for 
+	// each component of alpha.
+	const int expansion_A = 0, expansion_M = 3, expansion_S = 12, expansion_T = 15,
+		expansion_N = 33, expansion_size = 42;
+
+	void add_to_expansion(double * e, const double * alpha, const double * d, const double * length)
+	{
+		double dd[6] = { d[0] * d[0], d[0] * d[1], d[0] * d[2], d[1] * d[1], d[1] * d[2], d[2] * d[2] };
+		const double ll[6] = { length[0] * length[0], length[0] * length[1], length[0] * length[2],
+			length[1] * length[1], length[1] * length[2], length[2] * length[2] };
+		for (int l = 0; l < 6; l++) { dd[l] += ll[l] / 12; }
+		const double trace = dd[0] + dd[3] + dd[5];
+		const double alpha_x_d[3] = { alpha[1] * d[2] - alpha[2] * d[1],
+			alpha[2] * d[0] - alpha[0] * d[2], alpha[0] * d[1] - alpha[1] * d[0] };
+		for (int k = 0; k < 3; k++) {
+			e[expansion_A + k] += alpha[k];
+			e[expansion_S + k] += alpha[k] * trace;
+			for (int l = 0; l < 3; l++) {
+				e[expansion_M + 3 * k + l] += alpha[k] * d[l];
+				e[expansion_N + 3 * k + l] += alpha_x_d[k] * d[l];
+			}
+			for (int l = 0; l < 6; l++) { e[expansion_T + 6 * k + l] += alpha[k] * dd[l]; }
+		}
+	}
+
+	// Velocity induced at n points by a distant cluster of filaments with 
+	// expansion e about (cx, cy, cz). Expanding (r - d) / |r - d|^3 for 
+	// r = point - c to second order in d gives
+	//   u = [A x r - (M_yz - M_zy, ...)] / |r|^3 + 3 (M r) x r / |r|^5 
+	//     - 3/2 S x r / |r|^5 - 3 N r / |r|^5 + 15/2 (T : r r) x r / |r|^7.
+	void add_cluster_vel(const double * __restrict px, const double * __restrict py, 
+		const double * __restrict pz, double * __restrict u, double * __restrict v, 
+		double * __restrict w, int n,
+		double cx, double cy, double cz, const double * e)
+	{
+		const double a0 = e[expansion_A], a1 = e[expansion_A + 1], a2 = e[expansion_A + 2];
+		const double * M = e + expansion_M;
+		const double m00 = M[0], m01 = M[1], m02 = M[2];
+		const double m10 = M[3], m11 = M[4], m12 = M[5];
+		const double m20 = M[6], m21 = M[7], m22 = M[8];
+		const double bx = m12 - m21, by = m20 - m02, bz = m01 - m10;
+		const double s0 = 1.5 * e[expansion_S], s1 = 1.5 * e[expansion_S + 1], s2 = 1.5 * e[expansion_S + 2];
+		const double * T = e + expansion_T;
+		const double t0xx = T[0], t0xy = 2 * T[1], t0xz = 2 * T[2], t0yy = T[3], t0yz = 2 * T[4], t0zz = T[5];
+		const double t1xx = T[6], t1xy = 2 * T[7], t1xz = 2 * T[8], t1yy = T[9], t1yz = 2 * T[10], t1zz = T[11];
+		const double t2xx = T[12], t2xy = 2 * T[13], t2xz = 2 * T[14], t2yy = T[15], t2yz = 2 * T[16], t2zz = T[17];
+		const double * N = e + expansion_N;
+		const double n00 = 3 * N[0], n01 = 3 * N[1], n02 = 3 * N[2];
+		const double n10 = 3 * N[3], n11 = 3 * N[4], n12 = 3 * N[5];
+		const double n20 = 3 * N[6], n21 = 3 * N[7], n22 = 3 * N[8];
+		for (int i = 0; i < n; i++) {
+			const double rx = px[i] - cx, ry = py[i] - cy, rz = pz[i] - cz;
+			const double xx = rx * rx, xy = rx * ry, xz = rx * rz, yy = ry * ry, yz = ry * rz, zz = rz * rz;
+			const double inv_r_sq = 1 / (xx + yy + zz);
+			const double inv_r3 = inv_r_sq * sqrt(inv_r_sq);
+			const double inv_r5 = inv_r3 * inv_r_sq;
+			const double inv_r7 = inv_r5 * inv_r_sq;
+			// First order.
+			const double mx = m00 * rx + m01 * ry + m02 * rz;
+			const double my = m10 * rx + m11 * ry + m12 * rz;
+			const double mz = m20 * rx + m21 * ry + m22 * rz;
+			// Second order.
+			const double tx = 7.5 * inv_r7 * (t0xx * xx + t0xy * xy + t0xz * xz + t0yy * yy + t0yz * yz + t0zz * zz);
+			const double ty = 7.5 * inv_r7 * (t1xx * xx + t1xy * xy + t1xz * xz + t1yy * yy + t1yz * yz + t1zz * zz);
+			const double tz = 7.5 * inv_r7 * (t2xx * xx + t2xy * xy + t2xz * xz + t2yy * yy + t2yz * yz + t2zz * zz);
+			const double qx = 3 * inv_r5 * mx - s0 * inv_r5 + tx;
+			const double qy = 3 * inv_r5 * my - s1 * inv_r5 + ty;
+			const double qz = 3 * inv_r5 * mz - s2 * inv_r5 + tz;
+			const double ax = a0 * inv_r3 + qx, ay = a1 * inv_r3 + qy, az = a2 * inv_r3 + qz;
+			u[i] += ay * rz - az * ry - bx * inv_r3 - inv_r5 * (n00 * rx + n01 * ry + n02 * rz);
+			v[i] += az * rx - ax * rz - by * inv_r3 - inv_r5 * (n10 * rx + n11 * ry + n12 * rz);
+			w[i] += ax * ry - ay * rx - bz * inv_r3 - inv_r5 * (n20 * rx + n21 * ry + n22 * rz);
+		}
+	}
+
+	// Points per leaf of the trees used by the fast summation methods.
+	const int treecode_source_leaf_size = 32;
+	const int treecode_target_leaf_size = 64;
+	const int fmm_leaf_size = 32;
+	// Interacting FMM nodes satisfy (r_mes + r_sing) < fmm_separation * distance.
+	const double fmm_separation = 0.5;
+
+	// A node of a tree that recursively splits a set of points into 2^Dim 
+	// boxes. The node holds the points order[begin] to order[end - 1], and its 
+	// children are the nodes first_child to first_child + num_children - 1. 
+	// Radius is the distance from the centre to the furthest point.
+	template<int Dim>
+	struct TreeNode {
+		std::array<double, Dim> centre;
+		double radius;
+		int begin, end;
+		int first_child, num_children;
+		int depth;
+	};
+
+	template<int Dim>
+	TreeNode<Dim> make_tree_node(const std::array<const double *, Dim> & coords,
+		const std::vector<int> & order, int begin, int end, int depth)
+	{
+		TreeNode<Dim> node;
+		std::array<double, Dim> lower, upper;
+		lower.fill(HUGE_VAL);
+		upper.fill(-HUGE_VAL);
+		for (int i = begin; i < end; i++) {
+			for (int d = 0; d < Dim; d++) {
+				lower[d] = std::min(lower[d], coords[d][order[i]]);
+				upper[d] = std::max(upper[d], coords[d][order[i]]);
+			}
+		}
+		for (int d = 0; d < Dim; d++) { node.centre[d] = 0.5 * (lower[d] + upper[d]); }
+		double radius_sq = 0;
+		for (int i = begin; i < end; i++) {
+			double dist_sq = 0;
+			for (int d = 0; d < Dim; d++) {
+				dist_sq += pow(coords[d][order[i]] - node.centre[d], 2);
+			}
+			radius_sq = std::max(radius_sq, dist_sq);
+		}
+		node.radius = sqrt(radius_sq);
+		node.begin = begin;
+		node.end = end;
+		node.first_child = 0;
+		node.num_children = 0;
+		node.depth = depth;
+		return node;
+	}
+
+	// Build a tree over num_points points with no more than leaf_size points
+	// in a leaf, unless the points are coincident. order is set to the 
+	// permutation of the points into tree order. Children always come after 
+	// their parent in the returned vector.
+	template<int Dim>
+	std::vector<TreeNode<Dim>> build_tree(const std::array<const double *, Dim> & coords,
+		int num_points, int leaf_size, std::vector<int> & order)
+	{
+		const int max_depth = 48;
+		order.resize(num_points);
+		for (int i = 0; i < num_points; i++) { order[i] = i; }
+		std::vector<TreeNode<Dim>> nodes;
+		nodes.push_back(make_tree_node<Dim>(coords, order, 0, num_points, 0));
+		for (int n = 0; n < (int)nodes.size(); n++) {
+			const TreeNode<Dim> node = nodes[n];
+			if (node.end - node.begin <= leaf_size || node.radius == 0 
+				|| node.depth == max_depth) { continue; }
+			// Split each range about the centre in each dimension in turn.
+			std::vector<int> bounds = { node.begin, node.end };
+			for (int d = 0; d < Dim; d++) {
+				std::vector<int> new_bounds = { node.begin };
+				for (int r = 0; r + 1 < (int)bounds.size(); r++) {
+					auto middle = std::partition(order.begin() + bounds[r], order.begin() + bounds[r + 1],
+						[&](int i) { return coords[d][i] < node.centre[d]; });
+					new_bounds.push_back((int)(middle - order.begin()));
+					new_bounds.push_back(bounds[r + 1]);
+				}
+				bounds = new_bounds;
+			}
+			nodes[n].first_child = (int)nodes.size();
+			for (int r = 0; r + 1 < (int)bounds.size(); r++) {
+				if (bounds[r] == bounds[r + 1]) { continue; }
+				nodes.push_back(make_tree_node<Dim>(coords, order, bounds[r], bounds[r + 1], node.depth + 1));
+				nodes[n].num_children++;
+			}
+		}
+		return nodes;
+	}
+
+	// Complex multiplication without std::complex's checks for infinities, 
+	// which stop the compiler inlining it.
+	inline std::complex<double> cmul(std::complex<double> a, std::complex<double> b)
+	{
+		return std::complex<double>(a.real() * b.real() - a.imag() * b.imag(),
+			a.real() * b.imag() + a.imag() * b.real());
+	}
+
+	// Complex velocity w = u - iv induced at the measurement points by 2D 
+	// point singularities. A singularity at z_j with complex strength q_j
+	// induces w(z) = q_j / (2 pi (z - z_j)), so sources have real q and 
+	// vortices imaginary q. 
+	//
+	// This is an adaptive fast multipole method: both sets of points are 
+	// sorted into quadtrees and the trees are traversed together. Well
+	// separated pairs of nodes interact through a multipole expansion of the
+	// singularity node converted to a Taylor (local) expansion about the 
+	// measurement node. Other pairs are split until they are leaves, which 
+	// interact directly. The series ratio of every expansion is less than
+	// fmm_separation, and enough terms are kept to reach the tolerance.
+	std::vector<std::complex<double>> complex_vel_fmm(
+		const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+		const std::vector<double> & x_sing, const std::vector<double> & y_sing,
+		const std::vector<std::complex<double>> & q, double tolerance)
+	{
+		typedef std::complex<double> Complex;
+		const int n_mes = (int)x_mes.size(), n_sing = (int)x_sing.size();
+		std::vector<Complex> w(n_mes, 0.);
+		if (n_mes == 0 || n_sing == 0) { return w; }
+		const int order = std::max(2, std::min(60, 
+			(int)ceil(log(tolerance) / log(fmm_separation))));
+		const int terms = order + 1;
+		const int max_n = 2 * terms;
+		std::vector<double> binomial(max_n * max_n, 0.);
+		for (int n = 0; n < max_n; n++) {
+			binomial[n * max_n] = 1;
+			for (int k = 1; k <= n; k++) {
+				binomial[n * max_n + k] = binomial[(n - 1) * max_n + k - 1] + binomial[(n - 1) * max_n + k];
+			}
+		}
+		auto choose = [&](int n, int k) { return binomial[n * max_n + k]; };
+
+		std::vector<int> m_order, s_order;
+		auto m_tree = build_tree<2>({ { x_mes.data(), y_mes.data() } }, n_mes, fmm_leaf_size, m_order);
+		auto s_tree = build_tree<2>({ { x_sing.data(), y_sing.data() } }, n_sing, fmm_leaf_size, s_order);
+		auto centre = [](const TreeNode<2> & node) { return Complex(node.centre[0], node.centre[1]); };
+		// Singularities in tree order, so that leaves are contiguous.
+		std::vector<Complex> zs(n_sing), qs(n_sing);
+		for (int i = 0; i < n_sing; i++) {
+			zs[i] = Complex(x_sing[s_order[i]], y_sing[s_order[i]]);
+			qs[i] = q[s_order[i]];
+		}
+
+		// Upward pass: each singularity node's expansion is 
+		// sum_k a_k / (z - c)^(k+1) with a_k = sum_j q_j (z_j - c)^k.
+		std::vector<Complex> multipoles(s_tree.size() * terms, 0.);
+		std::vector<Complex> powers(terms);
+		for (int n = (int)s_tree.size() - 1; n >= 0; n--) {
+			const auto & node = s_tree[n];
+			Complex * a = &multipoles[n * terms];
+			if (node.num_children == 0) {
+				for (int j = node.begin; j < node.end; j++) {
+					const Complex d = zs[j] - centre(node);
+					Complex term = qs[j];
+					for (int k = 0; k < terms; k++) {
+						a[k] += term;
+						term = cmul(term, d);
+					}
+				}
+				continue;
+			}
+			for (int c = node.first_child; c < node.first_child + node.num_children; c++) {
+				const Complex * a_child = &multipoles[c * terms];
+				const Complex d = centre(s_tree[c]) - centre(node);
+				powers[0] = 1;
+				for (int k = 1; k < terms; k++) { powers[k] = cmul(powers[k - 1], d); }
+				for (int k = 0; k < terms; k++) {
+					for (int m = 0; m <= k; m++) {
+						a[k] += choose(k, m) * cmul(a_child[m], powers[k - m]);
+					}
+				}
+			}
+		}
+
+		// Dual tree traversal. Local expansions are sum_l b_l (z - c)^l.
+		std::vector<Complex> locals(m_tree.size() * terms, 0.);
+		std::vector<Complex> scaled(terms);
+		std::vector<std::pair<int, int>> stack = { { 0, 0 } };
+		while (!stack.empty()) {
+			const int mi = stack.back().first, si = stack.back().second;
+			stack.pop_back();
+			const auto & m_node = m_tree[mi];
+			const auto & s_node = s_tree[si];
+			const bool m_leaf = m_node.num_children == 0, s_leaf = s_node.num_children == 0;
+			const Complex D = centre(m_node) - centre(s_node);
+			if (m_node.radius + s_node.radius < fmm_separation * abs(D)) {
+				const Complex inv_D = 1. / D;
+				Complex inv_D_power = inv_D;
+				const Complex * a = &multipoles[si * terms];
+				for (int k = 0; k < terms; k++) {
+					scaled[k] = cmul(a[k], inv_D_power);
+					inv_D_power = cmul(inv_D_power, inv_D);
+				}
+				Complex * b = &locals[mi * terms];
+				Complex factor = 1.;
+				for (int l = 0; l < terms; l++) {
+					Complex sum = 0.;
+					for (int k = 0; k < terms; k++) { sum += choose(k + l, l) * scaled[k]; }
+					b[l] += cmul(sum, factor);
+					factor = cmul(factor, -inv_D);
+				}
+			}
+			else if (m_leaf && s_leaf) {
+				for (int i = m_node.begin; i < m_node.end; i++) {
+					const int mes = m_order[i];
+					const double x = x_mes[mes], y = y_mes[mes];
+					double sum_re = 0, sum_im = 0;
+					for (int j = s_node.begin; j < s_node.end; j++) {
+						// q / d = q conj(d) / |d|^2. Coincident points are skipped.
+						const double dx = x - zs[j].real(), dy = y - zs[j].imag();
+						const double r_sq = dx * dx + dy * dy;
+						const double inv_r_sq = 1 / (r_sq > 0 ? r_sq : HUGE_VAL);
+						sum_re += (qs[j].real() * dx + qs[j].imag() * dy) * inv_r_sq;
+						sum_im += (qs[j].imag() * dx - qs[j].real() * dy) * inv_r_sq;
+					}
+					w[mes] += Complex(sum_re, sum_im);
+				}
+			}
+			else if (s_leaf || (!m_leaf && m_node.radius >= s_node.radius)) {
+				for (int c = m_node.first_child; c < m_node.first_child + m_node.num_children; c++) {
+					stack.emplace_back(c, si);
+				}
+			}
+			else {
+				for (int c = s_node.first_child; c < s_node.first_child + s_node.num_children; c++) {
+					stack.emplace_back(mi, c);
+				}
+			}
+		}
+
+		// Downward pass: shift local expansions to children and evaluate them
+		// at the leaves.
+		for (int n = 0; n < (int)m_tree.size(); n++) {
+			const auto & node = m_tree[n];
+			const Complex * b = &locals[n * terms];
+			if (node.num_children == 0) {
+				for (int i = node.begin; i < node.end; i++) {
+					const int mes = m_order[i];
+					const Complex t = Complex(x_mes[mes], y_mes[mes]) - centre(node);
+					Complex sum = b[order];
+					for (int l = order - 1; l >= 0; l--) { sum = cmul(sum, t) + b[l]; }
+					w[mes] += sum;
+				}
+				continue;
+			}
+			for (int c = node.first_child; c < node.first_child + node.num_children; c++) {
+				Complex * b_child = &locals[c * terms];
+				const Complex e = centre(m_tree[c]) - centre(node);
+				powers[0] = 1;
+				for (int k = 1; k < terms; k++) { powers[k] = cmul(powers[k - 1], e); }
+				for (int m = 0; m < terms; m++) {
+					for (int l = m; l < terms; l++) {
+						b_child[m] += choose(l, m) * cmul(b[l], powers[l - m]);
+					}
+				}
+			}
+		}
+		const double coeff = 1 / (2 * HBTK::Constants::pi());
+		for (auto & wi : w) { wi *= coeff; }
+		return w;
+	}
+
+	// (u, v) from complex velocities u - iv.
+	std::pair<std::vector<double>, std::vector<double>> velocity_components(
+		const std::vector<std::complex<double>> & w)
+	{
+		std::vector<double> u(w.size()), v(w.size());
+		for (size_t i = 0; i < w.size(); i++) {
+			u[i] = w[i].real();
+			v[i] = -w[i].imag();
+		}
+		return std::make_pair(u, v);
+	}
+}
 
 HBTK::CartesianVector3D HBTK::BiotSavart::unity_vel(CartesianPoint3D & mes_point, CartesianFiniteLine3D & filament)
 {
@@ -43,8 +587,396 @@ HBTK::CartesianVector3D HBTK::BiotSavart::unity_vel(CartesianPoint3D & mes_point
 
 	double r1c = r0.dot(r1) / r1l;
 	double r2c = r0.dot(r2) / r2l;
-	double K = (r1c + r2c) / global_denominator;
+	double K = (r1c - r2c) / global_denominator;
 	CartesianVector3D output = r1.cross(r2) * K;
 	return output;
 }
 
+/// \param mes_points the points at which to compute the velocity.
+/// \param filament_starts the start point of each filament.
+/// \param filament_ends the end point of each filament.
+/// \param strengths the circulation of each filament.
+/// \param core_radius radius of a Scully vortex core, or zero for singular 
+/// filaments.
+/// \param num_threads the maximum number of threads to use.
+///
+/// \brief Sum the velocities induced by many straight vortex filaments at 
+/// many points.
+///
+/// Each filament is evaluated against a tile of points at a time, so that 
+/// the tile stays in cache and the inner loop vectorises. Tiles are shared 
+/// between threads, and the result does not depend on the number of threads.
+///
+/// The Scully core replaces the squared perpendicular distance h^2 from the
+/// filament's line with h^2 + core_radius^2. Points on the line of a 
+/// singular filament have no velocity induced by that filament.
+HBTK::VectorField3D HBTK::BiotSavart::induced_vel(const PointCloud3D & mes_points,
+	const PointCloud3D & filament_starts, const PointCloud3D & filament_ends,
+	const std::vector<double> & strengths, double core_radius, int num_threads)
+{
+	assert(filament_starts.size() == filament_ends.size());
+	assert(filament_starts.size() == (int)strengths.size());
+	assert(core_radius >= 0);
+	assert(num_threads > 0);
+	const int n_points = mes_points.size();
+	const int n_filaments = filament_starts.size();
+	VectorField3D result(n_points);
+	const double * px = mes_points.x().data();
+	const double * py = mes_points.y().data();
+	const double * pz = mes_points.z().data();
+	double * u = result.x().data();
+	double * v = result.y().data();
+	double * w = result.z().data();
+	const auto & ax = filament_starts.x(), & ay = filament_starts.y(), & az = filament_starts.z();
+	const auto & bx = filament_ends.x(), & by = filament_ends.y(), & bz = filament_ends.z();
+
+	auto tile_task = [&](int tile) {
+		const int begin = tile * biot_savart_tile_size;
+		const int n = std::min(biot_savart_tile_size, n_points - begin);
+		double tx[biot_savart_tile_size], ty[biot_savart_tile_size], tz[biot_savart_tile_size];
+		double tu[biot_savart_tile_size] = {}, tv[biot_savart_tile_size] = {}, tw[biot_savart_tile_size] = {};
+		std::copy(px + begin, px + begin + n, tx);
+		std::copy(py + begin, py + begin + n, ty);
+		std::copy(pz + begin, pz + begin + n, tz);
+		for (int j = 0; j < n_filaments; j++) {
+			add_filament_vel(tx, ty, tz, tu, tv, tw, n,
+				ax[j], ay[j], az[j], bx[j], by[j], bz[j], strengths[j], core_radius);
+		}
+		std::copy(tu, tu + n, u + begin);
+		std::copy(tv, tv + n, v + begin);
+		std::copy(tw, tw + n, w + begin);
+	};
+	const int n_tiles = (n_points + biot_savart_tile_size - 1) / biot_savart_tile_size;
+	parallel_for(n_tiles, num_threads, tile_task);
+	return result;
+}
+
+/// \param mes_points the points at which to compute the velocity.
+/// \param filament_starts the start point of each filament.
+/// \param filament_ends the end point of each filament.
+/// \param strengths the circulation of each filament.
+/// \param core_radius radius of a Scully vortex core, or zero for singular 
+/// filaments.
+/// \param num_threads the maximum number of threads to use.
+/// \param opening_angle accuracy parameter in (0, 1). Smaller is more 
+/// accurate and slower.
+///
+/// \brief Sum the velocities induced by many straight vortex filaments at 
+/// many points using a Barnes-Hut treecode.
+///
+/// The filaments are sorted into an octree by their midpoints, and the 
+/// measurement points into a second octree. Each leaf of measurement points
+/// walks the filament tree. A filament node of radius r_f whose centre is D 
+/// from a leaf of radius r_p is used as a single second order expansion if
+/// r_f + r_p < opening_angle * D. Otherwise its children are visited, and 
+/// the filaments of leaves are summed as in induced_vel. The error of the
+/// expansion is of order opening_angle^3 relative to the node's contribution.
+///
+/// Vortex cores are only applied to directly summed filaments. The Scully 
+/// core acts on the distance from a filament's line, so points near the 
+/// line of a distant filament lose the most accuracy when a core is used.
+HBTK::VectorField3D HBTK::BiotSavart::induced_vel_treecode(const PointCloud3D & mes_points,
+	const PointCloud3D & filament_starts, const PointCloud3D & filament_ends,
+	const std::vector<double> & strengths, double core_radius, int num_threads,
+	double opening_angle)
+{
+	assert(filament_starts.size() == filament_ends.size());
+	assert(filament_starts.size() == (int)strengths.size());
+	assert(core_radius >= 0);
+	assert(num_threads > 0);
+	assert(opening_angle > 0 && opening_angle < 1);
+	const int n_points = mes_points.size();
+	const int n_filaments = filament_starts.size();
+	VectorField3D result(n_points);
+	if (n_points == 0 || n_filaments == 0) { return result; }
+	const auto & ax = filament_starts.x(), & ay = filament_starts.y(), & az = filament_starts.z();
+	const auto & bx = filament_ends.x(), & by = filament_ends.y(), & bz = filament_ends.z();
+
+	std::vector<double> mx(n_filaments), my(n_filaments), mz(n_filaments);
+	for (int j = 0; j < n_filaments; j++) {
+		mx[j] = 0.5 * (ax[j] + bx[j]);
+		my[j] = 0.5 * (ay[j] + by[j]);
+		mz[j] = 0.5 * (az[j] + bz[j]);
+	}
+	std::vector<int> f_order;
+	auto f_tree = build_tree<3>({ { mx.data(), my.data(), mz.data() } }, 
+		n_filaments, treecode_source_leaf_size, f_order);
+	// Filaments in tree order, so that leaves are contiguous.
+	std::vector<double> sax(n_filaments), say(n_filaments), saz(n_filaments);
+	std::vector<double> sbx(n_filaments), sby(n_filaments), sbz(n_filaments), sg(n_filaments);
+	for (int i = 0; i < n_filaments; i++) {
+		const int j = f_order[i];
+		sax[i] = ax[j]; say[i] = ay[j]; saz[i] = az[j];
+		sbx[i] = bx[j]; sby[i] = by[j]; sbz[i] = bz[j];
+		sg[i] = strengths[j];
+	}
+	// Node radii must enclose whole filaments rather than their midpoints.
+	const double coeff = 1 / (4 * HBTK::Constants::pi());
+	std::vector<std::array<double, expansion_size>> expansions(f_tree.size());
+	for (int n = 0; n < (int)f_tree.size(); n++) {
+		auto & node = f_tree[n];
+		expansions[n].fill(0);
+		double radius_sq = 0;
+		for (int i = node.begin; i < node.end; i++) {
+			const std::array<double, 3> a = { { sax[i], say[i], saz[i] } }, b = { { sbx[i], sby[i], sbz[i] } };
+			double a_sq = 0, b_sq = 0;
+			double alpha[3], d[3], length[3];
+			for (int k = 0; k < 3; k++) {
+				a_sq += pow(a[k] - node.centre[k], 2);
+				b_sq += pow(b[k] - node.centre[k], 2);
+				alpha[k] = coeff * sg[i] * (b[k] - a[k]);
+				d[k] = 0.5 * (a[k] + b[k]) - node.centre[k];
+				length[k] = b[k] - a[k];
+			}
+			radius_sq = std::max(radius_sq, std::max(a_sq, b_sq));
+			add_to_expansion(expansions[n].data(), alpha, d, length);
+		}
+		node.radius = sqrt(radius_sq);
+	}
+
+	std::vector<int> p_order;
+	auto p_tree = build_tree<3>({ { mes_points.x().data(), mes_points.y().data(), mes_points.z().data() } },
+		n_points, treecode_target_leaf_size, p_order);
+	std::vector<int> leaves;
+	for (int n = 0; n < (int)p_tree.size(); n++) {
+		if (p_tree[n].num_children == 0) { leaves.push_back(n); }
+	}
+	const double * px = mes_points.x().data();
+	const double * py = mes_points.y().data();
+	const double * pz = mes_points.z().data();
+	double * u = result.x().data();
+	double * v = result.y().data();
+	double * w = result.z().data();
+
+	auto leaf_task = [&](int leaf) {
+		const auto & target = p_tree[leaves[leaf]];
+		std::vector<int> stack;
+		double tx[biot_savart_tile_size], ty[biot_savart_tile_size], tz[biot_savart_tile_size];
+		double tu[biot_savart_tile_size], tv[biot_savart_tile_size], tw[biot_savart_tile_size];
+		// Leaves of coincident points may not fit in one tile.
+		for (int begin = target.begin; begin < target.end; begin += biot_savart_tile_size) {
+			const int n = std::min(biot_savart_tile_size, target.end - begin);
+			for (int i = 0; i < n; i++) {
+				const int p = p_order[begin + i];
+				tx[i] = px[p]; ty[i] = py[p]; tz[i] = pz[p];
+				tu[i] = 0; tv[i] = 0; tw[i] = 0;
+			}
+			stack.assign(1, 0);
+			while (!stack.empty()) {
+				const auto & source = f_tree[stack.back()];
+				const auto & expansion = expansions[stack.back()];
+				stack.pop_back();
+				const double distance = sqrt(pow(target.centre[0] - source.centre[0], 2)
+					+ pow(target.centre[1] - source.centre[1], 2) 
+					+ pow(target.centre[2] - source.centre[2], 2));
+				if (target.radius + source.radius < opening_angle * distance) {
+					add_cluster_vel(tx, ty, tz, tu, tv, tw, n, source.centre[0], source.centre[1],
+						source.centre[2], expansion.data());
+				}
+				else if (source.num_children == 0) {
+					for (int j = source.begin; j < source.end; j++) {
+						add_filament_vel(tx, ty, tz, tu, tv, tw, n, sax[j], say[j], saz[j],
+							sbx[j], sby[j], sbz[j], sg[j], core_radius);
+					}
+				}
+				else {
+					for (int c = source.first_child; c < source.first_child + source.num_children; c++) {
+						stack.push_back(c);
+					}
+				}
+			}
+			for (int i = 0; i < n; i++) {
+				const int p = p_order[begin + i];
+				u[p] = tu[i]; v[p] = tv[i]; w[p] = tw[i];
+			}
+		}
+	};
+	parallel_for((int)leaves.size(), num_threads, leaf_task);
+	return result;
+}
+
+/// \param x_mes x coordinates of the measurement points.
+/// \param y_mes y coordinates of the measurement points.
+/// \param x_dub x coordinates of the doublets.
+/// \param y_dub y coordinates of the doublets.
+/// \param strengths the strength of each doublet.
+/// \param angles the angle of each doublet, as for unity_u_vel.
+/// \param u output x velocity at each measurement point.
+/// \param v output y velocity at each measurement point.
+/// \param potential output velocity potential at each measurement point.
+/// \param num_threads the number of threads to use.
+///
+/// \brief The velocity and potential induced at every measurement point by
+/// every doublet.
+///
+/// The squared distance is shared by u, v and the potential. Each doublet 
+/// is evaluated against a tile of points at a time, and the loop over the 
+/// tile vectorises. A doublet coincident with a measurement point induces 
+/// nothing at it.
+void HBTK::PointDoublet::induced_vel_and_pot(
+	const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+	const std::vector<double> & x_dub, const std::vector<double> & y_dub,
+	const std::vector<double> & strengths, const std::vector<double> & angles,
+	std::vector<double> & u, std::vector<double> & v, std::vector<double> & potential,
+	int num_threads)
+{
+	assert(x_dub.size() == y_dub.size());
+	assert(x_dub.size() == strengths.size());
+	assert(x_dub.size() == angles.size());
+	std::vector<double> ax(angles.size()), ay(angles.size());
+	for (size_t j = 0; j < angles.size(); j++) {
+		ax[j] = -sin(angles[j]);
+		ay[j] = cos(angles[j]);
+	}
+	auto add = [&](int j, const double * px, const double * py, 
+		double * tu, double * tv, double * tp, int n) {
+		add_doublet_vel_and_pot(px, py, tu, tv, tp, n, x_dub[j], y_dub[j], ax[j], ay[j], strengths[j]);
+	};
+	const double coeff = 1 / (2 * HBTK::Constants::pi());
+	tiled_vel_and_pot(x_mes, y_mes, (int)x_dub.size(), add, coeff, coeff, u, v, &potential, num_threads);
+}
+
+/// \param x_mes x coordinates of the measurement points.
+/// \param y_mes y coordinates of the measurement points.
+/// \param x_sor x coordinates of the sources.
+/// \param y_sor y coordinates of the sources.
+/// \param strengths the strength of each source.
+///
+/// \brief The velocity induced at every measurement point by every source.
+///
+/// Returns (u, v). A source coincident with a measurement point 
+/// induces no velocity at it.
+std::pair<std::vector<double>, std::vector<double>> HBTK::PointSource::induced_vel(
+	const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+	const std::vector<double> & x_sor, const std::vector<double> & y_sor,
+	const std::vector<double> & strengths)
+{
+	std::vector<double> u, v;
+	source_vel_and_pot(x_mes, y_mes, x_sor, y_sor, strengths, u, v, nullptr, 1);
+	return std::make_pair(u, v);
+}
+
+/// \param x_mes x coordinates of the measurement points.
+/// \param y_mes y coordinates of the measurement points.
+/// \param x_sor x coordinates of the sources.
+/// \param y_sor y coordinates of the sources.
+/// \param strengths the strength of each source.
+/// \param tolerance relative truncation error of the multipole series. 
+/// Smaller is more accurate and slower.
+///
+/// \brief The velocity induced at every measurement point by every source,
+/// using a fast multipole method.
+///
+/// Returns (u, v), as induced_vel. The cost is roughly proportional to 
+/// the number of points rather than its square.
+std::pair<std::vector<double>, std::vector<double>> HBTK::PointSource::induced_vel_fmm(
+	const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+	const std::vector<double> & x_sor, const std::vector<double> & y_sor,
+	const std::vector<double> & strengths, double tolerance)
+{
+	assert(x_mes.size() == y_mes.size());
+	assert(x_sor.size() == y_sor.size());
+	assert(x_sor.size() == strengths.size());
+	assert(tolerance > 0 && tolerance < 1);
+	std::vector<std::complex<double>> q(strengths.begin(), strengths.end());
+	return velocity_components(complex_vel_fmm(x_mes, y_mes, x_sor, y_sor, q, tolerance));
+}
+
+/// \param x_mes x coordinates of the measurement points.
+/// \param y_mes y coordinates of the measurement points.
+/// \param x_sor x coordinates of the sources.
+/// \param y_sor y coordinates of the sources.
+/// \param strengths the strength of each source.
+/// \param u output x velocity at each measurement point.
+/// \param v output y velocity at each measurement point.
+/// \param potential output velocity potential at each measurement point.
+/// \param num_threads the number of threads to use.
+///
+/// \brief The velocity and potential induced at every measurement point by
+/// every source.
+///
+/// As PointDoublet::induced_vel_and_pot. The potential is 
+/// strength log(r^2) / 4 pi, which saves a square root.
+void HBTK::PointSource::induced_vel_and_pot(
+	const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+	const std::vector<double> & x_sor, const std::vector<double> & y_sor,
+	const std::vector<double> & strengths,
+	std::vector<double> & u, std::vector<double> & v, std::vector<double> & potential,
+	int num_threads)
+{
+	source_vel_and_pot(x_mes, y_mes, x_sor, y_sor, strengths, u, v, &potential, num_threads);
+}
+
+
+/// \param x_mes x coordinates of the measurement points.
+/// \param y_mes y coordinates of the measurement points.
+/// \param x_vor x coordinates of the vortices.
+/// \param y_vor y coordinates of the vortices.
+/// \param strengths the strength of each vortex.
+///
+/// \brief The velocity induced at every measurement point by every vortex.
+///
+/// Returns (u, v). A vortex coincident with a measurement point 
+/// induces no velocity at it.
+std::pair<std::vector<double>, std::vector<double>> HBTK::PointVortex::induced_vel(
+	const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+	const std::vector<double> & x_vor, const std::vector<double> & y_vor,
+	const std::vector<double> & strengths)
+{
+	std::vector<double> u, v;
+	vortex_vel_and_pot(x_mes, y_mes, x_vor, y_vor, strengths, u, v, nullptr, 1);
+	return std::make_pair(u, v);
+}
+
+/// \param x_mes x coordinates of the measurement points.
+/// \param y_mes y coordinates of the measurement points.
+/// \param x_vor x coordinates of the vortices.
+/// \param y_vor y coordinates of the vortices.
+/// \param strengths the strength of each vortex.
+/// \param tolerance relative truncation error of the multipole series. 
+/// Smaller is more accurate and slower.
+///
+/// \brief The velocity induced at every measurement point by every vortex,
+/// using a fast multipole method.
+///
+/// Returns (u, v), as induced_vel. The cost is roughly proportional to 
+/// the number of points rather than its square.
+std::pair<std::vector<double>, std::vector<double>> HBTK::PointVortex::induced_vel_fmm(
+	const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+	const std::vector<double> & x_vor, const std::vector<double> & y_vor,
+	const std::vector<double> & strengths, double tolerance)
+{
+	assert(x_mes.size() == y_mes.size());
+	assert(x_vor.size() == y_vor.size());
+	assert(x_vor.size() == strengths.size());
+	assert(tolerance > 0 && tolerance < 1);
+	std::vector<std::complex<double>> q(strengths.size());
+	for (size_t j = 0; j < strengths.size(); j++) { q[j] = std::complex<double>(0, strengths[j]); }
+	return velocity_components(complex_vel_fmm(x_mes, y_mes, x_vor, y_vor, q, tolerance));
+}
+
+/// \param x_mes x coordinates of the measurement points.
+/// \param y_mes y coordinates of the measurement points.
+/// \param x_vor x coordinates of the vortices.
+/// \param y_vor y coordinates of the vortices.
+/// \param strengths the strength of each vortex.
+/// \param u output x velocity at each measurement point.
+/// \param v output y velocity at each measurement point.
+/// \param potential output velocity potential at each measurement point.
+/// \param num_threads the number of threads to use.
+///
+/// \brief The velocity and potential induced at every measurement point by
+/// every vortex.
+///
+/// As PointDoublet::induced_vel_and_pot. The potential has the branch cut
+/// of unity_vel_pot.
+void HBTK::PointVortex::induced_vel_and_pot(
+	const std::vector<double> & x_mes, const std::vector<double> & y_mes,
+	const std::vector<double> & x_vor, const std::vector<double> & y_vor,
+	const std::vector<double> & strengths,
+	std::vector<double> & u, std::vector<double> & v, std::vector<double> & potential,
+	int num_threads)
+{
+	vortex_vel_and_pot(x_mes, y_mes, x_vor, y_vor, strengths, u, v, &potential, num_threads);
+}
+
@@ -0,0 +1,221 @@
+#include "QuadratureCache.h"
+/*////////////////////////////////////////////////////////////////////////////
+QuadratureCache.cpp
+
+A process-wide cache of Gaussian quadrature rules.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <mutex>
+
+#include "GaussianQuadrature.h"
+
+HBTK::QuadratureCache::QuadratureCache()
+	: m_hits(0),
+	m_misses(0),
+	m_remapped_count(0),
+	m_remapped_limit(default_remapped_limit)
+{
+}
+
+HBTK::QuadratureCache::~QuadratureCache()
+{
+}
+
+HBTK::QuadratureCache & HBTK::QuadratureCache::get_instance()
+{
+	static QuadratureCache instance;
+	return instance;
+}
+
+std::shared_ptr<const HBTK::StaticQuadrature> HBTK::QuadratureCache::get(
+	quadrature_family family, int num_points, double alpha, double beta)
+{
+	assert(num_points > 0);
+	key_type key = make_key(family, num_points, alpha, beta, no_remap, 0);
+	auto rule = find(key);
+	if (rule) { return rule; }
+	// Generate without holding the lock so that other lookups can continue.
+	return insert(key, std::make_shared<const StaticQuadrature>(
+		generate(family, num_points, std::get<2>(key), std::get<3>(key))));
+}
+
+std::shared_ptr<const HBTK::StaticQuadrature> HBTK::QuadratureCache::get_remapped(
+	quadrature_family family, int num_points, remap_type remap,
+	double singularity_position, double alpha, double beta)
+{
+	assert(num_points > 0);
+	if (remap == no_remap) { return get(family, num_points, alpha, beta); }
+	key_type key = make_key(family, num_points, alpha, beta, remap, singularity_position);
+	auto rule = find(key);
+	if (rule) { return rule; }
+	StaticQuadrature remapped = generate(family, num_points, std::get<2>(key), std::get<3>(key));
+	switch (remap) {
+	case telles_quadratic:
+		remapped.telles_quadratic_remap(singularity_position);
+		break;
+	case telles_cubic:
+		remapped.telles_cubic_remap(singularity_position);
+		break;
+	case sato4:
+		remapped.sato4_remap(singularity_position);
+		break;
+	case sato5:
+		remapped.sato5_remap(singularity_position);
+		break;
+	case doblare:
+		remapped.doblare_remap(singularity_position);
+		break;
+	default:
+		assert(false);
+	}
+	return insert(key, std::make_shared<const StaticQuadrature>(remapped));
+}
+
+long long HBTK::QuadratureCache::hits()
+{
+	return get_instance().m_hits.load();
+}
+
+long long HBTK::QuadratureCache::misses()
+{
+	return get_instance().m_misses.load();
+}
+
+int HBTK::QuadratureCache::size()
+{
+	auto& inst = get_instance();
+	std::shared_lock<std::shared_timed_mutex> lock(inst.m_mutex);
+	return (int)inst.m_rules.size();
+}
+
+void HBTK::QuadratureCache::clear()
+{
+	auto& inst = get_instance();
+	std::unique_lock<std::shared_timed_mutex> lock(inst.m_mutex);
+	inst.m_rules.clear();
+	inst.m_remapped_count = 0;
+	inst.m_hits = 0;
+	inst.m_misses = 0;
+}
+
+int HBTK::QuadratureCache::remapped_size()
+{
+	auto& inst = get_instance();
+	std::shared_lock<std::shared_timed_mutex> lock(inst.m_mutex);
+	return inst.m_remapped_count;
+}
+
+void HBTK::QuadratureCache::set_remapped_limit(int max_remapped_rules)
+{
+	assert(max_remapped_rules > 0);
+	auto& inst = get_instance();
+	std::unique_lock<std::shared_timed_mutex> lock(inst.m_mutex);
+	inst.m_remapped_limit = max_remapped_rules;
+	if (inst.m_remapped_count > max_remapped_rules) { inst.evict_remapped(); }
+}
+
+HBTK::QuadratureCache::key_type HBTK::QuadratureCache::make_key(
+	quadrature_family family, int num_points, double alpha, double beta,
+	remap_type remap, double singularity_position)
+{
+	// Normalise parameters that the family doesn't use so that they
+	// don't create duplicate entries.
+	switch (family) {
+	case gauss_gegenbauer:
+	case gauss_generalised_laguerre:
+		beta = 0;
+		break;
+	case gauss_jacobi:
+		break;
+	default:
+		alpha = beta = 0;
+	}
+	if (remap == no_remap) { singularity_position = 0; }
+	return key_type(family, num_points, alpha, beta, remap, singularity_position);
+}
+
+std::shared_ptr<const HBTK::StaticQuadrature> HBTK::QuadratureCache::find(const key_type & key)
+{
+	auto& inst = get_instance();
+	std::shared_lock<std::shared_timed_mutex> lock(inst.m_mutex);
+	auto iter = inst.m_rules.find(key);
+	if (iter != inst.m_rules.end()) {
+		inst.m_hits++;
+		return iter->second;
+	}
+	inst.m_misses++;
+	return nullptr;
+}
+
+std::shared_ptr<const HBTK::StaticQuadrature> HBTK::QuadratureCache::insert(
+	const key_type & key, std::shared_ptr<const StaticQuadrature> rule)
+{
+	auto& inst = get_instance();
+	std::unique_lock<std::shared_timed_mutex> lock(inst.m_mutex);
+	const bool remapped = std::get<4>(key) != no_remap;
+	if (remapped && inst.m_remapped_count >= inst.m_remapped_limit 
+		&& inst.m_rules.count(key) == 0) {
+		inst.evict_remapped();
+	}
+	// If another thread got here first, use its rule.
+	auto inserted = inst.m_rules.emplace(key, rule);
+	if (remapped && inserted.second) { inst.m_remapped_count++; }
+	return inserted.first->second;
+}
+
+void HBTK::QuadratureCache::evict_remapped()
+{
+	// Caller holds a unique lock on m_mutex.
+	for (auto iter = m_rules.begin(); iter != m_rules.end();) {
+		if (std::get<4>(iter->first) != no_remap) { iter = m_rules.erase(iter); }
+		else { ++iter; }
+	}
+	m_remapped_count = 0;
+}
+
+HBTK::StaticQuadrature HBTK::QuadratureCache::generate(quadrature_family family,
+	int num_points, double alpha, double beta)
+{
+	switch (family) {
+	case gauss_legendre:
+		return HBTK::gauss_legendre(num_points);
+	case gauss_laguerre:
+		return HBTK::gauss_laguerre(num_points);
+	case gauss_hermite:
+		return HBTK::gauss_hermite(num_points);
+	case gauss_chebyshev1:
+		return HBTK::gauss_chebyshev1(num_points);
+	case gauss_chebyshev2:
+		return HBTK::gauss_chebyshev2(num_points);
+	case gauss_gegenbauer:
+		return HBTK::gauss_gegenbauer(num_points, alpha);
+	case gauss_generalised_laguerre:
+		return HBTK::gauss_generalised_laguerre(num_points, alpha);
+	case gauss_jacobi:
+		return HBTK::gauss_jacobi(num_points, alpha, beta);
+	default:
+		assert(false);
+		return HBTK::gauss_legendre(num_points);
+	}
+}
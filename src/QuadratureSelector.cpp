@@ -0,0 +1,318 @@
+#include "QuadratureSelector.h"
+/*////////////////////////////////////////////////////////////////////////////
+QuadratureSelector.cpp
+
+Pick a remap and point count for integrands with a nearby singularity.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "GaussianQuadrature.h"
+
+namespace {
+	// Candidate remaps, cheapest first so that they win ties.
+	const std::vector<HBTK::QuadratureCache::remap_type> & candidate_remaps()
+	{
+		typedef HBTK::QuadratureCache qc;
+		static const std::vector<qc::remap_type> remaps = { qc::no_remap, 
+			qc::telles_quadratic, qc::telles_cubic, qc::sato4, qc::sato5, qc::doblare };
+		return remaps;
+	}
+
+	// Whether a remap can be centred on a singularity at |s| = abs_position.
+	bool remap_applies(HBTK::QuadratureCache::remap_type remap, double abs_position)
+	{
+		typedef HBTK::QuadratureCache qc;
+		switch (remap) {
+		case qc::telles_quadratic:
+		case qc::sato4:
+		case qc::sato5:
+			return abs_position == 1;
+		case qc::doblare:
+			return abs_position < 1;
+		default:
+			return true;
+		}
+	}
+
+	// Calibration samples per cell edge, so each cell is sampled at 
+	// (samples_per_cell + 1)^2 points including its corners.
+	const int samples_per_cell = 6;
+
+	// Integral of log(sqrt(u^2 + h^2)) du.
+	double log_kernel_antiderivative(double u, double h)
+	{
+		if (h == 0) { return (u == 0 ? 0 : u * log(std::abs(u)) - u); }
+		return 0.5 * u * log(u * u + h * h) - u + h * atan(u / h);
+	}
+}
+
+std::shared_ptr<const HBTK::StaticQuadrature> HBTK::QuadratureSelection::quadrature() const
+{
+	return QuadratureCache::get_remapped(QuadratureCache::gauss_legendre,
+		num_points, remap, singularity_position);
+}
+
+HBTK::QuadratureSelector::QuadratureSelector()
+{
+	calibrate();
+}
+
+HBTK::QuadratureSelector::~QuadratureSelector()
+{
+}
+
+HBTK::QuadratureSelector & HBTK::QuadratureSelector::get_instance()
+{
+	static QuadratureSelector instance;
+	return instance;
+}
+
+/// \param singularity_position position of the singular point along the 
+/// element in local coordinates. May lie outside [-1, 1].
+/// \param distance distance of the singular point from the line of the 
+/// element, in element half-lengths. Must be non-negative.
+/// \param tolerance required relative error.
+///
+/// \brief Choose a remap and point count for an element integral.
+///
+/// If the singularity projects outside of the element, the problem is 
+/// treated as a singularity over the nearest end of the element, at the
+/// true distance from that end.
+HBTK::QuadratureSelection HBTK::QuadratureSelector::select(
+	double singularity_position, double distance, double tolerance)
+{
+	assert(distance >= 0);
+	assert(tolerance > 0);
+	auto & inst = get_instance();
+	double s = singularity_position;
+	double h = distance;
+	if (std::abs(s) > 1) {
+		double overhang = std::abs(s) - 1;
+		h = sqrt(h * h + overhang * overhang);
+		s = (s > 0 ? 1. : -1.);
+	}
+	const double abs_s = std::abs(s);
+	const auto & positions = calibrated_positions();
+	const auto & distances = calibrated_distances();
+	const int n_p = (int)positions.size(), n_d = (int)distances.size();
+	int p_cell = n_p - 1;
+	if (abs_s < 1) {
+		p_cell = (int)(std::upper_bound(positions.begin(), positions.end(), abs_s)
+			- positions.begin()) - 1;
+	}
+	int d_cell = 0;
+	if (h > 0) {
+		d_cell = (int)(std::upper_bound(distances.begin(), distances.end(), h)
+			- distances.begin()) - 1;
+		d_cell = std::min(std::max(d_cell, 1), n_d - 2);
+	}
+	const auto & remaps = candidate_remaps();
+	const auto & counts = candidate_point_counts();
+
+	// The fewest points that meet the tolerance, or failing that, the 
+	// most accurate.
+	int best_r = -1, best_n = -1;
+	double best_error = std::numeric_limits<double>::infinity();
+	for (int n_idx = 0; n_idx < (int)counts.size() && best_error > tolerance; n_idx++) {
+		for (int r_idx = 0; r_idx < (int)remaps.size(); r_idx++) {
+			const double error = inst.m_errors[table_index(p_cell, d_cell, r_idx, n_idx)];
+			if (best_n < 0 || error < best_error) {
+				best_r = r_idx; best_n = n_idx; best_error = error;
+			}
+			if (error <= tolerance) { break; }
+		}
+	}
+
+	QuadratureSelection selection;
+	selection.remap = remaps[best_r];
+	selection.num_points = counts[best_n];
+	selection.singularity_position = (selection.remap == QuadratureCache::no_remap ? 0 : s);
+	selection.expected_error = best_error;
+	// Between zero and the first non-zero distance the 1/r and h/r^2 
+	// integrands get ever harder, so no error can be promised.
+	selection.meets_tolerance = selection.expected_error <= tolerance
+		&& (h == 0 || h >= distances[1]);
+	return selection;
+}
+
+/// \param remap the remap to apply to the Gauss-Legendre rule.
+/// \param num_points the number of points in the rule.
+/// \param singularity_position local coordinate of the singular point 
+/// within [-1, 1]. Must be valid for the remap.
+/// \param distance distance of the singular point from the element, in 
+/// element half-lengths. 0 <= distance < 3.
+///
+/// \brief The worst relative error of the calibration integrands.
+double HBTK::QuadratureSelector::benchmark_error(
+	QuadratureCache::remap_type remap, int num_points, 
+	double singularity_position, double distance)
+{
+	assert(num_points > 0);
+	return benchmark_error(remap, gauss_legendre(num_points), singularity_position, distance);
+}
+
+double HBTK::QuadratureSelector::benchmark_error(
+	QuadratureCache::remap_type remap, const StaticQuadrature & base_rule,
+	double singularity_position, double distance)
+{
+	assert(std::abs(singularity_position) <= 1);
+	assert(distance >= 0 && distance < 3);
+	const double s = singularity_position, h = distance;
+	const int num_points = base_rule.num_points();
+	// Rules are made locally rather than taken from the QuadratureCache so
+	// that calibration has no side effects on it.
+	StaticQuadrature quad = base_rule;
+	switch (remap) {
+	case QuadratureCache::no_remap:
+		break;
+	case QuadratureCache::telles_quadratic:
+		quad.telles_quadratic_remap(s);
+		break;
+	case QuadratureCache::telles_cubic:
+		quad.telles_cubic_remap(s);
+		break;
+	case QuadratureCache::sato4:
+		quad.sato4_remap(s);
+		break;
+	case QuadratureCache::sato5:
+		quad.sato5_remap(s);
+		break;
+	case QuadratureCache::doblare:
+		quad.doblare_remap(s);
+		break;
+	}
+	auto points_and_weights = quad.get_quadrature();
+	const auto & points = points_and_weights.first;
+	const auto & weights = points_and_weights.second;
+
+	// log(r / 4) is negative over the whole element for h < 3, so its 
+	// relative error is well defined.
+	double log_sum = 0, inverse_sum = 0, cauchy_sum = 0;
+	for (int i = 0; i < num_points; i++) {
+		const double u = points[i] - s;
+		const double r2 = u * u + h * h;
+		if (r2 == 0) { continue; }	// Zero Jacobian at the singularity.
+		log_sum += weights[i] * (0.5 * log(r2) - log(4.));
+		if (h > 0) {
+			inverse_sum += weights[i] / sqrt(r2);
+			cauchy_sum += weights[i] * h / r2;
+		}
+	}
+	const double a = -1 - s, b = 1 - s;
+	const double log_exact = log_kernel_antiderivative(b, h) 
+		- log_kernel_antiderivative(a, h) - 2 * log(4.);
+	double error = std::abs((log_sum - log_exact) / log_exact);
+	if (h > 0) {
+		const double inverse_exact = asinh(b / h) - asinh(a / h);
+		const double cauchy_exact = atan(b / h) - atan(a / h);
+		error = std::max(error, std::abs((inverse_sum - inverse_exact) / inverse_exact));
+		error = std::max(error, std::abs((cauchy_sum - cauchy_exact) / cauchy_exact));
+	}
+	return (std::isfinite(error) ? error : std::numeric_limits<double>::infinity());
+}
+
+const std::vector<int>& HBTK::QuadratureSelector::candidate_point_counts()
+{
+	static const std::vector<int> counts = { 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 
+		14, 16, 20, 24, 28, 32, 40, 48, 56, 64, 96, 128 };
+	return counts;
+}
+
+const std::vector<double>& HBTK::QuadratureSelector::calibrated_positions()
+{
+	static const std::vector<double> positions = { 0, 0.1, 0.2, 0.3, 0.4, 0.5, 
+		0.6, 0.7, 0.75, 0.8, 0.85, 0.9, 0.94, 0.97, 0.99, 0.995, 0.999, 1 };
+	return positions;
+}
+
+const std::vector<double>& HBTK::QuadratureSelector::calibrated_distances()
+{
+	static const std::vector<double> distances = { 0, 1e-6, 3e-6, 1e-5, 3e-5, 
+		1e-4, 3e-4, 1e-3, 3e-3, 1e-2, 3e-2, 0.1, 0.3, 1, 2.5, 2.9 };
+	return distances;
+}
+
+void HBTK::QuadratureSelector::calibrate()
+{
+	// Position cell j < n_p - 1 covers positions[j] <= |s| <= positions[j + 1], 
+	// and cell n_p - 1 is |s| == 1 only. Distance cell 0 is h == 0 only, and
+	// cell k > 0 covers distances[k] <= h <= distances[k + 1].
+	const auto & counts = candidate_point_counts();
+	const auto & positions = calibrated_positions();
+	const auto & distances = calibrated_distances();
+	const auto & remaps = candidate_remaps();
+	const int n_p = (int)positions.size(), n_d = (int)distances.size();
+	m_errors.resize(n_p * (n_d - 1) * remaps.size() * counts.size());
+	std::vector<StaticQuadrature> base_rules;
+	for (int n : counts) { base_rules.push_back(gauss_legendre(n)); }
+
+	for (int p_cell = 0; p_cell < n_p; p_cell++) {
+		std::vector<double> cell_positions;
+		if (p_cell == n_p - 1) { cell_positions.push_back(1); }
+		else {
+			for (int i = 0; i <= samples_per_cell; i++) {
+				cell_positions.push_back(positions[p_cell] 
+					+ (positions[p_cell + 1] - positions[p_cell]) * i / samples_per_cell);
+			}
+		}
+		for (int d_cell = 0; d_cell < n_d - 1; d_cell++) {
+			std::vector<double> cell_distances;
+			if (d_cell == 0) { cell_distances.push_back(0); }
+			else {
+				for (int i = 0; i <= samples_per_cell; i++) {
+					cell_distances.push_back(distances[d_cell] * pow(
+						distances[d_cell + 1] / distances[d_cell], (double)i / samples_per_cell));
+				}
+			}
+			for (int r_idx = 0; r_idx < (int)remaps.size(); r_idx++) {
+				for (int n_idx = 0; n_idx < (int)counts.size(); n_idx++) {
+					double & error = m_errors[table_index(p_cell, d_cell, r_idx, n_idx)];
+					error = remap_applies(remaps[r_idx], cell_positions[0]) ? 0 
+						: std::numeric_limits<double>::infinity();
+					for (double s : cell_positions) {
+						// Only the doblare remap's samples at the end are skipped.
+						if (!remap_applies(remaps[r_idx], s)) { continue; }
+						for (double h : cell_distances) {
+							error = std::max(error, benchmark_error(
+								remaps[r_idx], base_rules[n_idx], s, h));
+						}
+					}
+				}
+			}
+		}
+	}
+	return;
+}
+
+int HBTK::QuadratureSelector::table_index(int position_cell, int distance_cell, 
+	int remap_idx, int count_idx)
+{
+	const int n_d = (int)calibrated_distances().size() - 1;
+	const int n_r = (int)candidate_remaps().size();
+	const int n_n = (int)candidate_point_counts().size();
+	return ((position_cell * n_d + distance_cell) * n_r + remap_idx) * n_n + count_idx;
+}
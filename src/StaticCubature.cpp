@@ -0,0 +1,236 @@
+#include "StaticCubature.h"
+/*////////////////////////////////////////////////////////////////////////////
+StaticCubature.cpp
+
+Integration over quadrangle, triangle, hexahedron and tetrahedron elements
+using fixed multi-dimensional rules.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <cmath>
+#include <map>
+
+#include "GaussianQuadrature.h"
+#include "GaussLegendre.h"
+
+HBTK::StaticCubature::StaticCubature(int dimensions, const std::vector<double>& points, 
+	const std::vector<double>& weights)
+	: m_dimensions(dimensions),
+	m_points(points),
+	m_weights(weights)
+{
+	assert(dimensions > 0);
+	assert(points.size() == weights.size() * dimensions);
+}
+
+HBTK::StaticCubature::~StaticCubature()
+{
+}
+
+const std::vector<double>& HBTK::StaticCubature::points() const
+{
+	return m_points;
+}
+
+const std::vector<double>& HBTK::StaticCubature::weights() const
+{
+	return m_weights;
+}
+
+int HBTK::StaticCubature::dimensions() const
+{
+	return m_dimensions;
+}
+
+int HBTK::StaticCubature::num_points() const
+{
+	return (int)m_weights.size();
+}
+
+/// \param rule a one dimensional rule
+/// \param dimensions number of dimensions of the resulting cubature
+///
+/// \brief The tensor product of a rule with itself.
+///
+/// The rule's own bounds are kept, so a rule on [-1, 1] gives a cubature
+/// on [-1, 1]^dimensions. The first coordinate varies fastest.
+HBTK::StaticCubature HBTK::tensor_product_cubature(const StaticQuadrature & rule, int dimensions)
+{
+	assert(dimensions > 0);
+	auto quad = rule.get_quadrature();
+	const int n = rule.num_points();
+	int total = 1;
+	for (int d = 0; d < dimensions; d++) { total *= n; }
+
+	std::vector<double> points(total * dimensions), weights(total);
+	for (int i = 0; i < total; i++) {
+		int remainder = i;
+		double weight = 1;
+		for (int d = 0; d < dimensions; d++) {
+			int idx = remainder % n;
+			remainder /= n;
+			points[i * dimensions + d] = quad.first[idx];
+			weight *= quad.second[idx];
+		}
+		weights[i] = weight;
+	}
+	return StaticCubature(dimensions, points, weights);
+}
+
+/// \param element the element to integrate over.
+/// \param num_points number of points in each direction.
+///
+/// \brief Gauss cubature for an element from ElementGoemetry.h.
+///
+/// Simplices use the collapsed (Duffy) coordinates of the square or cube.
+/// For a triangle
+/// \f[ x = (1+\xi)(1-\eta)/4, \quad y = (1+\eta)/2 \f]
+/// with Jacobian \f$(1-\eta)/8\f$. The \f$(1-\eta)\f$ factor is the 
+/// weight of a Gauss-Jacobi rule, so no accuracy is lost to the collapse.
+/// Tetrahedra similarly use Gauss-Jacobi rules with \f$(1-\eta)\f$ and 
+/// \f$(1-\zeta)^2\f$ weights.
+HBTK::StaticCubature HBTK::gauss_legendre_cubature(
+	StaticCubature::element_type element, int num_points)
+{
+	assert(num_points > 0);
+	switch (element) {
+	case StaticCubature::quadrangle:
+		return tensor_product_cubature(gauss_legendre(num_points), 2);
+	case StaticCubature::hexahedron:
+		return tensor_product_cubature(gauss_legendre(num_points), 3);
+	case StaticCubature::triangle:
+	{
+		auto xi = gauss_legendre(num_points).get_quadrature();
+		auto eta = gauss_jacobi(num_points, 1, 0).get_quadrature();
+		std::vector<double> points, weights;
+		points.reserve(2 * num_points * num_points);
+		weights.reserve(num_points * num_points);
+		for (int j = 0; j < num_points; j++) {
+			for (int i = 0; i < num_points; i++) {
+				points.push_back((1 + xi.first[i]) * (1 - eta.first[j]) / 4);
+				points.push_back((1 + eta.first[j]) / 2);
+				weights.push_back(xi.second[i] * eta.second[j] / 8);
+			}
+		}
+		return StaticCubature(2, points, weights);
+	}
+	case StaticCubature::tetrahedron:
+	{
+		auto xi = gauss_legendre(num_points).get_quadrature();
+		auto eta = gauss_jacobi(num_points, 1, 0).get_quadrature();
+		auto zeta = gauss_jacobi(num_points, 2, 0).get_quadrature();
+		std::vector<double> points, weights;
+		points.reserve(3 * num_points * num_points * num_points);
+		weights.reserve(num_points * num_points * num_points);
+		for (int k = 0; k < num_points; k++) {
+			for (int j = 0; j < num_points; j++) {
+				for (int i = 0; i < num_points; i++) {
+					points.push_back((1 + xi.first[i]) * (1 - eta.first[j]) 
+						* (1 - zeta.first[k]) / 8);
+					points.push_back((1 + eta.first[j]) * (1 - zeta.first[k]) / 4);
+					points.push_back((1 + zeta.first[k]) / 2);
+					weights.push_back(xi.second[i] * eta.second[j] * zeta.second[k] / 64);
+				}
+			}
+		}
+		return StaticCubature(3, points, weights);
+	}
+	default:
+		assert(false);
+		return tensor_product_cubature(gauss_legendre(num_points), 2);
+	}
+}
+
+/// \param dimensions number of dimensions
+/// \param level level of the sparse grid. Level 0 is the one point rule.
+///
+/// \brief Smolyak sparse grid cubature on [-1, 1]^dimensions.
+///
+/// Uses the combination technique: with \f$q = level + dimensions\f$,
+/// \f[ A(q, d) = \sum_{q-d+1 \le |i| \le q} (-1)^{q-|i|} 
+///		\binom{d-1}{q-|i|} Q_{i_1} \otimes \dots \otimes Q_{i_d} \f]
+/// where \f$Q_i\f$ is the Gauss-Legendre rule of i points. Coincident
+/// points of the tensor products are merged.
+HBTK::StaticCubature HBTK::smolyak_cubature(int dimensions, int level)
+{
+	assert(dimensions > 0);
+	assert(level >= 0);
+	const int q = level + dimensions;
+
+	std::vector<std::pair<std::vector<double>, std::vector<double>>> rules(level + 2);
+	for (int i = 1; i <= level + 1; i++) {
+		rules[i] = gauss_legendre(i).get_quadrature();
+		for (auto & x : rules[i].first) {
+			if (std::abs(x) < 1e-14) { x = 0; }
+		}
+	}
+	auto binomial = [](int n, int k) {
+		double result = 1;
+		for (int i = 1; i <= k; i++) { result = result * (n - k + i) / i; }
+		return result;
+	};
+
+	std::map<std::vector<double>, double> merged;
+	std::vector<int> index(dimensions, 1);
+	// Visit every multi-index with entries >= 1 and q-d+1 <= |index| <= q.
+	while (true) {
+		int norm = 0;
+		for (int i : index) { norm += i; }
+		if (norm >= q - dimensions + 1 && norm <= q) {
+			double coefficient = ((q - norm) % 2 ? -1. : 1.) 
+				* binomial(dimensions - 1, q - norm);
+			std::vector<int> sub(dimensions, 0);
+			std::vector<double> point(dimensions);
+			while (true) {
+				double weight = coefficient;
+				for (int d = 0; d < dimensions; d++) {
+					point[d] = rules[index[d]].first[sub[d]];
+					weight *= rules[index[d]].second[sub[d]];
+				}
+				merged[point] += weight;
+				int d = 0;
+				while (d < dimensions && ++sub[d] == (int)rules[index[d]].first.size()) {
+					sub[d++] = 0;
+				}
+				if (d == dimensions) { break; }
+			}
+		}
+		int d = 0;
+		while (d < dimensions) {
+			index[d]++;
+			int sum = 0;
+			for (int i : index) { sum += i; }
+			if (sum <= q) { break; }
+			index[d++] = 1;
+		}
+		if (d == dimensions) { break; }
+	}
+
+	std::vector<double> points, weights;
+	for (auto & node : merged) {
+		if (node.second == 0) { continue; }
+		points.insert(points.end(), node.first.begin(), node.first.end());
+		weights.push_back(node.second);
+	}
+	return StaticCubature(dimensions, points, weights);
+}
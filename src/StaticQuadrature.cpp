@@ -102,11 +102,8 @@ void HBTK::StaticQuadrature::linear_remap(double new_lower_bound, double new_upp
 {
 	assert(HBTK::check_finite(new_lower_bound));
 	assert(HBTK::check_finite(new_upper_bound));
-	int size = (int)m_points.size();
-	for (int i = 0; i < size; i++) {
-		HBTK::linear_remap(m_points[i], m_weights[i], m_lower_bound, m_upper_bound,
-			new_lower_bound, new_upper_bound);
-	}
+	HBTK::linear_remap_batch(m_points.data(), m_weights.data(), num_points(),
+		m_lower_bound, m_upper_bound, new_lower_bound, new_upper_bound);
 	m_upper_bound = new_upper_bound;
 	m_lower_bound = new_lower_bound;
 	return;
@@ -147,10 +144,8 @@ void HBTK::StaticQuadrature::telles_quadratic_remap(double singularity_position)
 	m_original_lower = m_lower_bound;
 	remaped_sing_pos = (singularity_position == m_lower_bound ? -1 : 1);
 	linear_remap(-1, 1);
-	int size = num_points();
-	for (int i = 0; i < size; i++) {
-		HBTK::telles_quadratic_remap(m_points[i], m_weights[i], remaped_sing_pos);
-	}
+	HBTK::telles_quadratic_remap_batch(m_points.data(), m_weights.data(), 
+		num_points(), remaped_sing_pos);
 	linear_remap(m_original_lower, m_original_upper);
 	assert(HBTK::check_finite(m_points));
 	assert(HBTK::check_finite(m_weights));
@@ -163,24 +158,20 @@ void HBTK::StaticQuadrature::telles_quadratic_remap(double singularity_position)
 /// point / weight
 ///
 /// Telles' cubic remap increases the accuracy of quadratures when there  
-/// is a singularity.
-/// The inverval of integration must be mapped to [-1, 1]. 
-/// The input point and weight are modified.
+/// is a singularity anywhere in the interval of integration.
 void HBTK::StaticQuadrature::telles_cubic_remap(double singularity_position)
 {
 	assert(HBTK::check_finite(m_lower_bound));
 	assert(HBTK::check_finite(m_upper_bound));
-	assert((singularity_position == m_lower_bound) || (singularity_position == m_upper_bound));
+	assert((singularity_position >= m_lower_bound) && (singularity_position <= m_upper_bound));
 	double m_original_upper, m_original_lower;
 	m_original_upper = m_upper_bound;
 	m_original_lower = m_lower_bound;
-	double dummy_weight;
+	double dummy_weight = 1;
 	HBTK::linear_remap(singularity_position, dummy_weight, m_lower_bound, m_upper_bound, -1., 1.);
 	linear_remap(-1, 1);
-	int size = num_points();
-	for (int i = 0; i < size; i++) {
-		HBTK::telles_cubic_remap(m_points[i], m_weights[i], singularity_position);
-	}
+	HBTK::telles_cubic_remap_batch(m_points.data(), m_weights.data(), 
+		num_points(), singularity_position);
 	linear_remap(m_original_lower, m_original_upper);
 	assert(HBTK::check_finite(m_points));
 	assert(HBTK::check_finite(m_weights));
@@ -203,10 +194,8 @@ void HBTK::StaticQuadrature::sato4_remap(double singularity_position)
 	m_original_lower = m_lower_bound;
 	remaped_sing_pos = (singularity_position == m_lower_bound ? -1 : 1);
 	linear_remap(-1, 1);
-	int size = num_points();
-	for (int i = 0; i < size; i++) {
-		HBTK::sato_remap<4, double>(m_points[i], m_weights[i], remaped_sing_pos);
-	}
+	HBTK::sato_remap_batch<4, double>(m_points.data(), m_weights.data(), 
+		num_points(), remaped_sing_pos);
 	linear_remap(m_original_lower, m_original_upper);
 	assert(HBTK::check_finite(m_points));
 	assert(HBTK::check_finite(m_weights));
@@ -231,10 +220,36 @@ void HBTK::StaticQuadrature::sato5_remap(double singularity_position)
 	m_original_lower = m_lower_bound;
 	remaped_sing_pos = (singularity_position == m_lower_bound ? -1 : 1);
 	linear_remap(-1, 1);
-	int size = num_points();
-	for (int i = 0; i < size; i++) {
-		HBTK::sato_remap<5, double>(m_points[i], m_weights[i], remaped_sing_pos);
-	}
+	HBTK::sato_remap_batch<5, double>(m_points.data(), m_weights.data(), 
+		num_points(), remaped_sing_pos);
+	linear_remap(m_original_lower, m_original_upper);
+	assert(HBTK::check_finite(m_points));
+	assert(HBTK::check_finite(m_weights));
+	return;
+}
+
+/// \param singularity_pos the position of the singularity, strictly within
+/// the interval of integration.
+///
+/// \brief Applies Doblare's transform to a quadrature to adapt for a
+/// singularity inside the interval.
+///
+/// The Jacobian of the transform is zero at the singularity. The weights 
+/// remain positive only whilst the singularity is within the middle 3/4 of 
+/// the interval.
+void HBTK::StaticQuadrature::doblare_remap(double singularity_position)
+{
+	assert(HBTK::check_finite(m_lower_bound));
+	assert(HBTK::check_finite(m_upper_bound));
+	assert((singularity_position > m_lower_bound) && (singularity_position < m_upper_bound));
+	double m_original_upper, m_original_lower;
+	m_original_upper = m_upper_bound;
+	m_original_lower = m_lower_bound;
+	double dummy_weight = 1;
+	HBTK::linear_remap(singularity_position, dummy_weight, m_lower_bound, m_upper_bound, -1., 1.);
+	linear_remap(-1, 1);
+	HBTK::doblare_remap_batch(m_points.data(), m_weights.data(),
+		num_points(), singularity_position);
 	linear_remap(m_original_lower, m_original_upper);
 	assert(HBTK::check_finite(m_points));
 	assert(HBTK::check_finite(m_weights));
@@ -0,0 +1,122 @@
+#include <HBTK/CartesianPointCloud.h>
+#include <HBTK/Constants.h>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Point cloud 3D") {
+
+	std::vector<HBTK::CartesianPoint3D> points = {
+		HBTK::CartesianPoint3D({ 1, 2, 3 }),
+		HBTK::CartesianPoint3D({ -1, 0, 4 }),
+		HBTK::CartesianPoint3D({ 2, -5, 0.5 }) };
+
+	SECTION("Conversion to and from points") {
+		HBTK::PointCloud3D cloud(points);
+		REQUIRE(cloud.size() == 3);
+		REQUIRE(cloud[1] == points[1]);
+		REQUIRE(cloud.as_points() == points);
+		REQUIRE(cloud.y()[2] == -5);
+		cloud.push_back(HBTK::CartesianPoint3D::origin());
+		REQUIRE(cloud.size() == 4);
+		REQUIRE(cloud[3] == HBTK::CartesianPoint3D::origin());
+	}
+
+	SECTION("Translation and distance") {
+		HBTK::PointCloud3D cloud(points);
+		HBTK::CartesianVector3D delta({ 1, 1, -1 });
+		cloud.translate(delta);
+		auto distances = cloud.distance(HBTK::CartesianPoint3D({ 1, 1, 1 }));
+		for (int i = 0; i < 3; i++) {
+			REQUIRE(cloud[i] == points[i] + delta);
+			REQUIRE(distances[i] == Approx(((points[i] + delta) - HBTK::CartesianPoint3D({ 1, 1, 1 })).magnitude()));
+		}
+	}
+
+	SECTION("Rotation") {
+		HBTK::PointCloud3D cloud(points);
+		cloud.rotate(HBTK::CartesianVector3D({ 0, 0, 2 }), HBTK::Constants::pi() / 2);
+		REQUIRE(cloud[0].x() == Approx(-2));
+		REQUIRE(cloud[0].y() == Approx(1));
+		REQUIRE(cloud[0].z() == Approx(3));
+		HBTK::PointCloud3D about(points);
+		about.rotate(HBTK::CartesianVector3D({ 1, 0, 0 }), HBTK::Constants::pi(), points[0]);
+		REQUIRE(about[0].x() == Approx(1));
+		REQUIRE(about[0].y() == Approx(2));
+		REQUIRE(about[0].z() == Approx(3));
+		REQUIRE(about[1].y() == Approx(4));
+		REQUIRE(about[1].z() == Approx(2));
+	}
+
+	SECTION("Bounding box") {
+		HBTK::PointCloud3D cloud(points);
+		auto box = cloud.bounding_box();
+		REQUIRE(box.first == HBTK::CartesianPoint3D({ -1, -5, 0.5 }));
+		REQUIRE(box.second == HBTK::CartesianPoint3D({ 2, 2, 4 }));
+	}
+
+	SECTION("Differences make vector fields") {
+		HBTK::PointCloud3D cloud(points);
+		auto from_origin = cloud - HBTK::CartesianPoint3D::origin();
+		REQUIRE(from_origin[2] == points[2] - HBTK::CartesianPoint3D::origin());
+		auto zero = cloud - cloud;
+		REQUIRE(zero == HBTK::VectorField3D(3));
+	}
+}
+
+TEST_CASE("Vector field 3D") {
+
+	std::vector<HBTK::CartesianVector3D> a = {
+		HBTK::CartesianVector3D({ 1, 2, 3 }),
+		HBTK::CartesianVector3D({ 0, 0, 4 }),
+		HBTK::CartesianVector3D({ 2, -5, 0.5 }) };
+	std::vector<HBTK::CartesianVector3D> b = {
+		HBTK::CartesianVector3D({ -3, 1, 2 }),
+		HBTK::CartesianVector3D({ 1, 0, 0 }),
+		HBTK::CartesianVector3D({ 7, 1, -2 }) };
+
+	SECTION("Arithmetic matches CartesianVector3D") {
+		HBTK::VectorField3D fa(a), fb(b);
+		auto sum = fa + fb;
+		auto diff = fa - fb;
+		auto scaled = fa * 2.5;
+		for (int i = 0; i < 3; i++) {
+			REQUIRE(sum[i] == a[i] + b[i]);
+			REQUIRE(diff[i] == a[i] - b[i]);
+			REQUIRE(scaled[i] == a[i] * 2.5);
+		}
+		fa += fb;
+		REQUIRE(fa == sum);
+		fa -= fb;
+		REQUIRE(fa.as_vectors() == a);
+	}
+
+	SECTION("Dot, cross and magnitude") {
+		HBTK::VectorField3D fa(a), fb(b);
+		auto dots = fa.dot(fb);
+		auto crosses = fa.cross(fb);
+		auto single_cross = fa.cross(b[0]);
+		auto single_dot = fa.dot(b[0]);
+		auto lengths = fa.magnitude();
+		for (int i = 0; i < 3; i++) {
+			REQUIRE(dots[i] == Approx(a[i].dot(b[i])));
+			REQUIRE(crosses[i] == a[i].cross(b[i]));
+			REQUIRE(single_cross[i] == a[i].cross(b[0]));
+			REQUIRE(single_dot[i] == Approx(a[i].dot(b[0])));
+			REQUIRE(lengths[i] == Approx(a[i].magnitude()));
+		}
+		fa.normalise();
+		for (double length : fa.magnitude()) { REQUIRE(length == Approx(1)); }
+	}
+
+	SECTION("Rotation and sum") {
+		HBTK::VectorField3D fa(a);
+		fa.rotate(HBTK::CartesianVector3D({ 0, 1, 0 }), HBTK::Constants::pi() / 2);
+		REQUIRE(fa[1].x() == Approx(4));
+		REQUIRE(fa[1].z() == Approx(0).margin(1e-14));
+		auto total = HBTK::VectorField3D(b).sum();
+		REQUIRE(total == HBTK::CartesianVector3D({ 5, 2, 0 }));
+	}
+}
@@ -7,6 +7,7 @@
 
 #include <cmath>
 #include <array>
+#include <type_traits>
 
 TEST_CASE("Cartesian Vector 2D") {
 
@@ -305,4 +306,18 @@ TEST_CASE("Cartesian Vector 3D") {
 		angle = vec1.angle(vec4);
 		REQUIRE(angle == Approx(acos(8. / sqrt(145.))));
 	}
-}
\ No newline at end of file
+}
+TEST_CASE("Cartesian Vector 3D compile time arithmetic") {
+	static_assert(std::is_trivially_copyable<HBTK::CartesianVector3D>::value,
+		"CartesianVector3D should be trivially copyable.");
+	static_assert(std::is_trivially_copyable<HBTK::CartesianPoint3D>::value,
+		"CartesianPoint3D should be trivially copyable.");
+	constexpr HBTK::CartesianVector3D a({ 1, 2, 3 }), b({ 4, 5, 6 });
+	constexpr HBTK::CartesianVector3D c = a.cross(b);
+	constexpr double d = a.dot(b) + (2. * a - b).dot(a);
+	constexpr HBTK::CartesianPoint3D p = HBTK::CartesianPoint3D::origin() + a;
+	static_assert(c == HBTK::CartesianVector3D({ -3, 6, -3 }), "Compile time cross product.");
+	static_assert(d == 32 - 4, "Compile time dot product.");
+	static_assert(p - HBTK::CartesianPoint3D::origin() == a, "Compile time point arithmetic.");
+	REQUIRE(c.x() == -3);
+}
@@ -1,5 +1,7 @@
 #include <HBTK/CubicSpline1D.h>
 
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 #include <catch2/catch.hpp>
@@ -100,4 +102,124 @@ TEST_CASE("Cubic spline 1D") {
 		REQUIRE(spline.derivative(1, 0) != 0);
 		REQUIRE(spline.derivative(2, 1) != 0);
 	}
+
+	SECTION("Batch evaluation matches scalar evaluation") {
+		std::vector<double> points({ 0, 0.5, 1.5, 2, 3.5, 4 });
+		std::vector<double> values({ 1, -1, 2, 0.5, 3, 2 });
+		HBTK::CubicSpline1D spline(points, values, 1, -2);
+		// Sorted, unsorted, repeated, on-knot and out of range locations.
+		std::vector<double> locations({ -1, 0, 0.1, 0.5, 0.7, 1.9, 2, 4, 5,
+			3.7, 0.2, 0.2, 1.5, -0.5, 2.5 });
+		std::vector<double> v, d1, d2, d3;
+		spline.evaluate(locations, v, d1, d2, d3);
+		std::vector<double> v_only = spline.evaluate(locations);
+		REQUIRE(v.size() == locations.size());
+		REQUIRE(d3.size() == locations.size());
+		REQUIRE(v_only.size() == locations.size());
+		for (size_t i = 0; i < locations.size(); i++) {
+			REQUIRE(v[i] == spline(locations[i]));
+			REQUIRE(v_only[i] == spline(locations[i]));
+			REQUIRE(d1[i] == spline.derivative(locations[i]));
+			REQUIRE(d2[i] == spline.derivative2(locations[i]));
+			REQUIRE(d3[i] == spline.derivative3(locations[i]));
+		}
+	}
+
+	SECTION("Compiled form matches uncompiled form") {
+		std::vector<double> uniform_points({ 0, 0.5, 1, 1.5, 2, 2.5 });
+		std::vector<double> nonuniform_points({ 0, 0.5, 1.5, 2, 3.5, 4 });
+		std::vector<double> values({ 1, -1, 2, 0.5, 3, 2 });
+		std::vector<double> locations({ -1, 0, 0.1, 0.5, 0.7, 1.9, 2, 4, 5,
+			3.7, 0.2, 0.2, 1.5, -0.5, 2.5 });
+		for (auto & points : { uniform_points, nonuniform_points }) {
+			HBTK::CubicSpline1D reference(points, values, 1, -2);
+			HBTK::CubicSpline1D spline(points, values, 1, -2);
+			REQUIRE_FALSE(spline.is_compiled());
+			spline.compile();
+			REQUIRE(spline.is_compiled());
+			HBTK::CubicSpline1D copy(spline);
+			REQUIRE(copy.is_compiled());
+			std::vector<double> v, d1, d2, d3;
+			spline.evaluate(locations, v, d1, d2, d3);
+			for (size_t i = 0; i < locations.size(); i++) {
+				double x = locations[i];
+				REQUIRE(spline(x) == Approx(reference(x)).margin(1e-12));
+				REQUIRE(copy(x) == Approx(reference(x)).margin(1e-12));
+				REQUIRE(spline.derivative(x) == Approx(reference.derivative(x)).margin(1e-12));
+				REQUIRE(spline.derivative2(x) == Approx(reference.derivative2(x)).margin(1e-12));
+				REQUIRE(spline.derivative3(x) == Approx(reference.derivative3(x)).margin(1e-12));
+				REQUIRE(v[i] == spline(x));
+				REQUIRE(d1[i] == spline.derivative(x));
+				REQUIRE(d2[i] == spline.derivative2(x));
+				REQUIRE(d3[i] == spline.derivative3(x));
+			}
+		}
+	}
+
+	SECTION("Compiling too few points throws") {
+		HBTK::CubicSpline1D empty;
+		REQUIRE_THROWS_AS(empty.compile(), std::domain_error);
+		HBTK::CubicSpline1D single(std::vector<double>({ 1 }), std::vector<double>({ 2 }));
+		REQUIRE_THROWS_AS(single.compile(), std::domain_error);
+		REQUIRE_FALSE(single.is_compiled());
+	}
+
+	SECTION("Move construction and assignment") {
+		std::vector<double> points({ 0, 1, 2, 3 });
+		std::vector<double> values({ 0, 1, 0, 1 });
+		const HBTK::CubicSpline1D reference(points, values);
+		HBTK::CubicSpline1D spline(points, values);
+		REQUIRE(spline(0.5) == reference(0.5));
+		HBTK::CubicSpline1D moved(std::move(spline));
+		REQUIRE(moved(0.5) == reference(0.5));
+		REQUIRE(moved(2.5) == reference(2.5));
+		HBTK::CubicSpline1D assigned;
+		assigned = std::move(moved);
+		REQUIRE(assigned(2.5) == reference(2.5));
+		HBTK::CubicSpline1D uncomputed(points, values);
+		HBTK::CubicSpline1D copy;
+		copy = uncomputed;
+		REQUIRE(copy(1.5) == reference(1.5));
+	}
+
+	SECTION("Concurrent first evaluation") {
+		std::vector<double> points({ 0, 0.5, 1.5, 2, 3.5, 4 });
+		std::vector<double> values({ 1, -1, 2, 0.5, 3, 2 });
+		const HBTK::CubicSpline1D reference(points, values);
+		double expected = reference(1.7);
+		for (int repeat = 0; repeat < 20; repeat++) {
+			const HBTK::CubicSpline1D shared(points, values);
+			std::vector<double> results(4);
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; t++) {
+				threads.emplace_back([&, t]() { results[t] = shared(1.7); });
+			}
+			for (auto & thread : threads) { thread.join(); }
+			for (double result : results) { REQUIRE(result == expected); }
+		}
+	}
+
+	SECTION("Construct many splines at once") {
+		std::vector<std::vector<double>> points, values;
+		std::vector<double> shared_points({ 0, 0.5, 1.5, 2, 3.5, 4 });
+		for (int i = 0; i < 150; i++) {
+			points.push_back({ 0, 0.5 + 0.001 * i, 1.5, 2, 3.5, 4 + 0.01 * i });
+			values.push_back({ 1. * i, -1, 2, 0.5 * i, 3, 2 });
+		}
+		auto many = HBTK::CubicSpline1D::construct_many(points, values);
+		auto many_threaded = HBTK::CubicSpline1D::construct_many(points, values, 3);
+		auto many_shared = HBTK::CubicSpline1D::construct_many(shared_points, values, 2);
+		REQUIRE(many.size() == 150);
+		REQUIRE(many_threaded.size() == 150);
+		REQUIRE(many_shared.size() == 150);
+		for (int i = 0; i < 150; i++) {
+			HBTK::CubicSpline1D reference(points[i], values[i]);
+			HBTK::CubicSpline1D shared_reference(shared_points, values[i]);
+			for (double x : { -0.5, 0.2, 1.0, 2.7, 3.9, 5.0 }) {
+				REQUIRE(many[i](x) == Approx(reference(x)));
+				REQUIRE(many_threaded[i].derivative2(x) == Approx(reference.derivative2(x)));
+				REQUIRE(many_shared[i](x) == Approx(shared_reference(x)));
+			}
+		}
+	}
 }
@@ -50,4 +50,42 @@ TEST_CASE("Cubic spline ND") {
 		REQUIRE(spline(-2) == std::array<double, 2>{2., -1.});
 		REQUIRE(spline(4) == std::array<double, 2>{2., 5.});
 	}
+
+	SECTION("Fused evaluation matches component splines") {
+		std::array<std::vector<double>, 3> points = { { 
+			{{ 0., 1., 3., 2., 0. }}, {{ 1., -1., 0., 2., 1. }}, {{ 0., 0.5, 0., 0.5, 0. }} } };
+		HBTK::CubicSplineND<3> spline(points);
+		std::vector<double> positions({ -1.5, -1, -0.7, -0.2, 0, 0.3, 0.3, 0.9, 1, 2, -0.6 });
+		std::array<std::vector<double>, 3> batch_values, batch_derivs;
+		spline.evaluate(positions, batch_values, batch_derivs);
+		auto batch_values_only = spline.evaluate(positions);
+		for (size_t j = 0; j < positions.size(); j++) {
+			double h = positions[j];
+			std::array<double, 3> value, deriv;
+			spline.evaluate(h, value, deriv);
+			for (int i = 0; i < 3; i++) {
+				REQUIRE(spline(h)[i] == Approx(spline[i](h)).margin(1e-12));
+				REQUIRE(spline.derivative(h)[i] == Approx(spline[i].derivative(h)).margin(1e-12));
+				REQUIRE(value[i] == spline(h)[i]);
+				REQUIRE(deriv[i] == spline.derivative(h)[i]);
+				REQUIRE(batch_values[i][j] == value[i]);
+				REQUIRE(batch_values_only[i][j] == value[i]);
+				REQUIRE(batch_derivs[i][j] == deriv[i]);
+			}
+		}
+	}
+
+	SECTION("Different knots per dimension") {
+		HBTK::CubicSpline1D spline1({ 0, 1, 2 }, { 0, 1, 0 });
+		HBTK::CubicSpline1D spline2({ 0, 0.5, 2 }, { 2, 1, 2 });
+		HBTK::CubicSplineND<2> spline({ spline1, spline2 });
+		std::array<std::vector<double>, 2> values, derivs;
+		spline.evaluate({ 0.2, 1.4 }, values, derivs);
+		REQUIRE(spline(0.2)[0] == spline1(0.2));
+		REQUIRE(spline(1.4)[1] == spline2(1.4));
+		REQUIRE(values[1][1] == spline2(1.4));
+		REQUIRE(derivs[0][0] == spline1.derivative(0.2));
+		REQUIRE(spline.lower_input_bound() == 0);
+		REQUIRE(spline.upper_input_bound() == 2);
+	}
 }
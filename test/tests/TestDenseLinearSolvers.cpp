@@ -0,0 +1,143 @@
+#include <HBTK/DenseLinearSolvers.h>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	// A deterministic, well conditioned, non-symmetric matrix that needs 
+	// pivoting.
+	HBTK::DenseMatrix test_matrix(int n)
+	{
+		HBTK::DenseMatrix matrix(n, n);
+		for (int i = 0; i < n; i++) {
+			for (int j = 0; j < n; j++) {
+				matrix(i, j) = sin(1.7 * i + 0.3 * j * j + 0.1) / n;
+			}
+			matrix(i, n - 1 - i) += 2;
+		}
+		return matrix;
+	}
+
+	std::vector<double> test_vector(int n, double seed)
+	{
+		std::vector<double> vector(n);
+		for (int i = 0; i < n; i++) { vector[i] = cos(seed * i + 0.2); }
+		return vector;
+	}
+}
+
+TEST_CASE("LU factorisation") {
+	SECTION("Small system") {
+		HBTK::DenseMatrix matrix(3, 3);
+		matrix(0, 0) = 0; matrix(0, 1) = 2; matrix(0, 2) = 1;
+		matrix(1, 0) = 1; matrix(1, 1) = 1; matrix(1, 2) = 0;
+		matrix(2, 0) = 3; matrix(2, 1) = 0; matrix(2, 2) = 1;
+		HBTK::LUFactorisation lu(matrix);
+		REQUIRE(lu.size() == 3);
+		REQUIRE(lu.pivots()[0] == 2);
+		std::vector<double> x = lu.solve({ 3, 2, 4 });
+		REQUIRE(x[0] == Approx(1));
+		REQUIRE(x[1] == Approx(1));
+		REQUIRE(x[2] == Approx(1));
+	}
+	SECTION("Blocked and threaded") {
+		for (int n : { 1, 63, 64, 65, 300 }) {
+			HBTK::DenseMatrix matrix = test_matrix(n);
+			HBTK::LUFactorisation lu(matrix), lu4(matrix, 4);
+			for (int i = 0; i < n; i++) {
+				for (int j = 0; j < n; j++) {
+					REQUIRE(lu.factors()(i, j) == lu4.factors()(i, j));
+				}
+			}
+			// The factorisation is reused for several right hand sides.
+			for (double seed : { 0.5, 1.1, 2.9 }) {
+				std::vector<double> x_ref = test_vector(n, seed);
+				std::vector<double> rhs = matrix * x_ref;
+				std::vector<double> x = lu4.solve(rhs);
+				lu.solve_in_place(rhs);
+				for (int i = 0; i < n; i++) {
+					REQUIRE(x[i] == Approx(x_ref[i]).margin(1e-10));
+					REQUIRE(rhs[i] == x[i]);
+				}
+			}
+		}
+	}
+	SECTION("Bad matrices") {
+		HBTK::DenseMatrix singular = test_matrix(100);
+		for (int i = 0; i < 100; i++) { singular(i, 70) = 0; }
+		REQUIRE_THROWS_AS(HBTK::LUFactorisation(singular, 2), std::runtime_error);
+		REQUIRE_THROWS_AS(HBTK::LUFactorisation(HBTK::DenseMatrix(3, 4)), std::runtime_error);
+	}
+}
+
+TEST_CASE("GMRES") {
+	const int n = 200;
+	HBTK::DenseMatrix matrix = test_matrix(n);
+	std::vector<double> x_ref = test_vector(n, 0.7);
+	std::vector<double> rhs = matrix * x_ref;
+
+	SECTION("Assembled matrix") {
+		HBTK::IterativeSolveReport report, report4;
+		std::vector<double> x = HBTK::gmres(matrix, rhs, {}, 1e-12, 30, 1000, 1, &report);
+		std::vector<double> x4 = HBTK::gmres(matrix, rhs, {}, 1e-12, 30, 1000, 4, &report4);
+		REQUIRE(report.converged);
+		REQUIRE(report.residual <= 1e-12);
+		REQUIRE(report.iterations == report4.iterations);
+		for (int i = 0; i < n; i++) {
+			REQUIRE(x[i] == Approx(x_ref[i]).margin(1e-9));
+			REQUIRE(x4[i] == x[i]);
+		}
+		// Starting from the solution needs no iterations.
+		HBTK::gmres(matrix, rhs, x_ref, 1e-12, 30, 1000, 1, &report);
+		REQUIRE(report.iterations == 0);
+		// Too few iterations.
+		HBTK::gmres(matrix, rhs, {}, 1e-12, 1, 3, 1, &report);
+		REQUIRE(!report.converged);
+		REQUIRE(report.iterations == 3);
+	}
+	SECTION("Matrix-free operator") {
+		// A tridiagonal operator that is never assembled.
+		HBTK::LinearOperator tridiagonal = [](const std::vector<double> & x, std::vector<double> & y) {
+			const int size = (int)x.size();
+			for (int i = 0; i < size; i++) {
+				y[i] = 4 * x[i] - (i > 0 ? x[i - 1] : 0) - (i < size - 1 ? 2 * x[i + 1] : 0);
+			}
+		};
+		std::vector<double> b(n);
+		tridiagonal(x_ref, b);
+		HBTK::IterativeSolveReport report;
+		std::vector<double> x = HBTK::gmres(tridiagonal, b, {}, 1e-12, 50, 1000, 
+			HBTK::LinearOperator(), &report);
+		REQUIRE(report.converged);
+		for (int i = 0; i < n; i++) { REQUIRE(x[i] == Approx(x_ref[i]).margin(1e-9)); }
+	}
+	SECTION("Preconditioned by an old factorisation") {
+		// As in time-marching: factorise once, then solve a perturbed system.
+		HBTK::LUFactorisation lu(matrix);
+		HBTK::DenseMatrix perturbed = matrix;
+		for (int i = 0; i < n; i++) { perturbed(i, (i + 5) % n) += 0.01; }
+		std::vector<double> b = perturbed * x_ref;
+		HBTK::LinearOperator product = [&](const std::vector<double> & x, std::vector<double> & y) {
+			y = perturbed * x;
+		};
+		HBTK::LinearOperator preconditioner = [&](const std::vector<double> & x, std::vector<double> & y) {
+			y = lu.solve(x);
+		};
+		HBTK::IterativeSolveReport report, unpreconditioned;
+		std::vector<double> x = HBTK::gmres(product, b, {}, 1e-12, 50, 1000, preconditioner, &report);
+		HBTK::gmres(product, b, {}, 1e-12, 50, 1000, HBTK::LinearOperator(), &unpreconditioned);
+		REQUIRE(report.converged);
+		REQUIRE(report.iterations < unpreconditioned.iterations);
+		for (int i = 0; i < n; i++) { REQUIRE(x[i] == Approx(x_ref[i]).margin(1e-9)); }
+	}
+	SECTION("Zero right hand side") {
+		HBTK::IterativeSolveReport report;
+		std::vector<double> x = HBTK::gmres(matrix, std::vector<double>(n, 0.), 
+			x_ref, 1e-12, 30, 1000, 1, &report);
+		REQUIRE(report.converged);
+		for (int i = 0; i < n; i++) { REQUIRE(x[i] == 0); }
+	}
+}
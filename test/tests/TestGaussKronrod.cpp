@@ -0,0 +1,117 @@
+#include <cmath>
+
+#include <catch2/catch.hpp>
+
+#include <HBTK/GaussKronrod.h>
+#include <HBTK/Remaps.h>
+
+
+TEST_CASE("Gauss-Kronrod tables")
+{
+	const HBTK::gauss_kronrod_rule rules[3] = { HBTK::gauss_kronrod_7_15,
+		HBTK::gauss_kronrod_10_21, HBTK::gauss_kronrod_30_61 };
+	for (auto rule : rules) {
+		HBTK::GaussKronrodTable table = HBTK::gauss_kronrod_table(rule);
+		int n = table.num_nodes - 1;	// Number of Gauss points (per half) ~ n.
+		REQUIRE(table.nodes[n] == 0.0);
+		// Kronrod rule integrates degree 3 * gauss_points + 1 exactly,
+		// the embedded Gauss rule 2 * gauss_points - 1.
+		int gauss_points = (2 * table.num_nodes - 1) / 2;
+		for (int degree = 0; degree <= 3 * gauss_points + 1; degree += 2) {
+			double kronrod = table.kronrod_weights[n] * pow(0.0, degree);
+			double gauss = table.gauss_weights[n] * pow(0.0, degree);
+			for (int j = 0; j < n; j++) {
+				kronrod += 2 * table.kronrod_weights[j] * pow(table.nodes[j], degree);
+				gauss += 2 * table.gauss_weights[j] * pow(table.nodes[j], degree);
+			}
+			REQUIRE(kronrod == Approx(2. / (degree + 1)).epsilon(1e-13));
+			if (degree < 2 * gauss_points) {
+				REQUIRE(gauss == Approx(2. / (degree + 1)).epsilon(1e-13));
+			}
+		}
+	}
+}
+
+TEST_CASE("Wynn epsilon")
+{
+	HBTK::WynnEpsilon epsilon;
+	double partial_sum = 0;
+	for (int i = 1; i < 16; i++) {
+		partial_sum += (i % 2 ? 1. : -1.) / i;
+		epsilon.add(partial_sum);
+	}
+	REQUIRE(std::abs(partial_sum - log(2.)) > 1e-2);
+	REQUIRE(epsilon.result() == Approx(log(2.)).epsilon(1e-10));
+	REQUIRE(epsilon.error_estimate() < 1e-8);
+}
+
+TEST_CASE("Globally adaptive Gauss-Kronrod")
+{
+	int calls = 0;
+	SECTION("Smooth integrand with each rule")
+	{
+		auto my_f = [&](double x)->double { calls++; return exp(x) * cos(5 * x); };
+		double exact = (exp(2.) * (cos(10.) + 5 * sin(10.)) - 1) / 26;
+		const HBTK::gauss_kronrod_rule rules[3] = { HBTK::gauss_kronrod_7_15,
+			HBTK::gauss_kronrod_10_21, HBTK::gauss_kronrod_30_61 };
+		for (auto rule : rules) {
+			HBTK::GaussKronrodReport report;
+			calls = 0;
+			double result = HBTK::gauss_kronrod_integrate(my_f, 0.0, 2.0, 1e-12, 0.0,
+				rule, true, 1000, &report);
+			REQUIRE(report.converged);
+			REQUIRE(report.evaluations == calls);
+			REQUIRE(std::abs(result - exact) < 1e-12);
+		}
+	}
+	SECTION("Endpoint singularities")
+	{
+		auto inv_sqrt = [&](double x)->double { calls++; return 1 / sqrt(x); };
+		auto log_f = [&](double x)->double { calls++; return log(x); };
+		HBTK::GaussKronrodReport report, plain_report;
+		double result = HBTK::gauss_kronrod_integrate(inv_sqrt, 0.0, 1.0, 1e-12, 1e-12,
+			HBTK::gauss_kronrod_10_21, true, 1000, &report);
+		REQUIRE(report.converged);
+		REQUIRE(result == Approx(2.0).epsilon(1e-11));
+		double plain = HBTK::gauss_kronrod_integrate(inv_sqrt, 0.0, 1.0, 1e-12, 1e-12,
+			HBTK::gauss_kronrod_10_21, false, 1000, &plain_report);
+		REQUIRE(plain == Approx(2.0).epsilon(1e-10));
+		REQUIRE(report.evaluations < plain_report.evaluations);
+
+		result = HBTK::gauss_kronrod_integrate(log_f, 0.0, 1.0, 1e-12, 1e-12,
+			HBTK::gauss_kronrod_10_21, true, 1000, &report);
+		REQUIRE(report.converged);
+		REQUIRE(result == Approx(-1.0).epsilon(1e-11));
+	}
+	SECTION("Interior singularity")
+	{
+		auto my_f = [&](double x)->double { return log(std::abs(x - 1. / 3)); };
+		double exact = (2. / 3) * log(2. / 3) + (1. / 3) * log(1. / 3) - 1;
+		HBTK::GaussKronrodReport report;
+		double result = HBTK::gauss_kronrod_integrate(my_f, 0.0, 1.0, 1e-10, 1e-10,
+			HBTK::gauss_kronrod_10_21, true, 1000, &report);
+		REQUIRE(report.converged);
+		REQUIRE(result == Approx(exact).epsilon(1e-9));
+	}
+	SECTION("Telles and Sato remaps")
+	{
+		auto my_f = [&](double x)->double { calls++; return log(std::abs(x - 0.3)); };
+		double exact = 1.3 * log(1.3) + 0.7 * log(0.7) - 2;
+		auto telles = [](double & p, double & w) { HBTK::telles_cubic_remap(p, w, 0.3); };
+		HBTK::GaussKronrodReport report, plain_report;
+		double result = HBTK::gauss_kronrod_integrate_remapped(my_f, telles, -1.0, 1.0,
+			1e-12, 1e-12, HBTK::gauss_kronrod_10_21, false, 1000, &report);
+		REQUIRE(report.converged);
+		REQUIRE(result == Approx(exact).epsilon(1e-11));
+		HBTK::gauss_kronrod_integrate(my_f, -1.0, 1.0, 1e-12, 1e-12,
+			HBTK::gauss_kronrod_10_21, false, 1000, &plain_report);
+		REQUIRE(report.evaluations < plain_report.evaluations);
+
+		auto end_f = [&](double x)->double { return log(1 - x); };
+		auto sato = [](double & p, double & w) { HBTK::sato_remap<3>(p, w, 1.0); };
+		result = HBTK::gauss_kronrod_integrate_remapped(end_f, sato, -1.0, 1.0,
+			1e-12, 1e-12, HBTK::gauss_kronrod_10_21, true, 1000, &report);
+		REQUIRE(report.converged);
+		REQUIRE(result == Approx(2 * log(2.) - 2).epsilon(1e-11));
+	}
+}
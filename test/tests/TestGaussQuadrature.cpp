@@ -1,10 +1,13 @@
 
 
 #include <HBTK/GaussianQuadrature.h>
+#include <HBTK/QuadratureCache.h>
+#include <HBTK/QuadratureSelector.h>
 #include <HBTK/Tolerances.h>
 
 #include <catch2/catch.hpp>
 
+#include <cmath>
 #include <vector>
 #include <array>
 #include <chrono>
@@ -88,6 +91,95 @@ TEST_CASE("Gauss Legendre quadratures generation")
 }
 
 
+TEST_CASE("Compile time Gauss Legendre quadrature generation")
+{
+	SECTION("Evaluated in a constant expression") {
+		constexpr auto table = HBTK::gauss_legendre_table<7>();
+		static_assert(table.weights[3] > 0.4179 && table.weights[3] < 0.4180, 
+			"Compile time Gauss-Legendre weight incorrect.");
+		static_assert(table.points[3] == 0.0, "Compile time Gauss-Legendre point incorrect.");
+		REQUIRE(table.points[0] == Approx(0.949107912342759));
+	}
+
+	SECTION("Matches runtime generation") {
+		constexpr auto table = HBTK::gauss_legendre_table<64>();
+		std::vector<double> points(64), weights(64);
+		HBTK::gauss_legendre<double>(64, points, weights);
+		for (int i = 0; i < 64; i++) {
+			REQUIRE(table.points[i] == Approx(points[i]).margin(1e-15));
+			REQUIRE(table.weights[i] == Approx(weights[i]).epsilon(1e-14));
+		}
+		constexpr auto tablef = HBTK::gauss_legendre_table<5, float>();
+		REQUIRE(tablef.weights[2] == Approx(128.f / 225));
+	}
+
+	SECTION("Integration") {
+		auto func = [](double x) { return x * x * x * x * x + x * x + 3; };
+		REQUIRE(HBTK::gauss_legendre_integrate<3>(func) == Approx(6. + 2. / 3));
+		auto cosine = [](double x) { return cos(x); };
+		REQUIRE(HBTK::gauss_legendre_integrate<16>(cosine) == Approx(2 * sin(1.)));
+	}
+}
+
+TEST_CASE("Asymptotic Gauss Legendre quadrature generation")
+{
+	SECTION("Matches Newton iteration generation") {
+		for (int n : { 50, 101, 102, 251, 1000 }) {
+			std::vector<double> points, weights, ref_points(n), ref_weights(n);
+			HBTK::gauss_legendre_asymptotic(n, points, weights);
+			HBTK::gauss_legendre<double>(n, ref_points, ref_weights);
+			REQUIRE((int)points.size() == n);
+			REQUIRE((int)weights.size() == n);
+			for (int i = 0; i < n; i++) {
+				REQUIRE(points[i] == Approx(ref_points[i]).margin(1e-14));
+				// The Newton iteration loses accuracy in the weights nearest the ends.
+				REQUIRE(weights[i] == Approx(ref_weights[i]).epsilon(1e-10));
+			}
+		}
+	}
+
+	SECTION("Matches high precision values near the ends") {
+		// Computed with quadruple precision Newton iteration.
+		std::vector<double> points, weights;
+		HBTK::gauss_legendre_asymptotic(1000, points, weights);
+		const std::vector<int> idxs = { 0, 1, 20, 21, 499 };
+		const std::vector<double> ref_points = { 0.9999971112980755105699,
+			0.9999847796329174183243, 0.9978780085941545684211,
+			0.9976686446221499916327, 0.001570010480083193829005 };
+		const std::vector<double> ref_weights = { 7.413338416432071517477e-06,
+			1.725676977373923011776e-05, 0.0002044449021678837013885,
+			0.0002142826978022177041715, 0.003140018380182867786996 };
+		for (int i = 0; i < (int)idxs.size(); i++) {
+			REQUIRE(points[idxs[i]] == Approx(ref_points[i]).margin(1e-15));
+			REQUIRE(points[999 - idxs[i]] == Approx(-ref_points[i]).margin(1e-15));
+			REQUIRE(weights[idxs[i]] == Approx(ref_weights[i]).epsilon(1e-14));
+			REQUIRE(weights[999 - idxs[i]] == Approx(ref_weights[i]).epsilon(1e-14));
+		}
+	}
+
+	SECTION("Large quadratures integrate accurately") {
+		std::vector<double> points, weights;
+		HBTK::gauss_legendre_asymptotic(20001, points, weights);
+		double weight_sum = 0, poly = 0, cosine = 0;
+		for (int i = 0; i < 20001; i++) {
+			weight_sum += weights[i];
+			poly += weights[i] * pow(points[i], 10);
+			cosine += weights[i] * cos(1000 * points[i]);
+		}
+		REQUIRE(weight_sum == Approx(2.0).epsilon(1e-13));
+		REQUIRE(poly == Approx(2. / 11).epsilon(1e-13));
+		REQUIRE(cosine == Approx(2 * sin(1000.) / 1000).epsilon(1e-10));
+		REQUIRE(points[10000] == 0.0);
+	}
+
+	SECTION("StaticQuadrature interface") {
+		auto quad = HBTK::gauss_legendre(300);
+		REQUIRE(quad.num_points() == 300);
+		auto func = [](double x) { return exp(x); };
+		REQUIRE(quad.integrate(func) == Approx(exp(1.) - exp(-1.)));
+	}
+}
+
 TEST_CASE("Gauss Laguerre quadrature generation")
 {
 	SECTION("3 point Gauss laguere quadrature generation.") {
@@ -196,3 +288,155 @@ TEST_CASE("Gauss Chebyshev type 2 quadrature") {
 	}
 }
 
+
+TEST_CASE("Quadrature cache")
+{
+	HBTK::QuadratureCache::clear();
+
+	SECTION("Cached rules match generated rules") {
+		auto cached = HBTK::QuadratureCache::get(HBTK::QuadratureCache::gauss_legendre, 7);
+		auto generated = HBTK::gauss_legendre(7);
+		REQUIRE(cached->get_quadrature() == generated.get_quadrature());
+		auto cached_jacobi = HBTK::QuadratureCache::get(HBTK::QuadratureCache::gauss_jacobi, 5, 1, 0.5);
+		auto generated_jacobi = HBTK::gauss_jacobi(5, 1, 0.5);
+		REQUIRE(cached_jacobi->get_quadrature() == generated_jacobi.get_quadrature());
+		auto func = [](double x) { return x * x; };
+		REQUIRE(cached->integrate(func) == Approx(2. / 3));
+	}
+
+	SECTION("Hits, misses and sharing") {
+		auto first = HBTK::QuadratureCache::get(HBTK::QuadratureCache::gauss_legendre, 5);
+		auto second = HBTK::QuadratureCache::get(HBTK::QuadratureCache::gauss_legendre, 5);
+		// Unused parameters should not give a different rule.
+		auto third = HBTK::QuadratureCache::get(HBTK::QuadratureCache::gauss_legendre, 5, 2.);
+		auto other = HBTK::QuadratureCache::get(HBTK::QuadratureCache::gauss_chebyshev1, 5);
+		REQUIRE(first == second);
+		REQUIRE(first == third);
+		REQUIRE(first != other);
+		REQUIRE(HBTK::QuadratureCache::hits() == 2);
+		REQUIRE(HBTK::QuadratureCache::misses() == 2);
+		REQUIRE(HBTK::QuadratureCache::size() == 2);
+		HBTK::QuadratureCache::clear();
+		REQUIRE(HBTK::QuadratureCache::size() == 0);
+		REQUIRE(first->num_points() == 5);
+	}
+
+	SECTION("Remapped rules") {
+		auto telles = HBTK::QuadratureCache::get_remapped(HBTK::QuadratureCache::gauss_legendre,
+			8, HBTK::QuadratureCache::telles_cubic, 0.25);
+		auto again = HBTK::QuadratureCache::get_remapped(HBTK::QuadratureCache::gauss_legendre,
+			8, HBTK::QuadratureCache::telles_cubic, 0.25);
+		auto moved = HBTK::QuadratureCache::get_remapped(HBTK::QuadratureCache::gauss_legendre,
+			8, HBTK::QuadratureCache::telles_cubic, 0.5);
+		auto plain = HBTK::QuadratureCache::get(HBTK::QuadratureCache::gauss_legendre, 8);
+		REQUIRE(telles == again);
+		REQUIRE(telles != moved);
+		REQUIRE(telles != plain);
+		REQUIRE(HBTK::QuadratureCache::size() == 3);
+		HBTK::StaticQuadrature generated = HBTK::gauss_legendre(8);
+		generated.telles_cubic_remap(0.25);
+		REQUIRE(telles->get_quadrature() == generated.get_quadrature());
+		auto sato = HBTK::QuadratureCache::get_remapped(HBTK::QuadratureCache::gauss_legendre,
+			8, HBTK::QuadratureCache::sato4, -1.);
+		auto func = [](double x) { return x * x; };
+		REQUIRE(sato->integrate(func) == Approx(2. / 3));
+		REQUIRE(HBTK::QuadratureCache::remapped_size() == 3);
+	}
+
+	SECTION("Remapped rules are capped") {
+		HBTK::QuadratureCache::set_remapped_limit(4);
+		auto plain = HBTK::QuadratureCache::get(HBTK::QuadratureCache::gauss_legendre, 6);
+		std::shared_ptr<const HBTK::StaticQuadrature> first;
+		for (int i = 0; i < 4; i++) {
+			auto rule = HBTK::QuadratureCache::get_remapped(HBTK::QuadratureCache::gauss_legendre,
+				6, HBTK::QuadratureCache::telles_cubic, 0.1 * i);
+			if (i == 0) { first = rule; }
+		}
+		REQUIRE(HBTK::QuadratureCache::remapped_size() == 4);
+		REQUIRE(HBTK::QuadratureCache::size() == 5);
+		auto fifth = HBTK::QuadratureCache::get_remapped(HBTK::QuadratureCache::gauss_legendre,
+			6, HBTK::QuadratureCache::telles_cubic, 0.5);
+		REQUIRE(HBTK::QuadratureCache::remapped_size() == 1);
+		REQUIRE(HBTK::QuadratureCache::size() == 2);
+		REQUIRE(HBTK::QuadratureCache::get(HBTK::QuadratureCache::gauss_legendre, 6) == plain);
+		// Evicted rules held by the caller stay valid.
+		REQUIRE(first->num_points() == 6);
+		HBTK::QuadratureCache::set_remapped_limit(HBTK::QuadratureCache::default_remapped_limit);
+	}
+}
+
+TEST_CASE("Quadrature selector")
+{
+	SECTION("Benchmarking leaves the cache untouched") {
+		HBTK::QuadratureCache::clear();
+		double error = HBTK::QuadratureSelector::benchmark_error(
+			HBTK::QuadratureCache::telles_cubic, 12, 0.3, 0.01);
+		REQUIRE(error < 1);
+		REQUIRE(HBTK::QuadratureCache::size() == 0);
+		REQUIRE(HBTK::QuadratureCache::misses() == 0);
+	}
+
+	SECTION("Far field needs no remap") {
+		auto choice = HBTK::QuadratureSelector::select(0.2, 2.5, 1e-8);
+		REQUIRE(choice.remap == HBTK::QuadratureCache::no_remap);
+		REQUIRE(choice.meets_tolerance);
+		REQUIRE(choice.num_points < 12);
+	}
+
+	SECTION("Endpoint log singularity") {
+		auto choice = HBTK::QuadratureSelector::select(-1, 0, 1e-8);
+		REQUIRE(choice.remap != HBTK::QuadratureCache::no_remap);
+		REQUIRE(choice.meets_tolerance);
+		auto func = [](double x) { return log((x + 1) / 4); };
+		double exact = 2 * log(2.) - 2 - 2 * log(4.);
+		REQUIRE(std::abs(choice.quadrature()->integrate(func) - exact) < 1e-8 * std::abs(exact));
+	}
+
+	SECTION("Near singular interior point") {
+		double h = 0.05;
+		auto choice = HBTK::QuadratureSelector::select(0.3, h, 1e-6);
+		REQUIRE(choice.meets_tolerance);
+		auto func = [=](double x) { return 1 / sqrt((x - 0.3) * (x - 0.3) + h * h); };
+		double exact = asinh(0.7 / h) + asinh(1.3 / h);
+		REQUIRE(std::abs(choice.quadrature()->integrate(func) - exact) < 1e-6 * exact);
+	}
+
+	SECTION("Singularity beyond the element") {
+		auto choice = HBTK::QuadratureSelector::select(1.5, 0, 1e-6);
+		REQUIRE(choice.singularity_position <= 1);
+		auto func = [](double x) { return log((1.5 - x) / 4); };
+		double exact = (2.5 * log(2.5) - 2.5) - (0.5 * log(0.5) - 0.5) - 2 * log(4.);
+		REQUIRE(std::abs(choice.quadrature()->integrate(func) - exact) < 1e-6 * std::abs(exact));
+	}
+
+	SECTION("Meeting the tolerance between calibrated points") {
+		for (double s : { 0.3, 0.76, 1. }) {
+			for (double h : { 0., 1e-6, 5e-5, 0.05 }) {
+				for (double tol = 1e-2; tol > 1e-13; tol *= 0.1) {
+					auto choice = HBTK::QuadratureSelector::select(s, h, tol);
+					if (choice.meets_tolerance) {
+						REQUIRE(HBTK::QuadratureSelector::benchmark_error(
+							choice.remap, choice.num_points, s, h) <= tol);
+					}
+				}
+			}
+		}
+	}
+
+	SECTION("Nothing is promised below the smallest non-zero distance") {
+		const double h = HBTK::QuadratureSelector::calibrated_distances()[1] / 2;
+		REQUIRE_FALSE(HBTK::QuadratureSelector::select(0.3, h, 1e-2).meets_tolerance);
+		REQUIRE_FALSE(HBTK::QuadratureSelector::select(1, h, 1e-2).meets_tolerance);
+	}
+
+	SECTION("Tighter tolerances never use fewer points") {
+		for (double h : HBTK::QuadratureSelector::calibrated_distances()) {
+			int last = 0;
+			for (double tol = 1e-2; tol > 1e-13; tol *= 0.1) {
+				auto choice = HBTK::QuadratureSelector::select(-0.4, h, tol);
+				REQUIRE(choice.num_points >= last);
+				last = choice.num_points;
+			}
+		}
+	}
+}
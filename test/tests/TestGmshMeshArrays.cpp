@@ -0,0 +1,150 @@
+#include <HBTK/GmshMeshArrays.h>
+#include <HBTK/GmshParser.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("GmshMeshArrays")
+{
+	SECTION("GMSH test file 1 - ASCII and binary")
+	{
+		auto ascii = HBTK::Gmsh::read_mesh_arrays(TESTHBTK_RESOURCE_GMSH_TEST_FILE_ASCII);
+		auto binary = HBTK::Gmsh::read_mesh_arrays(TESTHBTK_RESOURCE_GMSH_TEST_FILE_BINARY);
+		for (auto * mesh : { &ascii, &binary }) {
+			REQUIRE(mesh->number_of_nodes() == 703);
+			REQUIRE(mesh->number_of_elements() == 860);
+			REQUIRE((int)mesh->element_node_offsets.size() == 861);
+			int edge_count = 0;
+			std::map<int, std::set<int>> phys_grps;
+			for (int i = 0; i < mesh->number_of_elements(); i++) {
+				if (mesh->element_types[i] == 1) { edge_count++; }
+				for (int j = mesh->element_group_offsets[i]; j < mesh->element_group_offsets[i + 1]; j++) {
+					phys_grps[mesh->element_group_tags[j]].emplace(mesh->element_tags[i]);
+				}
+			}
+			REQUIRE(edge_count == 224);
+			REQUIRE(636 == (int)phys_grps[1].size());
+			REQUIRE(112 == (int)phys_grps[2].size());
+			REQUIRE(mesh->group_names.size() == 5);
+			REQUIRE(mesh->group_tags[4] == 1);
+			REQUIRE(mesh->group_dimensions[4] == 2);
+			REQUIRE(mesh->group_names[4] == "Volume");
+		}
+		REQUIRE(ascii.node_tags == binary.node_tags);
+		REQUIRE(ascii.element_tags == binary.element_tags);
+		REQUIRE(ascii.element_node_tags == binary.element_node_tags);
+		for (int i = 0; i < ascii.number_of_nodes(); i++) {
+			REQUIRE(ascii.node_x[i] == Approx(binary.node_x[i]).margin(1e-12));
+			REQUIRE(ascii.node_y[i] == Approx(binary.node_y[i]).margin(1e-12));
+			REQUIRE(ascii.node_z[i] == Approx(binary.node_z[i]).margin(1e-12));
+		}
+	}
+
+	SECTION("Matches GmshParser")
+	{
+		auto mesh = HBTK::Gmsh::read_mesh_arrays(TESTHBTK_RESOURCE_GMSH_TEST_FILE_ASCII);
+		HBTK::Gmsh::GmshParser parser;
+		int node = 0, element = 0;
+		bool nodes_match = true, elements_match = true;
+		parser.add_node_function([&](int tag, double x, double y, double z)->bool {
+			nodes_match = nodes_match && tag == mesh.node_tags[node] && x == mesh.node_x[node]
+				&& y == mesh.node_y[node] && z == mesh.node_z[node];
+			node++;
+			return true;
+		});
+		parser.add_elem_function([&](int tag, int type, std::vector<int> grps, std::vector<int> nds)->bool {
+			std::vector<int> mesh_grps(mesh.element_group_tags.begin() + mesh.element_group_offsets[element],
+				mesh.element_group_tags.begin() + mesh.element_group_offsets[element + 1]);
+			std::vector<int> mesh_nds(mesh.element_node_tags.begin() + mesh.element_node_offsets[element],
+				mesh.element_node_tags.begin() + mesh.element_node_offsets[element + 1]);
+			elements_match = elements_match && tag == mesh.element_tags[element]
+				&& type == mesh.element_types[element] && grps == mesh_grps && nds == mesh_nds;
+			element++;
+			return true;
+		});
+		parser.parse(TESTHBTK_RESOURCE_GMSH_TEST_FILE_ASCII);
+		REQUIRE(node == mesh.number_of_nodes());
+		REQUIRE(element == mesh.number_of_elements());
+		REQUIRE(nodes_match);
+		REQUIRE(elements_match);
+	}
+
+	SECTION("Small blocks")
+	{
+		for (auto path : { TESTHBTK_RESOURCE_GMSH_TEST_FILE_ASCII, TESTHBTK_RESOURCE_GMSH_TEST_FILE_BINARY }) {
+			std::ifstream stream(path, std::ios::binary);
+			std::string file((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+			auto mesh = HBTK::Gmsh::parse_mesh_arrays(file.data(), file.data() + file.size());
+			std::vector<int> node_tags, element_tags, element_node_tags, element_group_tags;
+			bool offsets_good = true;
+			HBTK::Gmsh::MeshBlockFunctions functions;
+			functions.nodes = [&](const HBTK::Gmsh::NodeBlock & block) {
+				offsets_good = offsets_good && block.size <= 100 && block.section_size == 703
+					&& block.section_offset == (int)node_tags.size();
+				for (int i = 0; i < block.size; i++) {
+					offsets_good = offsets_good && block.x[i] == mesh.node_x[block.section_offset + i];
+				}
+				node_tags.insert(node_tags.end(), block.tags, block.tags + block.size);
+			};
+			functions.elements = [&](const HBTK::Gmsh::ElementBlock & block) {
+				offsets_good = offsets_good && block.size <= 100 && block.section_size == 860
+					&& block.section_offset == (int)element_tags.size()
+					&& block.node_offsets[0] == 0 && block.group_offsets[0] == 0;
+				element_tags.insert(element_tags.end(), block.tags, block.tags + block.size);
+				element_node_tags.insert(element_node_tags.end(), 
+					block.node_tags, block.node_tags + block.node_offsets[block.size]);
+				element_group_tags.insert(element_group_tags.end(), 
+					block.group_tags, block.group_tags + block.group_offsets[block.size]);
+			};
+			HBTK::Gmsh::scan_mesh_blocks(file.data(), file.data() + file.size(), functions, 100);
+			REQUIRE(offsets_good);
+			REQUIRE(node_tags == mesh.node_tags);
+			REQUIRE(element_tags == mesh.element_tags);
+			REQUIRE(element_node_tags == mesh.element_node_tags);
+			REQUIRE(element_group_tags == mesh.element_group_tags);
+		}
+	}
+
+	SECTION("Numbers and unsupported sections")
+	{
+		std::vector<std::string> numbers = { "0", "-0", "1", "-2.5", "0.1", "3.141592653589793",
+			"-0.3333333333333333", "12345678901234567", "1.7976931348623157e308", "4.9e-324",
+			"1e22", "1e23", "6.02214076E+23", "-1.5e-7", "+7", "0.000000000000000000000123",
+			"9007199254740993", "1.00000000000000011102230246251565404236316680908203125" };
+		std::string file = "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n"
+			"$Comments\nAnything $Nodes\n$EndComments\n"
+			"$PhysicalNames\n1\n2 7 \"Two words\"\n$EndPhysicalNames\n"
+			"$Nodes\n" + std::to_string(numbers.size()) + "\n";
+		for (size_t i = 0; i < numbers.size(); i++) {
+			file += std::to_string(i + 1) + " " + numbers[i] + " 0 " + numbers[i] + "\r\n";
+		}
+		file += "$EndNodes\n$Elements\n1\n9 2 0 1 2 3\n$EndElements\n";
+		auto mesh = HBTK::Gmsh::parse_mesh_arrays(file.data(), file.data() + file.size());
+		REQUIRE(mesh.group_names[0] == "Two words");
+		REQUIRE(mesh.group_tags[0] == 7);
+		REQUIRE(mesh.number_of_nodes() == (int)numbers.size());
+		for (size_t i = 0; i < numbers.size(); i++) {
+			REQUIRE(mesh.node_x[i] == strtod(numbers[i].c_str(), nullptr));
+			REQUIRE(mesh.node_z[i] == mesh.node_x[i]);
+		}
+		REQUIRE(mesh.element_types[0] == 2);
+		REQUIRE(mesh.element_group_offsets[1] == 0);
+		REQUIRE(mesh.element_node_tags == std::vector<int>({ 1, 2, 3 }));
+
+		std::string truncated = file.substr(0, file.size() - 30);
+		REQUIRE_THROWS_AS(HBTK::Gmsh::parse_mesh_arrays(truncated.data(), truncated.data() + truncated.size()),
+			std::runtime_error);
+		std::string version_4 = "$MeshFormat\n4.1 0 8\n$EndMeshFormat\n";
+		REQUIRE_THROWS_AS(HBTK::Gmsh::parse_mesh_arrays(version_4.data(), version_4.data() + version_4.size()),
+			std::runtime_error);
+		REQUIRE_THROWS_AS(HBTK::Gmsh::read_mesh_arrays("no_such_file.msh"), std::runtime_error);
+	}
+}
@@ -1,9 +1,13 @@
 
+#include <HBTK/GmshMeshHolder.h>
 #include <HBTK/GmshParser.h>
 
 #include <catch2/catch.hpp>
 
+#include <cstdio>
+#include <fstream>
 #include <map>
+#include <sstream>
 #include <string>
 #include <set>
 
@@ -141,4 +145,104 @@ TEST_CASE("GmshParser")
 		REQUIRE(112 == (int)phys_grps[2].size());
 		REQUIRE(z_zero_check);
 	}
+
+	SECTION("GMSH test file 1 - block functions")
+	{
+		for (auto file : { TESTHBTK_RESOURCE_GMSH_TEST_FILE_ASCII, TESTHBTK_RESOURCE_GMSH_TEST_FILE_BINARY }) {
+			// Reference from the line by line parser.
+			HBTK::Gmsh::GmshParser line_parser;
+			std::map<int, std::vector<double>> line_nodes;
+			std::map<int, std::vector<int>> line_elements;
+			line_parser.add_node_function([&](int tag, double x, double y, double z)->bool {
+				line_nodes[tag] = { x, y, z };
+				return true; });
+			line_parser.add_elem_function([&](int tag, int type, std::vector<int> grps, std::vector<int> nds)->bool {
+				line_elements[tag] = nds;
+				line_elements[tag].push_back(type);
+				line_elements[tag].insert(line_elements[tag].end(), grps.begin(), grps.end());
+				return true; });
+			line_parser.parse(file);
+
+			HBTK::Gmsh::GmshParser parser;
+			std::map<int, std::vector<double>> nodes;
+			std::map<int, std::vector<int>> elements;
+			std::map<int, std::string> phys_names;
+			int node_fn_count = 0;
+			bool good_offsets = true;
+			parser.add_node_block_function([&](const HBTK::Gmsh::NodeBlock & block) {
+				for (int i = 0; i < block.size; i++) {
+					nodes[block.tags[i]] = { block.x[i], block.y[i], block.z[i] };
+				} });
+			parser.add_elem_block_function([&](const HBTK::Gmsh::ElementBlock & block) {
+				good_offsets = good_offsets && block.node_offsets[0] == 0 && block.group_offsets[0] == 0;
+				for (int i = 0; i < block.size; i++) {
+					std::vector<int> & element = elements[block.tags[i]];
+					element.assign(block.node_tags + block.node_offsets[i], block.node_tags + block.node_offsets[i + 1]);
+					element.push_back(block.types[i]);
+					element.insert(element.end(), block.group_tags + block.group_offsets[i], 
+						block.group_tags + block.group_offsets[i + 1]);
+				} });
+			// Per item functions are still called alongside.
+			parser.add_node_function([&](int tag, double x, double y, double z)->bool {
+				node_fn_count++;
+				return true; });
+			parser.add_phys_name_function([&](int tag, int dim, std::string name)->bool {
+				phys_names[tag] = name;
+				return true; });
+			parser.parse(file);
+
+			REQUIRE(nodes.size() == 703);
+			REQUIRE(elements.size() == 860);
+			REQUIRE(node_fn_count == 703);
+			REQUIRE(good_offsets);
+			REQUIRE(phys_names[1] == std::string("Volume"));
+			REQUIRE(nodes == line_nodes);
+			REQUIRE(elements == line_elements);
+		}
+	}
+
+	SECTION("GmshMeshHolder parser")
+	{
+		const std::string path = "GmshParser_holder_test.msh";
+		{
+			std::ofstream file(path);
+			file << "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n"
+				"$PhysicalNames\n2\n1 1 \"Edge\"\n2 2 \"Face\"\n$EndPhysicalNames\n"
+				"$Nodes\n4\n1 0 0 0\n2 1 0 0\n3 1 1 0\n4 0 1 0.5\n$EndNodes\n"
+				"$Elements\n3\n1 1 1 1 1 2\n2 2 1 2 1 2 3\n3 2 2 2 1 1 3 4\n$EndElements\n";
+		}
+		HBTK::Gmsh::GmshMeshHolder holder;
+		holder.get_parser().parse(path);
+		std::remove(path.c_str());
+		REQUIRE(holder.number_of_nodes() == 4);
+		REQUIRE(holder.node(4).z() == 0.5);
+		REQUIRE(holder.number_of_elements() == 3);
+		REQUIRE(holder.element_id(2) == 2);
+		REQUIRE(holder.element_node_tags(3) == std::vector<int>({ 1, 3, 4 }));
+		REQUIRE(holder.group_name(2) == "Face");
+		REQUIRE(holder.group_elements(1).size() == 2);
+		REQUIRE(holder.group_elements(2).size() == 2);
+		REQUIRE(holder.element_in_group(1, 3));
+	}
+
+	SECTION("Malformed file with block functions")
+	{
+		const std::string path = "GmshParser_malformed_test.msh";
+		{
+			std::ofstream file(path);
+			file << "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n"
+				"$Nodes\n2\n1 0 0 0\n2 1 x 0\n$EndNodes\n";
+		}
+		HBTK::Gmsh::GmshMeshHolder holder;
+		auto parser = holder.get_parser();
+		std::ifstream input(path);
+		std::ostringstream errors;
+		bool threw_int = false;
+		try { parser.parse(input, errors); }
+		catch (int) { threw_int = true; }
+		input.close();
+		std::remove(path.c_str());
+		REQUIRE(threw_int);
+		REQUIRE(errors.str().find("ERROR:") == 0);
+	}
 }
@@ -1,10 +1,13 @@
 
 #include <array>
+#include <cmath>
+#include <vector>
 
 #include <catch2/catch.hpp>
 
 #include <HBTK/GaussLegendre.h>
 #include <HBTK/Integrators.h>
+#include <HBTK/StaticQuadrature.h>
 #include <HBTK/Tolerances.h>
 
 
@@ -26,6 +29,37 @@ TEST_CASE("Static integrator") {
 	}
 }
 
+TEST_CASE("Batch static integrator") {
+	SECTION("Many integrands on one rule")
+	{
+		std::vector<double> points(10), weights(10);
+		HBTK::gauss_legendre<double>(10, points, weights);
+		int calls = 0;
+		auto powers = [&](const std::vector<double> & x, std::vector<double> & f) {
+			calls++;
+			int n = (int)x.size();
+			for (int j = 0; j < 5; j++) {
+				for (int i = 0; i < n; i++) { f[j * n + i] = pow(x[i], 2 * j); }
+			}
+		};
+		std::vector<double> results = HBTK::static_integrate_batch(powers, points, weights, 5);
+		REQUIRE(calls == 1);
+		REQUIRE(results.size() == 5);
+		for (int j = 0; j < 5; j++) {
+			REQUIRE(results[j] == Approx(2. / (2 * j + 1)));
+		}
+		HBTK::StaticQuadrature quad(points, weights, -1, 1);
+		REQUIRE(quad.integrate_batch(powers, 5) == results);
+	}
+
+	SECTION("Pairwise summation")
+	{
+		std::vector<double> values(100001, 0.1), weights(100001, 1.0);
+		REQUIRE(HBTK::pairwise_dot(values.data(), weights.data(), 100001) 
+			== Approx(10000.1).epsilon(1e-15));
+	}
+}
+
 TEST_CASE("Adaptive trapezoidal integrator"){
 	SECTION("Integrate a x^2 in [0, 1]")
 	{
@@ -92,3 +126,57 @@ TEST_CASE("Adaptive Gauss-Lobatto")
 	}
 
 };
+
+TEST_CASE("Budgeted adaptive integrators")
+{
+	int calls = 0;
+	auto my_f = [&](double x)->double
+	{
+		calls++;
+		return sin(x);
+	};
+	const double exact = cos(10.0) - cos(12.0);	// Integral of sin in [10, 12]
+
+	SECTION("Unlimited budget converges away from the origin")
+	{
+		HBTK::AdaptiveIntegrationReport report;
+		double trap = HBTK::adaptive_trapezoidal_integrate(my_f, 1e-8, 10.0, 12.0, 1000000, &report);
+		REQUIRE(report.converged);
+		REQUIRE(report.evaluations == calls);
+		REQUIRE(trap == Approx(exact));
+		calls = 0;
+		double simp = HBTK::adaptive_simpsons_integrate(my_f, 1e-12, 10.0, 12.0, 1000000, &report);
+		REQUIRE(report.converged);
+		REQUIRE(report.evaluations == calls);
+		REQUIRE(simp == Approx(exact));
+		calls = 0;
+		double lob = HBTK::adaptive_gauss_lobatto_integrate(my_f, 1e-8, 10.0, 12.0, 1000000, &report);
+		REQUIRE(report.converged);
+		REQUIRE(report.evaluations == calls);
+		REQUIRE(lob == Approx(exact));
+	}
+
+	SECTION("Evaluation budget is respected")
+	{
+		auto spike = [&](double x)->double
+		{
+			calls++;
+			return 1. / (x * x + 1e-8);
+		};
+		HBTK::AdaptiveIntegrationReport report;
+		HBTK::adaptive_trapezoidal_integrate(spike, 1e-12, -1.0, 1.0, 100, &report);
+		REQUIRE(!report.converged);
+		REQUIRE(calls <= 100);
+		REQUIRE(report.evaluations == calls);
+		calls = 0;
+		HBTK::adaptive_simpsons_integrate(spike, 1e-12, -1.0, 1.0, 100, &report);
+		REQUIRE(!report.converged);
+		REQUIRE(calls <= 100);
+		REQUIRE(report.evaluations == calls);
+		calls = 0;
+		HBTK::adaptive_gauss_lobatto_integrate(spike, 1e-12, -1.0, 1.0, 100, &report);
+		REQUIRE(!report.converged);
+		REQUIRE(calls <= 100);
+		REQUIRE(report.evaluations == calls);
+	}
+}
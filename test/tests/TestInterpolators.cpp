@@ -0,0 +1,49 @@
+#include <HBTK/Interpolators.h>
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Interpolators") {
+	std::vector<double> inputs({ 0, 1, 2, 4, 8 });
+	std::vector<double> results({ 0, 2, 3, 7, -1 });
+
+	SECTION("hunt_lower_index") {
+		std::vector<double> queries({ -1, 0, 0.5, 1, 3.9, 4, 7, 8, 9 });
+		std::vector<int> expected({ -1, 0, 0, 1, 2, 3, 3, 4, 4 });
+		for (size_t i = 0; i < queries.size(); i++) {
+			for (int guess = -3; guess < 7; guess++) {
+				REQUIRE(HBTK::hunt_lower_index(inputs, queries[i], guess) == expected[i]);
+			}
+		}
+	}
+
+	SECTION("linear_interpolate") {
+		REQUIRE(HBTK::linear_interpolate(inputs, results, -1.) == 0);
+		REQUIRE(HBTK::linear_interpolate(inputs, results, 0.5) == 1);
+		REQUIRE(HBTK::linear_interpolate(inputs, results, 3.) == 5);
+		REQUIRE(HBTK::linear_interpolate(inputs, results, 9.) == -1);
+	}
+
+	SECTION("nearest_interpolate") {
+		REQUIRE(HBTK::nearest_interpolate(inputs, results, -1.) == 0);
+		REQUIRE(HBTK::nearest_interpolate(inputs, results, 0.4) == 0);
+		REQUIRE(HBTK::nearest_interpolate(inputs, results, 3.5) == 7);
+		REQUIRE(HBTK::nearest_interpolate(inputs, results, 9.) == -1);
+	}
+
+	SECTION("Interpolator object") {
+		HBTK::Interpolator<double, double> interpolator(inputs, results);
+		std::vector<double> queries({ -1, 0.5, 0.4, 3, 3.5, 7.9, 8, 9, 1.5, -2, 6 });
+		std::vector<double> linear = interpolator.linear(queries);
+		std::vector<double> nearest = interpolator.nearest(queries);
+		REQUIRE(linear.size() == queries.size());
+		REQUIRE(nearest.size() == queries.size());
+		for (size_t i = 0; i < queries.size(); i++) {
+			REQUIRE(interpolator.linear(queries[i]) == HBTK::linear_interpolate(inputs, results, queries[i]));
+			REQUIRE(interpolator.nearest(queries[i]) == HBTK::nearest_interpolate(inputs, results, queries[i]));
+			REQUIRE(linear[i] == interpolator.linear(queries[i]));
+			REQUIRE(nearest[i] == interpolator.nearest(queries[i]));
+		}
+	}
+}
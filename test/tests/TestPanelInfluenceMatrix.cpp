@@ -0,0 +1,132 @@
+#include <HBTK/PanelInfluenceMatrix.h>
+#include <HBTK/PotentialFlowDistributions.h>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Dense matrix") {
+	HBTK::DenseMatrix matrix(2, 3);
+	REQUIRE(matrix.rows() == 2);
+	REQUIRE(matrix.cols() == 3);
+	matrix(1, 2) = 4;
+	REQUIRE(matrix.row(1)[2] == 4);
+	REQUIRE(matrix.data()[5] == 4);
+	std::vector<double> product = matrix * std::vector<double>({ 1, 2, 3 });
+	REQUIRE(product[0] == 0);
+	REQUIRE(product[1] == 12);
+	std::vector<double> x = { 1, -2, 3 };
+	REQUIRE(HBTK::DenseMatrix::identity(3) * x == x);
+}
+
+TEST_CASE("Vortex panel influence matrices") {
+	// Panels around an ellipse, measured at their midpoints and elsewhere.
+	std::vector<double> x_nodes, y_nodes;
+	const int n_panels = 37;
+	for (int i = 0; i <= n_panels; i++) {
+		double t = 2 * HBTK::Constants::pi() * i / n_panels;
+		x_nodes.push_back(cos(t));
+		y_nodes.push_back(-0.3 * sin(t));
+	}
+	auto panels = HBTK::PanelGeometry2D::from_polyline(x_nodes, y_nodes);
+	REQUIRE(panels.size() == n_panels);
+	std::vector<double> x_mes = panels.x_midpoint(), y_mes = panels.y_midpoint();
+	for (int i = 0; i < 20; i++) {
+		x_mes.push_back(2 * sin(1.3 * i));
+		y_mes.push_back(cos(0.7 * i));
+	}
+	const int n_mes = (int)x_mes.size();
+
+	SECTION("Constant strength") {
+		HBTK::DenseMatrix u, v, u4, v4;
+		HBTK::ConstantVortexDistribution::influence_matrices(panels, x_mes, y_mes, u, v);
+		HBTK::ConstantVortexDistribution::influence_matrices(panels, x_mes, y_mes, u4, v4, 4);
+		REQUIRE(u.rows() == n_mes);
+		REQUIRE(u.cols() == n_panels);
+		for (int i = 0; i < n_mes; i++) {
+			for (int j = 0; j < n_panels; j++) {
+				REQUIRE(u(i, j) == u4(i, j));
+				REQUIRE(v(i, j) == v4(i, j));
+				if (i == j) { continue; }
+				auto scalar = HBTK::ConstantVortexDistribution::unity_vel(x_mes[i], y_mes[i],
+					x_nodes[j], y_nodes[j], x_nodes[j + 1], y_nodes[j + 1]);
+				REQUIRE(u(i, j) == Approx(scalar.first).margin(1e-12));
+				REQUIRE(v(i, j) == Approx(scalar.second).margin(1e-12));
+			}
+		}
+		// A panel is a line of point vortices.
+		for (int i = n_panels; i < n_mes; i++) {
+			const int j = i % n_panels;
+			const int n_sub = 20000;
+			double u_sum = 0, v_sum = 0;
+			for (int k = 0; k < n_sub; k++) {
+				double s = (k + 0.5) / n_sub;
+				double xv = x_nodes[j] + s * (x_nodes[j + 1] - x_nodes[j]);
+				double yv = y_nodes[j] + s * (y_nodes[j + 1] - y_nodes[j]);
+				u_sum += HBTK::PointVortex::unity_u_vel(x_mes[i], y_mes[i], xv, yv);
+				v_sum += HBTK::PointVortex::unity_v_vel(x_mes[i], y_mes[i], xv, yv);
+			}
+			u_sum *= panels.length()[j] / n_sub;
+			v_sum *= panels.length()[j] / n_sub;
+			REQUIRE(u(i, j) == Approx(u_sum).margin(1e-9));
+			REQUIRE(v(i, j) == Approx(v_sum).margin(1e-9));
+		}
+		// At its midpoint, a panel induces half its strength along itself on
+		// its normal side, and no normal velocity.
+		auto x_normal = panels.x_normal(), y_normal = panels.y_normal();
+		std::vector<double> x_mid = panels.x_midpoint(), y_mid = panels.y_midpoint();
+		auto normal = HBTK::ConstantVortexDistribution::directional_influence_matrix(
+			panels, x_mid, y_mid, x_normal, y_normal);
+		auto tangent = HBTK::ConstantVortexDistribution::directional_influence_matrix(
+			panels, x_mid, y_mid, panels.cos_angle(), panels.sin_angle());
+		for (int i = 0; i < n_panels; i++) {
+			REQUIRE(normal(i, i) == Approx(0).margin(1e-12));
+			REQUIRE(tangent(i, i) == Approx(0.5));
+			for (int j = 0; j < n_panels; j++) {
+				REQUIRE(normal(i, j) == Approx(u(i, j) * x_normal[i] + v(i, j) * y_normal[i]).margin(1e-14));
+			}
+		}
+	}
+
+	SECTION("Linear strength") {
+		HBTK::DenseMatrix u, v, u_const, v_const;
+		HBTK::LinearVortexDistribution::influence_matrices(panels, x_mes, y_mes, u, v, 3);
+		HBTK::ConstantVortexDistribution::influence_matrices(panels, x_mes, y_mes, u_const, v_const);
+		REQUIRE(u.cols() == 2 * n_panels);
+		for (int i = 0; i < n_mes; i++) {
+			for (int j = 0; j < n_panels; j++) {
+				// Equal end strengths are a constant strength panel.
+				REQUIRE(u(i, 2 * j) + u(i, 2 * j + 1) == Approx(u_const(i, j)).margin(1e-12));
+				REQUIRE(v(i, 2 * j) + v(i, 2 * j + 1) == Approx(v_const(i, j)).margin(1e-12));
+				if (i == j) { continue; }
+				double length = panels.length()[j];
+				auto start = HBTK::LinearVortexDistribution::vel(x_mes[i], y_mes[i],
+					x_nodes[j], y_nodes[j], x_nodes[j + 1], y_nodes[j + 1], 1., -1. / length);
+				auto end = HBTK::LinearVortexDistribution::vel(x_mes[i], y_mes[i],
+					x_nodes[j], y_nodes[j], x_nodes[j + 1], y_nodes[j + 1], 0., 1. / length);
+				REQUIRE(u(i, 2 * j) == Approx(start.first).margin(1e-12));
+				REQUIRE(v(i, 2 * j) == Approx(start.second).margin(1e-12));
+				REQUIRE(u(i, 2 * j + 1) == Approx(end.first).margin(1e-12));
+				REQUIRE(v(i, 2 * j + 1) == Approx(end.second).margin(1e-12));
+			}
+		}
+		// A panel is a line of point vortices of varying strength.
+		for (int i = n_panels; i < n_mes; i++) {
+			const int j = (3 * i) % n_panels;
+			const int n_sub = 20000;
+			double u_sum = 0, v_sum = 0;
+			for (int k = 0; k < n_sub; k++) {
+				double s = (k + 0.5) / n_sub;
+				double xv = x_nodes[j] + s * (x_nodes[j + 1] - x_nodes[j]);
+				double yv = y_nodes[j] + s * (y_nodes[j + 1] - y_nodes[j]);
+				u_sum += s * HBTK::PointVortex::unity_u_vel(x_mes[i], y_mes[i], xv, yv);
+				v_sum += s * HBTK::PointVortex::unity_v_vel(x_mes[i], y_mes[i], xv, yv);
+			}
+			u_sum *= panels.length()[j] / n_sub;
+			v_sum *= panels.length()[j] / n_sub;
+			REQUIRE(u(i, 2 * j + 1) == Approx(u_sum).margin(1e-9));
+			REQUIRE(v(i, 2 * j + 1) == Approx(v_sum).margin(1e-9));
+		}
+	}
+}
@@ -0,0 +1,77 @@
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+#include <catch2/catch.hpp>
+
+#include <HBTK/Integrators.h>
+#include <HBTK/ParallelIntegrators.h>
+
+
+TEST_CASE("Parallel for")
+{
+	std::vector<int> counts(1000, 0);
+	auto task = [&](int i) { counts[i]++; };
+	HBTK::parallel_for(1000, 4, task);
+	for (int count : counts) { REQUIRE(count == 1); }
+
+	SECTION("Exceptions reach the caller") {
+		std::atomic<int> started(0);
+		REQUIRE_THROWS_AS(HBTK::parallel_for(1000, 4, [&](int i) {
+			started++;
+			if (i == 10) { throw std::runtime_error("task failed"); }
+		}), std::runtime_error);
+		REQUIRE(started < 1000);
+		auto throwing_f = [](double x)->double { 
+			if (x > 0.5) { throw std::domain_error("bad x"); }
+			return x;
+		};
+		REQUIRE_THROWS_AS(HBTK::parallel_adaptive_gauss_lobatto_integrate(
+			throwing_f, 1e-8, 0., 1., 4), std::domain_error);
+	}
+}
+
+TEST_CASE("Parallel adaptive Gauss-Lobatto")
+{
+	std::atomic<int> calls(0);
+	auto my_f = [&](double x)->double
+	{
+		calls++;
+		return sqrt(x) * sin(10 * x);
+	};
+	const double tol = 1e-10;
+
+	SECTION("Matches the serial integrator")
+	{
+		HBTK::AdaptiveIntegrationReport serial_report, report;
+		double serial = HBTK::adaptive_gauss_lobatto_integrate(my_f, tol, 0.0, 2.0,
+			1000000, &serial_report);
+		calls = 0;
+		double parallel = HBTK::parallel_adaptive_gauss_lobatto_integrate(my_f, tol, 
+			0.0, 2.0, 4, 1000000, &report);
+		REQUIRE(report.converged);
+		REQUIRE(report.evaluations == calls);
+		REQUIRE(report.evaluations == serial_report.evaluations);
+		REQUIRE(parallel == Approx(serial).epsilon(1e-13));
+	}
+
+	SECTION("Result does not depend on the number of threads")
+	{
+		double one = HBTK::parallel_adaptive_gauss_lobatto_integrate(my_f, tol, 0.0, 2.0, 1);
+		for (int threads = 2; threads < 9; threads++) {
+			REQUIRE(HBTK::parallel_adaptive_gauss_lobatto_integrate(
+				my_f, tol, 0.0, 2.0, threads) == one);
+		}
+	}
+
+	SECTION("Evaluation budget is respected")
+	{
+		HBTK::AdaptiveIntegrationReport report;
+		calls = 0;
+		HBTK::parallel_adaptive_gauss_lobatto_integrate(my_f, 1e-14, 0.0, 2.0, 
+			4, 100, &report);
+		REQUIRE(!report.converged);
+		REQUIRE(calls <= 100);
+		REQUIRE(report.evaluations == calls);
+	}
+}
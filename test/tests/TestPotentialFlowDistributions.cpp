@@ -0,0 +1,276 @@
+#include <HBTK/PotentialFlowDistributions.h>
+#include <HBTK/Constants.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Biot-Savart") {
+
+	SECTION("Long filament") {
+		HBTK::CartesianFiniteLine3D filament(HBTK::CartesianPoint3D({ 0, 0, -1e4 }), 
+			HBTK::CartesianPoint3D({ 0, 0, 1e4 }));
+		HBTK::CartesianPoint3D point({ 1, 0, 0 });
+		auto vel = HBTK::BiotSavart::unity_vel(point, filament);
+		REQUIRE(vel.x() == Approx(0).margin(1e-12));
+		REQUIRE(vel.y() == Approx(1 / (2 * HBTK::Constants::pi())).epsilon(1e-6));
+		REQUIRE(vel.z() == Approx(0).margin(1e-12));
+	}
+
+	SECTION("Batched velocities match the single filament function") {
+		HBTK::PointCloud3D points, starts, ends;
+		std::vector<double> strengths;
+		for (int i = 0; i < 600; i++) {
+			points.push_back(HBTK::CartesianPoint3D({ sin(0.3 * i), cos(0.7 * i), 0.01 * i }));
+		}
+		for (int j = 0; j < 40; j++) {
+			starts.push_back(HBTK::CartesianPoint3D({ 0.1 * j, 0.5, -1 }));
+			ends.push_back(HBTK::CartesianPoint3D({ 0.1 * j + 0.05, -0.5, 1 + 0.1 * j }));
+			strengths.push_back(1 + 0.25 * j);
+		}
+		auto batched = HBTK::BiotSavart::induced_vel(points, starts, ends, strengths);
+		auto threaded = HBTK::BiotSavart::induced_vel(points, starts, ends, strengths, 0, 4);
+		REQUIRE(batched == threaded);
+		for (int i = 0; i < points.size(); i += 7) {
+			HBTK::CartesianVector3D expected({ 0, 0, 0 });
+			HBTK::CartesianPoint3D point = points[i];
+			for (int j = 0; j < starts.size(); j++) {
+				HBTK::CartesianFiniteLine3D filament(starts[j], ends[j]);
+				expected += HBTK::BiotSavart::unity_vel(point, filament) * strengths[j];
+			}
+			REQUIRE((batched[i] - expected).magnitude() < 1e-12 * (1 + expected.magnitude()));
+		}
+	}
+
+	SECTION("Vortex core and singular points") {
+		HBTK::PointCloud3D points, starts, ends;
+		points.push_back(HBTK::CartesianPoint3D({ 0.1, 0, 0 }));
+		points.push_back(HBTK::CartesianPoint3D({ 0, 0, 2e4 }));	// On the line.
+		points.push_back(HBTK::CartesianPoint3D({ 0, 0, 1e4 }));	// At the end.
+		starts.push_back(HBTK::CartesianPoint3D({ 0, 0, -1e4 }));
+		ends.push_back(HBTK::CartesianPoint3D({ 0, 0, 1e4 }));
+		std::vector<double> strengths = { 1 };
+		auto singular = HBTK::BiotSavart::induced_vel(points, starts, ends, strengths);
+		auto cored = HBTK::BiotSavart::induced_vel(points, starts, ends, strengths, 0.1);
+		REQUIRE(singular[0].y() == Approx(1 / (2 * HBTK::Constants::pi() * 0.1)).epsilon(1e-6));
+		REQUIRE(cored[0].y() == Approx(0.5 * singular[0].y()).epsilon(1e-6));
+		REQUIRE(singular[1] == HBTK::CartesianVector3D({ 0, 0, 0 }));
+		REQUIRE(singular[2] == HBTK::CartesianVector3D({ 0, 0, 0 }));
+		REQUIRE(cored[2].magnitude() == 0);
+	}
+}
+
+TEST_CASE("Fast summation") {
+
+	// A roll-up like spiral of singularities, with measurement points on the
+	// singularities and scattered around them.
+	std::vector<double> xs, ys, strengths, xm, ym;
+	for (int j = 0; j < 3000; j++) {
+		double r = 0.002 * j;
+		xs.push_back(r * cos(0.05 * j));
+		ys.push_back(r * sin(0.05 * j));
+		strengths.push_back(1 + sin(0.01 * j));
+	}
+	xm = xs;
+	ym = ys;
+	for (int i = 0; i < 1000; i++) {
+		xm.push_back(8 * sin(0.37 * i));
+		ym.push_back(3 * cos(0.71 * i));
+	}
+	auto max_error = [](const std::pair<std::vector<double>, std::vector<double>> & a,
+		const std::pair<std::vector<double>, std::vector<double>> & b) {
+		double error = 0, scale = 0;
+		for (size_t i = 0; i < a.first.size(); i++) {
+			error = std::max(error, std::hypot(a.first[i] - b.first[i], a.second[i] - b.second[i]));
+			scale = std::max(scale, std::hypot(b.first[i], b.second[i]));
+		}
+		return error / scale;
+	};
+
+	SECTION("Direct 2D summation matches the point kernels") {
+		auto vor = HBTK::PointVortex::induced_vel(xm, ym, xs, ys, strengths);
+		auto sor = HBTK::PointSource::induced_vel(xm, ym, xs, ys, strengths);
+		for (int i = 3000; i < (int)xm.size(); i += 97) {
+			double u_vor = 0, v_vor = 0, u_sor = 0, v_sor = 0;
+			for (size_t j = 0; j < xs.size(); j++) {
+				u_vor += strengths[j] * HBTK::PointVortex::unity_u_vel(xm[i], ym[i], xs[j], ys[j]);
+				v_vor += strengths[j] * HBTK::PointVortex::unity_v_vel(xm[i], ym[i], xs[j], ys[j]);
+				u_sor += strengths[j] * HBTK::PointSource::unity_u_vel(xm[i], ym[i], xs[j], ys[j]);
+				v_sor += strengths[j] * HBTK::PointSource::unity_v_vel(xm[i], ym[i], xs[j], ys[j]);
+			}
+			REQUIRE(vor.first[i] == Approx(u_vor));
+			REQUIRE(vor.second[i] == Approx(v_vor));
+			REQUIRE(sor.first[i] == Approx(u_sor));
+			REQUIRE(sor.second[i] == Approx(v_sor));
+		}
+	}
+
+	SECTION("2D FMM") {
+		auto vor = HBTK::PointVortex::induced_vel(xm, ym, xs, ys, strengths);
+		auto sor = HBTK::PointSource::induced_vel(xm, ym, xs, ys, strengths);
+		for (double tolerance : { 1e-4, 1e-8, 1e-12 }) {
+			auto vor_fmm = HBTK::PointVortex::induced_vel_fmm(xm, ym, xs, ys, strengths, tolerance);
+			auto sor_fmm = HBTK::PointSource::induced_vel_fmm(xm, ym, xs, ys, strengths, tolerance);
+			REQUIRE(max_error(vor_fmm, vor) < tolerance);
+			REQUIRE(max_error(sor_fmm, sor) < tolerance);
+		}
+	}
+
+	SECTION("3D treecode") {
+		HBTK::PointCloud3D points, starts, ends;
+		std::vector<double> gammas;
+		for (int i = 0; i < 2000; i++) {
+			points.push_back(HBTK::CartesianPoint3D({ 2 * sin(0.3 * i), 2 * cos(0.7 * i), 0.002 * i }));
+		}
+		for (int j = 0; j < 3000; j++) {
+			double t0 = 0.05 * j, t1 = 0.05 * (j + 1);
+			starts.push_back(HBTK::CartesianPoint3D({ cos(t0), sin(t0), 0.001 * j }));
+			ends.push_back(HBTK::CartesianPoint3D({ cos(t1), sin(t1), 0.001 * (j + 1) }));
+			gammas.push_back(1 + 0.5 * sin(0.02 * j));
+		}
+		auto direct = HBTK::BiotSavart::induced_vel(points, starts, ends, gammas, 0.01);
+		double previous_error = HUGE_VAL;
+		for (double opening_angle : { 0.7, 0.5, 0.3, 0.1 }) {
+			auto tree = HBTK::BiotSavart::induced_vel_treecode(points, starts, ends, gammas, 0.01, 1, opening_angle);
+			auto threaded = HBTK::BiotSavart::induced_vel_treecode(points, starts, ends, gammas, 0.01, 4, opening_angle);
+			REQUIRE(tree == threaded);
+			double error = 0, scale = 0;
+			for (int i = 0; i < points.size(); i++) {
+				error = std::max(error, (tree[i] - direct[i]).magnitude());
+				scale = std::max(scale, direct[i].magnitude());
+			}
+			REQUIRE(error / scale < previous_error);
+			previous_error = error / scale;
+		}
+		REQUIRE(previous_error < 1e-5);
+	}
+}
+
+TEST_CASE("Fused point singularity kernels") {
+	std::vector<double> xm, ym, xs, ys, strengths, angles;
+	for (int i = 0; i < 300; i++) {
+		xm.push_back(2 * sin(1.1 * i));
+		ym.push_back(cos(0.37 * i));
+	}
+	for (int j = 0; j < 150; j++) {
+		xs.push_back(1.5 * cos(0.9 * j));
+		ys.push_back(sin(2.3 * j) - 0.2);
+		strengths.push_back(1 + 0.5 * sin(0.1 * j));
+		angles.push_back(0.4 * j);
+	}
+	// A measurement point on a singularity gets nothing from it.
+	xm[17] = xs[5];
+	ym[17] = ys[5];
+	auto skip = [&](int i, int j) { return xm[i] == xs[j] && ym[i] == ys[j]; };
+	std::vector<double> u, v, p, u4, v4, p4;
+
+	SECTION("Source") {
+		HBTK::PointSource::induced_vel_and_pot(xm, ym, xs, ys, strengths, u, v, p);
+		HBTK::PointSource::induced_vel_and_pot(xm, ym, xs, ys, strengths, u4, v4, p4, 4);
+		for (int i = 0; i < (int)xm.size(); i++) {
+			double u_ref = 0, v_ref = 0, p_ref = 0;
+			for (int j = 0; j < (int)xs.size(); j++) {
+				if (skip(i, j)) { continue; }
+				u_ref += strengths[j] * HBTK::PointSource::unity_u_vel(xm[i], ym[i], xs[j], ys[j]);
+				v_ref += strengths[j] * HBTK::PointSource::unity_v_vel(xm[i], ym[i], xs[j], ys[j]);
+				p_ref += strengths[j] * HBTK::PointSource::unity_vel_pot(xm[i], ym[i], xs[j], ys[j]);
+			}
+			REQUIRE(u[i] == Approx(u_ref).margin(1e-10));
+			REQUIRE(v[i] == Approx(v_ref).margin(1e-10));
+			REQUIRE(p[i] == Approx(p_ref).margin(1e-10));
+			REQUIRE(u4[i] == u[i]);
+			REQUIRE(p4[i] == p[i]);
+		}
+	}
+	SECTION("Vortex") {
+		HBTK::PointVortex::induced_vel_and_pot(xm, ym, xs, ys, strengths, u, v, p);
+		HBTK::PointVortex::induced_vel_and_pot(xm, ym, xs, ys, strengths, u4, v4, p4, 4);
+		for (int i = 0; i < (int)xm.size(); i++) {
+			double u_ref = 0, v_ref = 0, p_ref = 0;
+			for (int j = 0; j < (int)xs.size(); j++) {
+				if (skip(i, j)) { continue; }
+				u_ref += strengths[j] * HBTK::PointVortex::unity_u_vel(xm[i], ym[i], xs[j], ys[j]);
+				v_ref += strengths[j] * HBTK::PointVortex::unity_v_vel(xm[i], ym[i], xs[j], ys[j]);
+				p_ref += strengths[j] * HBTK::PointVortex::unity_vel_pot(xm[i], ym[i], xs[j], ys[j]);
+			}
+			REQUIRE(u[i] == Approx(u_ref).margin(1e-10));
+			REQUIRE(v[i] == Approx(v_ref).margin(1e-10));
+			REQUIRE(p[i] == Approx(p_ref).margin(1e-10));
+			REQUIRE(v4[i] == v[i]);
+		}
+	}
+	SECTION("Doublet") {
+		HBTK::PointDoublet::induced_vel_and_pot(xm, ym, xs, ys, strengths, angles, u, v, p);
+		HBTK::PointDoublet::induced_vel_and_pot(xm, ym, xs, ys, strengths, angles, u4, v4, p4, 4);
+		for (int i = 0; i < (int)xm.size(); i++) {
+			double u_ref = 0, v_ref = 0, p_ref = 0;
+			for (int j = 0; j < (int)xs.size(); j++) {
+				if (skip(i, j)) { continue; }
+				u_ref += strengths[j] * HBTK::PointDoublet::unity_u_vel(xm[i], ym[i], xs[j], ys[j], angles[j]);
+				v_ref += strengths[j] * HBTK::PointDoublet::unity_v_vel(xm[i], ym[i], xs[j], ys[j], angles[j]);
+				p_ref += strengths[j] * HBTK::PointDoublet::unity_vel_pot(xm[i], ym[i], xs[j], ys[j], angles[j]);
+			}
+			REQUIRE(u[i] == Approx(u_ref).margin(1e-10));
+			REQUIRE(v[i] == Approx(v_ref).margin(1e-10));
+			REQUIRE(p[i] == Approx(p_ref).margin(1e-10));
+			REQUIRE(u4[i] == u[i]);
+		}
+	}
+	SECTION("Doublet velocity is the gradient of its potential") {
+		const double h = 1e-6, x = 0.3, y = -0.7, xd = 0.1, yd = 0.2;
+		for (double angle : { 0., 0.3, 2.0 }) {
+			auto pot = [&](double xp, double yp) {
+				return HBTK::PointDoublet::unity_vel_pot(xp, yp, xd, yd, angle);
+			};
+			REQUIRE(HBTK::PointDoublet::unity_u_vel(x, y, xd, yd, angle) 
+				== Approx((pot(x + h, y) - pot(x - h, y)) / (2 * h)).epsilon(1e-6));
+			REQUIRE(HBTK::PointDoublet::unity_v_vel(x, y, xd, yd, angle) 
+				== Approx((pot(x, y + h) - pot(x, y - h)) / (2 * h)).epsilon(1e-6));
+		}
+		REQUIRE(HBTK::PointDoublet::unity_u_vel(x, y, xd, yd) == Approx(HBTK::PointDoublet::unity_u_vel(x, y, xd, yd, 0.)));
+		REQUIRE(HBTK::PointDoublet::unity_v_vel(x, y, xd, yd) == Approx(HBTK::PointDoublet::unity_v_vel(x, y, xd, yd, 0.)));
+		REQUIRE(HBTK::PointDoublet::unity_vel_pot(x, y, xd, yd) == Approx(HBTK::PointDoublet::unity_vel_pot(x, y, xd, yd, 0.)));
+	}
+}
+
+TEST_CASE("Vortex panel velocity is the gradient of its potential") {
+	const double h = 1e-6;
+	// Measurement points are kept off the panels' lines, where the potential jumps.
+	const std::vector<std::vector<double>> panels = {
+		{ 0., 0., 1., 0. }, { 0.2, -0.1, -0.5, 0.6 }, { 1., 1., 0.3, -0.4 } };
+	const std::vector<double> xm = { 0.7, -1.3, 0.4, 2.1 }, ym = { 0.9, 0.2, -0.8, 1.7 };
+
+	SECTION("Constant strength") {
+		double u, v;
+		std::tie(u, v) = HBTK::ConstantVortexDistribution::unity_vel(0.7, 0.9, 0., 0., 1., 0.);
+		REQUIRE(u == Approx(0.156).margin(1e-3));
+		REQUIRE(v == Approx(-0.029).margin(1e-3));
+		for (auto & p : panels) {
+			auto pot = [&](double xp, double yp) {
+				return HBTK::ConstantVortexDistribution::unity_vel_pot(xp, yp, p[0], p[1], p[2], p[3]);
+			};
+			for (int i = 0; i < (int)xm.size(); i++) {
+				std::tie(u, v) = HBTK::ConstantVortexDistribution::unity_vel(xm[i], ym[i], p[0], p[1], p[2], p[3]);
+				REQUIRE(u == Approx((pot(xm[i] + h, ym[i]) - pot(xm[i] - h, ym[i])) / (2 * h)).epsilon(1e-6).margin(1e-8));
+				REQUIRE(v == Approx((pot(xm[i], ym[i] + h) - pot(xm[i], ym[i] - h)) / (2 * h)).epsilon(1e-6).margin(1e-8));
+			}
+		}
+	}
+
+	SECTION("Linear strength") {
+		const double gamma0 = 0.6, gamma1 = -1.3;
+		double u, v;
+		for (auto & p : panels) {
+			auto pot = [&](double xp, double yp) {
+				return HBTK::LinearVortexDistribution::vel_pot(xp, yp, p[0], p[1], p[2], p[3], gamma0, gamma1);
+			};
+			for (int i = 0; i < (int)xm.size(); i++) {
+				std::tie(u, v) = HBTK::LinearVortexDistribution::vel(xm[i], ym[i], p[0], p[1], p[2], p[3], gamma0, gamma1);
+				REQUIRE(u == Approx((pot(xm[i] + h, ym[i]) - pot(xm[i] - h, ym[i])) / (2 * h)).epsilon(1e-6).margin(1e-8));
+				REQUIRE(v == Approx((pot(xm[i], ym[i] + h) - pot(xm[i], ym[i] - h)) / (2 * h)).epsilon(1e-6).margin(1e-8));
+			}
+		}
+	}
+}
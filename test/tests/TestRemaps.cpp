@@ -1,4 +1,6 @@
 
+#include <vector>
+
 #include <catch2/catch.hpp>
 
 #include <HBTK/Remaps.h>
@@ -144,3 +146,56 @@ TEST_CASE("Integral Remaps")
 		REQUIRE(1. == Approx(wx));
 	}
 	};
+
+TEST_CASE("Batch remaps")
+{
+	const int n = 9;
+	std::vector<double> base_points(n), base_weights(n);
+	for (int i = 0; i < n; i++) {
+		base_points[i] = -0.95 + 1.9 * i / (n - 1);
+		base_weights[i] = 0.1 + 0.01 * i;
+	}
+	// Compare a batch remap to the single point remap applied at each point.
+	auto compare = [&](auto batch, auto single) {
+		std::vector<double> points = base_points, weights = base_weights;
+		batch(points.data(), weights.data(), n);
+		for (int i = 0; i < n; i++) {
+			double p = base_points[i], w = base_weights[i];
+			single(p, w);
+			REQUIRE(points[i] == Approx(p).margin(1e-14));
+			REQUIRE(weights[i] == Approx(w).margin(1e-14));
+		}
+	};
+
+	SECTION("Integer power")
+	{
+		REQUIRE(HBTK::integer_power<0>(2.5) == 1.);
+		REQUIRE(HBTK::integer_power<3>(2.5) == 2.5 * 2.5 * 2.5);
+	}
+	SECTION("Linear remap")
+	{
+		compare([](double * p, double * w, int n) { HBTK::linear_remap_batch(p, w, n, -1., 1., 2., 6.); },
+			[](double & p, double & w) { HBTK::linear_remap(p, w, -1., 1., 2., 6.); });
+	}
+	SECTION("Telles remaps")
+	{
+		compare([](double * p, double * w, int n) { HBTK::telles_quadratic_remap_batch(p, w, n, -1.); },
+			[](double & p, double & w) { HBTK::telles_quadratic_remap(p, w, -1.); });
+		compare([](double * p, double * w, int n) { HBTK::telles_cubic_remap_batch(p, w, n, 0.3); },
+			[](double & p, double & w) { HBTK::telles_cubic_remap(p, w, 0.3); });
+		compare([](double * p, double * w, int n) { HBTK::telles_cubic_remap_batch(p, w, n, 1.); },
+			[](double & p, double & w) { HBTK::telles_cubic_remap(p, w, 1.); });
+	}
+	SECTION("Sato remaps")
+	{
+		compare([](double * p, double * w, int n) { HBTK::sato_remap_batch<3>(p, w, n, 1.); },
+			[](double & p, double & w) { HBTK::sato_remap<3>(p, w, 1.); });
+		compare([](double * p, double * w, int n) { HBTK::sato_remap_batch<5>(p, w, n, -1.); },
+			[](double & p, double & w) { HBTK::sato_remap<5>(p, w, -1.); });
+	}
+	SECTION("Doblare remap")
+	{
+		compare([](double * p, double * w, int n) { HBTK::doblare_remap_batch(p, w, n, 0.5); },
+			[](double & p, double & w) { HBTK::doblare_remap(p, w, 0.5); });
+	}
+}
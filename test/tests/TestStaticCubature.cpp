@@ -0,0 +1,112 @@
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <HBTK/GaussLegendre.h>
+#include <HBTK/StaticCubature.h>
+
+
+namespace {
+	double factorial(int n) { return n <= 1 ? 1 : n * factorial(n - 1); }
+	// Integral of x^a over [-1, 1]
+	double interval_monomial(int a) { return a % 2 ? 0 : 2. / (a + 1); }
+}
+
+TEST_CASE("Tensor product cubature")
+{
+	SECTION("Quadrangle")
+	{
+		auto quad = HBTK::gauss_legendre_cubature(HBTK::StaticCubature::quadrangle, 3);
+		REQUIRE(quad.dimensions() == 2);
+		REQUIRE(quad.num_points() == 9);
+		for (int a = 0; a <= 5; a++) {
+			for (int b = 0; b <= 5; b++) {
+				auto f = [&](const double * x) { return pow(x[0], a) * pow(x[1], b); };
+				REQUIRE(quad.integrate(f) == Approx(interval_monomial(a) 
+					* interval_monomial(b)).margin(1e-14));
+			}
+		}
+	}
+	SECTION("Hexahedron")
+	{
+		auto hex = HBTK::gauss_legendre_cubature(HBTK::StaticCubature::hexahedron, 4);
+		REQUIRE(hex.num_points() == 64);
+		auto f = [](const double * x) { return x[0] * x[0] * pow(x[1], 4) * pow(x[2], 6); };
+		REQUIRE(hex.integrate(f) == Approx(2. / 3 * 2. / 5 * 2. / 7));
+	}
+}
+
+TEST_CASE("Collapsed coordinate simplex cubature")
+{
+	SECTION("Triangle")
+	{
+		auto tri = HBTK::gauss_legendre_cubature(HBTK::StaticCubature::triangle, 4);
+		for (int i = 0; i < tri.num_points(); i++) {
+			double x = tri.points()[2 * i], y = tri.points()[2 * i + 1];
+			REQUIRE(x >= 0);
+			REQUIRE(y >= 0);
+			REQUIRE(x + y <= 1);
+		}
+		for (int a = 0; a <= 7; a++) {
+			for (int b = 0; a + b <= 7; b++) {
+				auto f = [&](const double * x) { return pow(x[0], a) * pow(x[1], b); };
+				REQUIRE(tri.integrate(f) == Approx(factorial(a) * factorial(b) 
+					/ factorial(a + b + 2)));
+			}
+		}
+	}
+	SECTION("Tetrahedron")
+	{
+		auto tet = HBTK::gauss_legendre_cubature(HBTK::StaticCubature::tetrahedron, 3);
+		for (int a = 0; a <= 5; a++) {
+			for (int b = 0; a + b <= 5; b++) {
+				for (int c = 0; a + b + c <= 5; c++) {
+					auto f = [&](const double * x) { 
+						return pow(x[0], a) * pow(x[1], b) * pow(x[2], c); };
+					REQUIRE(tet.integrate(f) == Approx(factorial(a) * factorial(b)
+						* factorial(c) / factorial(a + b + c + 3)));
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("Smolyak sparse grid")
+{
+	const int level = 3;
+	auto sparse = HBTK::smolyak_cubature(3, level);
+	auto full = HBTK::gauss_legendre_cubature(HBTK::StaticCubature::hexahedron, 2 * level + 1);
+	REQUIRE(sparse.num_points() < full.num_points());
+	for (int a = 0; a <= 2 * level + 1; a++) {
+		for (int b = 0; a + b <= 2 * level + 1; b++) {
+			for (int c = 0; a + b + c <= 2 * level + 1; c++) {
+				auto f = [&](const double * x) {
+					return pow(x[0], a) * pow(x[1], b) * pow(x[2], c); };
+				REQUIRE(sparse.integrate(f) == Approx(interval_monomial(a) 
+					* interval_monomial(b) * interval_monomial(c)).margin(1e-13));
+			}
+		}
+	}
+	auto smooth = [](const double * x) { return exp(x[0] + x[1] + x[2]); };
+	double exact = pow(exp(1.) - exp(-1.), 3);
+	REQUIRE(HBTK::smolyak_cubature(3, 8).integrate(smooth) == Approx(exact).epsilon(1e-10));
+}
+
+TEST_CASE("Batch cubature")
+{
+	auto tri = HBTK::gauss_legendre_cubature(HBTK::StaticCubature::triangle, 3);
+	int calls = 0;
+	auto powers = [&](const std::vector<double> & points, std::vector<double> & values) {
+		calls++;
+		int n = (int)points.size() / 2;
+		for (int j = 0; j < 3; j++) {
+			for (int i = 0; i < n; i++) { values[j * n + i] = pow(points[2 * i], j); }
+		}
+	};
+	std::vector<double> results = tri.integrate_batch(powers, 3);
+	REQUIRE(calls == 1);
+	REQUIRE(results[0] == Approx(0.5));
+	REQUIRE(results[1] == Approx(1. / 6));
+	REQUIRE(results[2] == Approx(1. / 12));
+}